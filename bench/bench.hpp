@@ -0,0 +1,292 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_bench_INCL_
+#define Rigibra_bench_INCL_
+
+/*! \file
+\brief Timing and JSON reporting utilities shared by benchmark programs.
+*/
+
+
+#include "Rigibra.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace bench
+{
+	//! Sink for values computed in timing loops (prevents elimination)
+	inline
+	double volatile &
+	sink
+		()
+	{
+		static double volatile value{ 0. };
+		return value;
+	}
+
+	//! Consume a value so that compiler must compute it
+	inline
+	void
+	keep
+		( double const & value
+		)
+	{
+		sink() = sink() + value;
+	}
+
+	//! Consume first component of a vector-like value
+	template <typename Type>
+	inline
+	void
+	keep
+		( Type const & item
+		)
+	{
+		keep(item[0]);
+	}
+
+	//! JSON number for value ("null" if not finite - e.g. NaN or inf)
+	inline
+	std::string
+	jsonNumber
+		( double const & value
+		)
+	{
+		std::string text("null");
+		if (std::isfinite(value))
+		{
+			std::ostringstream oss;
+			oss << std::setprecision(6) << value;
+			text = oss.str();
+		}
+		return text;
+	}
+
+	//! Timing statistics for one benchmark case
+	struct Stats
+	{
+		std::string theName{};
+		std::size_t theDataSize{ 0u }; //!< e.g. number of points in batch
+		std::size_t theOpsPerRep{ 0u }; //!< operations per timed repetition
+		std::size_t theNumReps{ 0u };
+		double theMeanNsPerOp{ 0. };
+		double theStdDevNsPerOp{ 0. };
+		double theMinNsPerOp{ 0. };
+
+		//! Operations per second (based on mean time)
+		inline
+		double
+		opsPerSec
+			() const
+		{
+			double ops{ 0. };
+			if (0. < theMeanNsPerOp)
+			{
+				ops = 1.e9 / theMeanNsPerOp;
+			}
+			return ops;
+		}
+
+		//! JSON object description
+		inline
+		std::string
+		json
+			() const
+		{
+			double const var{ theStdDevNsPerOp * theStdDevNsPerOp };
+			std::ostringstream oss;
+			oss << "{ \"name\": \"" << theName << "\""
+				<< ", \"dataSize\": " << theDataSize
+				<< ", \"opsPerRep\": " << theOpsPerRep
+				<< ", \"numReps\": " << theNumReps
+				<< ", \"nsPerOp\": " << jsonNumber(theMeanNsPerOp)
+				<< ", \"nsPerOpMin\": " << jsonNumber(theMinNsPerOp)
+				<< ", \"nsPerOpStdDev\": " << jsonNumber(theStdDevNsPerOp)
+				<< ", \"nsPerOpVariance\": " << jsonNumber(var)
+				<< ", \"opsPerSec\": " << jsonNumber(opsPerSec())
+				<< " }";
+			return oss.str();
+		}
+	};
+
+	/*! Time func() which performs opsPerRep operations per call.
+	 *
+	 * The function is run once to warm up caches, then the number
+	 * of repetitions is chosen such that total time is approximately
+	 * minSeconds (but at least minReps repetitions).
+	 */
+	template <typename Func>
+	inline
+	Stats
+	measure
+		( std::string const & name
+		, std::size_t const & dataSize
+		, std::size_t const & opsPerRep
+		, Func const & func
+		, double const & minSeconds = .25
+		, std::size_t const & minReps = 5u
+		)
+	{
+		using Clock = std::chrono::steady_clock;
+		using Nanos = std::chrono::duration<double, std::nano>;
+
+		// warm up and estimate time per repetition
+		Clock::time_point const t0{ Clock::now() };
+		func();
+		double const estNs
+			{ std::max(1., Nanos(Clock::now() - t0).count()) };
+		std::size_t const numReps
+			{ std::max
+				( minReps
+				, static_cast<std::size_t>((minSeconds * 1.e9) / estNs)
+				)
+			};
+
+		std::vector<double> nsPerOps;
+		nsPerOps.reserve(numReps);
+		double const opsDiv{ static_cast<double>(std::max(opsPerRep, std::size_t{ 1u })) };
+		for (std::size_t nn{0u} ; nn < numReps ; ++nn)
+		{
+			Clock::time_point const tBeg{ Clock::now() };
+			func();
+			Clock::time_point const tEnd{ Clock::now() };
+			nsPerOps.emplace_back(Nanos(tEnd - tBeg).count() / opsDiv);
+		}
+
+		double sum{ 0. };
+		for (double const & val : nsPerOps)
+		{
+			sum += val;
+		}
+		double const mean{ sum / static_cast<double>(numReps) };
+		double sumSq{ 0. };
+		for (double const & val : nsPerOps)
+		{
+			sumSq += (val - mean) * (val - mean);
+		}
+		double stdDev{ 0. };
+		if (1u < numReps)
+		{
+			stdDev = std::sqrt(sumSq / static_cast<double>(numReps - 1u));
+		}
+
+		Stats stats;
+		stats.theName = name;
+		stats.theDataSize = dataSize;
+		stats.theOpsPerRep = opsPerRep;
+		stats.theNumReps = numReps;
+		stats.theMeanNsPerOp = mean;
+		stats.theStdDevNsPerOp = stdDev;
+		stats.theMinNsPerOp = *std::min_element(nsPerOps.cbegin(), nsPerOps.cend());
+		return stats;
+	}
+
+	/*! Data sizes (e.g. point counts) from L1 cache to DRAM resident.
+	 *
+	 * Sizes assume 48 bytes per point (SoA input and output).
+	 */
+	inline
+	std::vector<std::size_t>
+	dataSizes
+		()
+	{
+		return std::vector<std::size_t>
+			{ 512u // ~24kB: L1 resident
+			, 8u * 1024u // ~400kB: L2 resident
+			, 128u * 1024u // ~6MB: L3 resident
+			, 4u * 1024u * 1024u // ~200MB: DRAM resident
+			};
+	}
+
+	/*! Write JSON report to file argv[1] (if provided) else std::cout
+	 *
+	 * Returns process exit status.
+	 */
+	inline
+	int
+	report
+		( std::string const & benchName
+		, std::vector<Stats> const & allStats
+		, int const & argc
+		, char const * const * const & argv
+		)
+	{
+		std::ostringstream oss;
+		oss << "{\n";
+		oss << "  \"benchmark\": \"" << benchName << "\",\n";
+		oss << "  \"projectVersion\": \"" << rigibra::projectVersion()
+			<< "\",\n";
+		oss << "  \"sourceIdentity\": \"" << rigibra::sourceIdentity()
+			<< "\",\n";
+		oss << "  \"simdIsa\": \""
+			<< rigibra::simd::nameFor(rigibra::simd::bestIsa()) << "\",\n";
+		oss << "  \"results\":\n";
+		oss << "  [\n";
+		for (std::size_t nn{0u} ; nn < allStats.size() ; ++nn)
+		{
+			oss << "    " << allStats[nn].json();
+			if (nn + 1u < allStats.size())
+			{
+				oss << ',';
+			}
+			oss << '\n';
+		}
+		oss << "  ]\n";
+		oss << "}\n";
+
+		int status{ 0 };
+		if (1 < argc)
+		{
+			std::ofstream ofs(argv[1]);
+			ofs << oss.str();
+			if (! ofs.good())
+			{
+				std::cerr << "Unable to write file: " << argv[1] << '\n';
+				status = 1;
+			}
+		}
+		else
+		{
+			std::cout << oss.str();
+		}
+		return status;
+	}
+
+} // [bench]
+
+
+#endif // Rigibra_bench_INCL_
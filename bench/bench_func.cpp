@@ -0,0 +1,1010 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Benchmarks for composition, inversion and batch operations
+*/
+
+
+#include "bench.hpp"
+
+#include "Rigibra.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	//! Transforms with a variety of (non-trivial) parameters
+	inline
+	std::vector<rigibra::Transform>
+	sampleTransforms
+		( std::size_t const & numXfms
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		std::vector<Transform> xfms;
+		xfms.reserve(numXfms);
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			Location const loc{ .1*dn, 3. - .2*dn, std::cos(dn) };
+			BiVector const biv
+				{ std::sin(.7*dn), std::cos(1.3*dn), std::sin(2.9*dn + .2) };
+			xfms.emplace_back(Transform{ loc, Attitude(PhysAngle{ biv }) });
+		}
+		return xfms;
+	}
+
+	//! Single-item operations in func.hpp
+	inline
+	void
+	benchSingle
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		constexpr std::size_t numItems{ 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numItems + 1u) };
+
+		ptStats->emplace_back
+			( bench::measure
+				( "inverse(Attitude)", numItems, numItems
+				, [&xfms] ()
+					{
+						for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+						{
+							bench::keep
+								(inverse(xfms[nn].theAtt).spinAngle().theBiv);
+						}
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "inverse(Transform)", numItems, numItems
+				, [&xfms] ()
+					{
+						for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+						{
+							bench::keep(inverse(xfms[nn]).theLoc);
+						}
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(Attitude,Attitude)", numItems, numItems
+				, [&xfms] ()
+					{
+						for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+						{
+							Attitude const att
+								{ xfms[nn+1u].theAtt * xfms[nn].theAtt };
+							bench::keep(att.spinAngle().theBiv);
+						}
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(Transform,Transform)", numItems, numItems
+				, [&xfms] ()
+					{
+						for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+						{
+							bench::keep((xfms[nn+1u] * xfms[nn]).theLoc);
+						}
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "composeUnchecked(Transform,Transform)", numItems, numItems
+				, [&xfms] ()
+					{
+						for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+						{
+							bench::keep
+								(composeUnchecked(xfms[nn+1u], xfms[nn]).theLoc);
+						}
+					}
+				)
+			);
+
+		std::vector<SpinorTransform> spinXfms;
+		spinXfms.reserve(xfms.size());
+		for (Transform const & xfm : xfms)
+		{
+			spinXfms.emplace_back(SpinorTransform::from(xfm));
+		}
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(SpinorTransform,SpinorTransform)"
+				, numItems, numItems
+				, [&spinXfms] ()
+					{
+						for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+						{
+							bench::keep((spinXfms[nn+1u] * spinXfms[nn]).theLoc);
+						}
+					}
+				)
+			);
+
+		std::vector<SpinorTransform> spinXfmsOut(numItems);
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(SpinorTransform,SpinorTransform)[loop]"
+				, numItems, numItems
+				, [&] ()
+					{
+						for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+						{
+							spinXfmsOut[nn] = spinXfms[nn+1u] * spinXfms[nn];
+						}
+						bench::keep(spinXfmsOut.back().theLoc);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "composeUnchecked(SpinorTransform*,SpinorTransform*)"
+				, numItems, numItems
+				, [&] ()
+					{
+						composeUnchecked
+							( spinXfms.data() + 1u, spinXfms.data(), numItems
+							, spinXfmsOut.data()
+							);
+						bench::keep(spinXfmsOut.back().theLoc);
+					}
+				)
+			);
+	}
+
+	//! Batch point transformations for various data sizes
+	inline
+	void
+	benchBatch
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		Transform const xfm{ sampleTransforms(2u).back() };
+
+		for (std::size_t const & numPnts : bench::dataSizes())
+		{
+			std::vector<Vector> pnts(numPnts);
+			std::vector<double> xs(numPnts), ys(numPnts), zs(numPnts);
+			for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+			{
+				double const dn{ static_cast<double>(nn) };
+				pnts[nn] = Vector{ dn, .5*dn, -.25*dn };
+				xs[nn] = pnts[nn][0];
+				ys[nn] = pnts[nn][1];
+				zs[nn] = pnts[nn][2];
+			}
+			std::vector<Vector> pntsOut(numPnts);
+			std::vector<double> xOut(numPnts), yOut(numPnts), zOut(numPnts);
+
+			// single point path (for reference - omit slow DRAM case)
+			if (numPnts <= (128u * 1024u))
+			{
+				ptStats->emplace_back
+					( bench::measure
+						( "Transform::operator()[loop]", numPnts, numPnts
+						, [&] ()
+							{
+								for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+								{
+									pntsOut[nn] = xfm(pnts[nn]);
+								}
+								bench::keep(pntsOut.back());
+							}
+						)
+					);
+			}
+
+			ptStats->emplace_back
+				( bench::measure
+					( "apply[AoS]", numPnts, numPnts
+					, [&] ()
+						{
+							apply(xfm, pnts.data(), numPnts, pntsOut.data());
+							bench::keep(pntsOut.back());
+						}
+					)
+				);
+
+			ptStats->emplace_back
+				( bench::measure
+					( "apply[SoA]", numPnts, numPnts
+					, [&] ()
+						{
+							apply
+								( xfm
+								, xs.data(), ys.data(), zs.data(), numPnts
+								, xOut.data(), yOut.data(), zOut.data()
+								);
+							bench::keep(xOut.back());
+						}
+					)
+				);
+
+			// rotation only (e.g. normals and directions)
+			ptStats->emplace_back
+				( bench::measure
+					( "rotate[AoS]", numPnts, numPnts
+					, [&] ()
+						{
+							rotate
+								(xfm.theAtt, pnts.data(), numPnts, pntsOut.data());
+							bench::keep(pntsOut.back());
+						}
+					)
+				);
+
+			// spinor sandwich vs rotation matrix (ref matrix.hpp)
+			if (numPnts <= (128u * 1024u))
+			{
+				Attitude const & att = xfm.theAtt;
+				ptStats->emplace_back
+					( bench::measure
+						( "Attitude::operator()[loop]", numPnts, numPnts
+						, [&] ()
+							{
+								for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+								{
+									pntsOut[nn] = att(pnts[nn]);
+								}
+								bench::keep(pntsOut.back());
+							}
+						)
+					);
+			}
+
+			Matrix3x4 const mat{ affineMatrix(xfm) };
+			ptStats->emplace_back
+				( bench::measure
+					( "apply[matrix,AoS]", numPnts, numPnts
+					, [&] ()
+						{
+							apply(mat, pnts.data(), numPnts, pntsOut.data());
+							bench::keep(pntsOut.back());
+						}
+					)
+				);
+
+			ptStats->emplace_back
+				( bench::measure
+					( "apply[matrix,SoA]", numPnts, numPnts
+					, [&] ()
+						{
+							apply
+								( mat
+								, xs.data(), ys.data(), zs.data(), numPnts
+								, xOut.data(), yOut.data(), zOut.data()
+								);
+							bench::keep(xOut.back());
+						}
+					)
+				);
+
+			std::vector<float> xsF(xs.cbegin(), xs.cend());
+			std::vector<float> ysF(ys.cbegin(), ys.cend());
+			std::vector<float> zsF(zs.cbegin(), zs.cend());
+			std::vector<float> xOutF(numPnts), yOutF(numPnts), zOutF(numPnts);
+			ptStats->emplace_back
+				( bench::measure
+					( "apply[SoA,float]", numPnts, numPnts
+					, [&] ()
+						{
+							apply
+								( xfm
+								, xsF.data(), ysF.data(), zsF.data(), numPnts
+								, xOutF.data(), yOutF.data(), zOutF.data()
+								);
+							bench::keep(static_cast<double>(xOutF.back()));
+						}
+					)
+				);
+
+			using simd::Isa;
+			for (Isa const & isa
+				: { Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512 })
+			{
+				if (! simd::isSupported(isa))
+				{
+					continue;
+				}
+				std::string const name
+					{ "simd::apply[" + simd::nameFor(isa) + "]" };
+				ptStats->emplace_back
+					( bench::measure
+						( name, numPnts, numPnts
+						, [&] ()
+							{
+								simd::apply
+									( isa, xfm
+									, xs.data(), ys.data(), zs.data(), numPnts
+									, xOut.data(), yOut.data(), zOut.data()
+									);
+								bench::keep(xOut.back());
+							}
+						)
+					);
+			}
+
+			ptStats->emplace_back
+				( bench::measure
+					( "apply[SoA,defaultPool]", numPnts, numPnts
+					, [&] ()
+						{
+							apply
+								( defaultPool(), xfm
+								, xs.data(), ys.data(), zs.data(), numPnts
+								, xOut.data(), yOut.data(), zOut.data()
+								);
+							bench::keep(xOut.back());
+						}
+					)
+				);
+		}
+	}
+
+	//! Cumulative composition of transform sequences
+	inline
+	void
+	benchScan
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		constexpr std::size_t numXfms{ 256u * 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numXfms) };
+		std::vector<Transform> xfmsOut(numXfms);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(Transform,Transform)[scan]", numXfms, numXfms
+				, [&] ()
+					{
+						Transform xAccum{ identity<Transform>() };
+						for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+						{
+							xAccum = xfms[nn] * xAccum;
+							xfmsOut[nn] = xAccum;
+						}
+						bench::keep(xfmsOut.back().theLoc);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "inclusiveScan", numXfms, numXfms
+				, [&] ()
+					{
+						inclusiveScan(xfms.data(), numXfms, xfmsOut.data());
+						bench::keep(xfmsOut.back().theLoc);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "inclusiveScan[defaultPool]", numXfms, numXfms
+				, [&] ()
+					{
+						inclusiveScan
+							(defaultPool(), xfms.data(), numXfms, xfmsOut.data());
+						bench::keep(xfmsOut.back().theLoc);
+					}
+				)
+			);
+	}
+
+	//! Interpolated lookup in Trajectory
+	inline
+	void
+	benchTrajectory
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		constexpr std::size_t numSamps{ 16u * 1024u };
+		constexpr std::size_t numTimes{ 128u * 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numSamps) };
+		Trajectory traj;
+		for (std::size_t nn{0u} ; nn < numSamps ; ++nn)
+		{
+			traj.insert(static_cast<double>(nn), xfms[nn]);
+		}
+		std::vector<double> times(numTimes);
+		double const dt{ traj.timeEnd() / static_cast<double>(numTimes) };
+		for (std::size_t nn{0u} ; nn < numTimes ; ++nn)
+		{
+			times[nn] = dt * static_cast<double>(nn);
+		}
+		std::vector<Transform> xfmsOut(numTimes);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "Trajectory::at[search]", numTimes, numTimes
+				, [&] ()
+					{
+						for (std::size_t nn{0u} ; nn < numTimes ; ++nn)
+						{
+							xfmsOut[nn] = traj.at(times[nn]);
+						}
+						bench::keep(xfmsOut.back().theLoc);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "Trajectory::at[batch]", numTimes, numTimes
+				, [&] ()
+					{
+						traj.at(times.data(), numTimes, xfmsOut.data());
+						bench::keep(xfmsOut.back().theLoc);
+					}
+				)
+			);
+	}
+
+	//! Element-wise operations on many transforms (AoS vs SoA)
+	inline
+	void
+	benchBlock
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		constexpr std::size_t numXfms{ 16u * 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numXfms + 1u) };
+		std::vector<SpinorTransform> spinXfms;
+		spinXfms.reserve(xfms.size());
+		for (Transform const & xfm : xfms)
+		{
+			spinXfms.emplace_back(SpinorTransform::from(xfm));
+		}
+		std::vector<SpinorTransform> spinOut(numXfms);
+		TransformBlock const blockA(xfms.data(), numXfms);
+		TransformBlock const blockB(xfms.data() + 1u, numXfms);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(SpinorTransform)[AoS]", numXfms, numXfms
+				, [&] ()
+					{
+						for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+						{
+							spinOut[nn] = spinXfms[nn+1u] * spinXfms[nn];
+						}
+						bench::keep(spinOut.back().theLoc);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(TransformBlock)", numXfms, numXfms
+				, [&] ()
+					{
+						TransformBlock const result{ blockB * blockA };
+						bench::keep(result.locX()[numXfms - 1u]);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "inverse(TransformBlock)", numXfms, numXfms
+				, [&] ()
+					{
+						TransformBlock const result{ inverse(blockA) };
+						bench::keep(result.locX()[numXfms - 1u]);
+					}
+				)
+			);
+	}
+
+	//! All-pairs relative poses (composition loop vs blocked kernels)
+	inline
+	void
+	benchPairs
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		constexpr std::size_t numPoses{ 2u * 1024u };
+		constexpr std::size_t numPairs{ numPoses * numPoses };
+		std::vector<Transform> const xfms{ sampleTransforms(numPoses) };
+		TransformBlock const block(xfms);
+
+		// reference: func.hpp operations (for subset of rows)
+		constexpr std::size_t numRefRows{ 16u };
+		ptStats->emplace_back
+			( bench::measure
+				( "operator*(Transform,inverse(Transform))[pairs]"
+				, numPoses, numRefRows * numPoses
+				, [&] ()
+					{
+						for (std::size_t nA{0u} ; nA < numRefRows ; ++nA)
+						{
+							Transform const invA{ inverse(xfms[nA]) };
+							for (std::size_t nB{0u} ; nB < numPoses ; ++nB)
+							{
+								bench::keep((xfms[nB] * invA).theLoc);
+							}
+						}
+					}
+				)
+			);
+
+		std::vector<double> dists(numPairs);
+		std::vector<double> angles(numPairs);
+		ptStats->emplace_back
+			( bench::measure
+				( "relativeMagnitudes[defaultPool]", numPoses, numPairs
+				, [&] ()
+					{
+						relativeMagnitudes
+							( defaultPool(), block, block
+							, dists.data(), angles.data()
+							);
+						bench::keep(angles.back());
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "pairsWithin[defaultPool]", numPoses, numPairs / 2u
+				, [&] ()
+					{
+						std::vector<PosePair> const pairs
+							{ pairsWithin(defaultPool(), block, 1., .5) };
+						bench::keep(static_cast<double>(pairs.size()));
+					}
+				)
+			);
+	}
+
+	//! Pose index queries (vs linear scan over poses)
+	inline
+	void
+	benchPoseIndex
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		constexpr std::size_t numPoses{ 64u * 1024u };
+		constexpr std::size_t numQueries{ 256u };
+		std::vector<Transform> const xfms{ sampleTransforms(numPoses) };
+		std::vector<Transform> const queries
+			{ sampleTransforms(numQueries) };
+		double const maxDist{ .25 };
+		double const maxAngle{ .25 };
+
+		ptStats->emplace_back
+			( bench::measure
+				( "PoseIndex(pool,...)[defaultPool]", numPoses, numPoses
+				, [&] ()
+					{
+						PoseIndex const index
+							(defaultPool(), xfms.data(), numPoses);
+						bench::keep(static_cast<double>(index.size()));
+					}
+				)
+			);
+
+		// reference: scan all poses for each query
+		ptStats->emplace_back
+			( bench::measure
+				( "within[linear]", numPoses, numQueries
+				, [&] ()
+					{
+						std::size_t count{ 0u };
+						for (Transform const & query : queries)
+						{
+							Transform const invQ{ inverse(query) };
+							for (Transform const & xfm : xfms)
+							{
+								Transform const rel{ xfm * invQ };
+								if ( (magnitude(rel.theLoc) <= maxDist)
+								  && ((2. * magnitude(rel.theAtt.spinAngle().theBiv))
+									<= maxAngle)
+								   )
+								{
+									++count;
+								}
+							}
+						}
+						bench::keep(static_cast<double>(count));
+					}
+				)
+			);
+
+		PoseIndex const index(defaultPool(), xfms.data(), numPoses);
+		ptStats->emplace_back
+			( bench::measure
+				( "PoseIndex::within", numPoses, numQueries
+				, [&] ()
+					{
+						std::size_t count{ 0u };
+						for (Transform const & query : queries)
+						{
+							count += index.within(query, maxDist, maxAngle).size();
+						}
+						bench::keep(static_cast<double>(count));
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "PoseIndex::nearest[k=8]", numPoses, numQueries
+				, [&] ()
+					{
+						double sum{ 0. };
+						for (Transform const & query : queries)
+						{
+							sum += index.nearest(query, 8u).back().theDistance;
+						}
+						bench::keep(sum);
+					}
+				)
+			);
+	}
+
+	//! Closed-form Transform fitting (streaming and multi-threaded)
+	inline
+	void
+	benchFit
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		constexpr std::size_t numPairs{ 256u * 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numPairs) };
+		Transform const & xfm = xfms[7u];
+		std::vector<Vector> froms;
+		std::vector<Vector> intos;
+		froms.reserve(numPairs);
+		intos.reserve(numPairs);
+		for (Transform const & sample : xfms)
+		{
+			froms.emplace_back(sample.theLoc);
+			intos.emplace_back(xfm(sample.theLoc));
+		}
+
+		ptStats->emplace_back
+			( bench::measure
+				( "FitAccumulator::add(Vector,Vector)", numPairs, numPairs
+				, [&] ()
+					{
+						FitAccumulator accum;
+						for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+						{
+							accum.add(froms[nn], intos[nn]);
+						}
+						bench::keep(accum.spinorTransform().theLoc);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "fitAccumulatorFor", numPairs, numPairs
+				, [&] ()
+					{
+						FitAccumulator const accum
+							{ fitAccumulatorFor
+								(froms.data(), intos.data(), numPairs)
+							};
+						bench::keep(accum.spinorTransform().theLoc);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "fitAccumulatorFor[defaultPool]", numPairs, numPairs
+				, [&] ()
+					{
+						FitAccumulator const accum
+							{ fitAccumulatorFor
+								(defaultPool(), froms.data(), intos.data(), numPairs)
+							};
+						bench::keep(accum.spinorTransform().theLoc);
+					}
+				)
+			);
+
+		FitAccumulator const accum
+			{ fitAccumulatorFor(froms.data(), intos.data(), numPairs) };
+		ptStats->emplace_back
+			( bench::measure
+				( "FitAccumulator::spinorTransform", numPairs, 1u
+				, [&] ()
+					{
+						bench::keep(accum.spinorTransform().theLoc);
+					}
+				)
+			);
+	}
+
+	//! Robust estimation (hypothesis scoring and full RANSAC)
+	inline
+	void
+	benchRansac
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		constexpr std::size_t numPairs{ 16u * 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numPairs) };
+		Transform const & xfm = xfms[7u];
+		std::vector<Vector> froms;
+		std::vector<Vector> intos;
+		froms.reserve(numPairs);
+		intos.reserve(numPairs);
+		for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+		{
+			Vector const & from = xfms[nn].theLoc;
+			froms.emplace_back(from);
+			// 75% outliers
+			if (0u == (nn % 4u))
+			{
+				intos.emplace_back(xfm(from));
+			}
+			else
+			{
+				intos.emplace_back(xfms[numPairs - 1u - nn].theLoc);
+			}
+		}
+		double const maxDist{ .01 };
+
+		// reference: per point Transform::operator()
+		ptStats->emplace_back
+			( bench::measure
+				( "Transform::operator()[score]", numPairs, numPairs
+				, [&] ()
+					{
+						std::size_t count{ 0u };
+						for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+						{
+							if (magnitude(intos[nn] - xfm(froms[nn])) <= maxDist)
+							{
+								++count;
+							}
+						}
+						bench::keep(static_cast<double>(count));
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "countInliers", numPairs, numPairs
+				, [&] ()
+					{
+						std::size_t const count
+							{ countInliers
+								( FastTransform(xfm), froms.data(), intos.data()
+								, numPairs, maxDist
+								)
+							};
+						bench::keep(static_cast<double>(count));
+					}
+				)
+			);
+
+		RansacOptions options;
+		options.theInlierDistance = maxDist;
+		ptStats->emplace_back
+			( bench::measure
+				( "ransacTransform[defaultPool]", numPairs, numPairs
+				, [&] ()
+					{
+						RansacResult const result
+							{ ransacTransform
+								( defaultPool(), froms.data(), intos.data()
+								, numPairs, options
+								)
+							};
+						bench::keep(result.theXfm.theLoc);
+					}
+				)
+			);
+	}
+
+	//! Point Jacobians: analytic (batch) vs forward differences
+	inline
+	void
+	benchJacobian
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		constexpr std::size_t numPnts{ 4u * 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numPnts) };
+		Transform const & xfm = xfms[7u];
+		std::vector<Vector> pnts;
+		pnts.reserve(numPnts);
+		for (Transform const & sample : xfms)
+		{
+			pnts.emplace_back(sample.theLoc);
+		}
+		std::vector<double> jacs(18u * numPnts);
+
+		// reference: 7 evaluations of Transform::operator() per point
+		ptStats->emplace_back
+			( bench::measure
+				( "Transform::operator()[forward differences]"
+				, numPnts, numPnts
+				, [&] ()
+					{
+						constexpr double step{ 1.e-7 };
+						for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+						{
+							Vector const y0{ xfm(pnts[nn]) };
+							for (std::size_t col{0u} ; col < 6u ; ++col)
+							{
+								Transform pert{ xfm };
+								if (col < 3u)
+								{
+									pert.theLoc[col] += step;
+								}
+								else
+								{
+									BiVector biv{ xfm.theAtt.spinAngle().theBiv };
+									biv[col - 3u] += step;
+									pert.theAtt = Attitude(SpinAngle{ biv });
+								}
+								Vector const y1{ pert(pnts[nn]) };
+								for (std::size_t row{0u} ; row < 3u ; ++row)
+								{
+									jacs[18u*nn + 6u*row + col]
+										= (y1[row] - y0[row]) / step;
+								}
+							}
+						}
+						bench::keep(jacs.back());
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "jacobianApply[batch]", numPnts, numPnts
+				, [&] ()
+					{
+						jacobianApply(xfm, pnts.data(), numPnts, jacs.data());
+						bench::keep(jacs.back());
+					}
+				)
+			);
+	}
+
+	//! Attitude averaging (streaming chordal and iterative Karcher)
+	inline
+	void
+	benchMean
+		( std::vector<bench::Stats> * const & ptStats
+		)
+	{
+		using namespace rigibra;
+		constexpr std::size_t numXfms{ 64u * 1024u };
+		std::vector<Transform> const xfms{ sampleTransforms(numXfms) };
+		std::vector<Attitude> atts;
+		atts.reserve(numXfms);
+		for (Transform const & xfm : xfms)
+		{
+			atts.emplace_back(xfm.theAtt);
+		}
+
+		ptStats->emplace_back
+			( bench::measure
+				( "chordalMean(Attitude)", numXfms, numXfms
+				, [&] ()
+					{
+						Attitude const att{ chordalMean(atts.data(), numXfms) };
+						bench::keep(att.spinAngle().theBiv);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "chordalMean(Attitude)[defaultPool]", numXfms, numXfms
+				, [&] ()
+					{
+						Attitude const att
+							{ chordalMean(defaultPool(), atts.data(), numXfms) };
+						bench::keep(att.spinAngle().theBiv);
+					}
+				)
+			);
+
+		ptStats->emplace_back
+			( bench::measure
+				( "karcherMean(Attitude)[defaultPool]", numXfms, numXfms
+				, [&] ()
+					{
+						Attitude const att
+							{ karcherMean
+								(atts.data(), numXfms, nullptr, &defaultPool())
+							};
+						bench::keep(att.spinAngle().theBiv);
+					}
+				)
+			);
+	}
+
+} // [anon]
+
+
+//! Benchmark operations in func.hpp (and batch variants)
+int
+main
+	( int argc
+	, char * argv[]
+	)
+{
+	std::vector<bench::Stats> allStats;
+
+	benchSingle(&allStats);
+	benchBatch(&allStats);
+	benchScan(&allStats);
+	benchTrajectory(&allStats);
+	benchBlock(&allStats);
+	benchPairs(&allStats);
+	benchPoseIndex(&allStats);
+	benchMean(&allStats);
+	benchFit(&allStats);
+	benchRansac(&allStats);
+	benchJacobian(&allStats);
+
+	return bench::report("bench_func", allStats, argc, argv);
+}
+
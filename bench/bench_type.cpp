@@ -0,0 +1,215 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Benchmarks for operations on fundamental types (type.hpp)
+*/
+
+
+#include "bench.hpp"
+
+#include "Rigibra.hpp"
+
+#include <cstddef>
+#include <vector>
+
+
+namespace
+{
+	//! Attitudes with a variety of (non-trivial) angles
+	inline
+	std::vector<rigibra::Attitude>
+	sampleAttitudes
+		( std::size_t const & numAtts
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		std::vector<Attitude> atts;
+		atts.reserve(numAtts);
+		for (std::size_t nn{0u} ; nn < numAtts ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			BiVector const biv
+				{ std::sin(.7*dn), std::cos(1.3*dn), std::sin(2.9*dn + .2) };
+			atts.emplace_back(Attitude(PhysAngle{ biv }));
+		}
+		return atts;
+	}
+
+} // [anon]
+
+
+//! Benchmark single-item operations in type.hpp
+int
+main
+	( int argc
+	, char * argv[]
+	)
+{
+	using namespace rigibra;
+	using namespace engabra::g3;
+
+	constexpr std::size_t numItems{ 1024u };
+	std::vector<Attitude> const atts{ sampleAttitudes(numItems) };
+	std::vector<Spinor> spins;
+	spins.reserve(numItems);
+	for (Attitude const & att : atts)
+	{
+		spins.emplace_back(att.spinor());
+	}
+	Vector const vec{ .3, -1.7, 2.2 };
+
+	std::vector<bench::Stats> allStats;
+
+	allStats.emplace_back
+		( bench::measure
+			( "Attitude::spinor", numItems, numItems
+			, [&atts] ()
+				{
+					for (Attitude const & att : atts)
+					{
+						bench::keep(att.spinor().theBiv);
+					}
+				}
+			)
+		);
+
+	allStats.emplace_back
+		( bench::measure
+			( "SpinAngle::from", numItems, numItems
+			, [&spins] ()
+				{
+					for (Spinor const & spin : spins)
+					{
+						bench::keep(SpinAngle::from(spin).theBiv);
+					}
+				}
+			)
+		);
+
+	allStats.emplace_back
+		( bench::measure
+			( "Attitude::Attitude(Spinor)", numItems, numItems
+			, [&spins] ()
+				{
+					for (Spinor const & spin : spins)
+					{
+						bench::keep(Attitude(spin).spinAngle().theBiv);
+					}
+				}
+			)
+		);
+
+	// reference: general purpose Engabra functions
+	allStats.emplace_back
+		( bench::measure
+			( "engabra::g3::exp", numItems, numItems
+			, [&atts] ()
+				{
+					for (Attitude const & att : atts)
+					{
+						bench::keep(exp(att.spinAngle().theBiv).theBiv);
+					}
+				}
+			)
+		);
+
+	allStats.emplace_back
+		( bench::measure
+			( "engabra::g3::logG2", numItems, numItems
+			, [&spins] ()
+				{
+					for (Spinor const & spin : spins)
+					{
+						bench::keep(logG2(spin).theBiv);
+					}
+				}
+			)
+		);
+
+	allStats.emplace_back
+		( bench::measure
+			( "Attitude::operator()", numItems, numItems
+			, [&atts, &vec] ()
+				{
+					for (Attitude const & att : atts)
+					{
+						bench::keep(att(vec));
+					}
+				}
+			)
+		);
+
+	allStats.emplace_back
+		( bench::measure
+			( "Transform::operator()", numItems, numItems
+			, [&atts, &vec] ()
+				{
+					for (Attitude const & att : atts)
+					{
+						Transform const xfm{ vec, att };
+						bench::keep(xfm(vec + vec));
+					}
+				}
+			)
+		);
+
+	allStats.emplace_back
+		( bench::measure
+			( "FastAttitude::FastAttitude", numItems, numItems
+			, [&atts] ()
+				{
+					for (Attitude const & att : atts)
+					{
+						bench::keep(FastAttitude(att).matrix()[1]);
+					}
+				}
+			)
+		);
+
+	std::vector<FastAttitude> fastAtts;
+	fastAtts.reserve(numItems);
+	for (Attitude const & att : atts)
+	{
+		fastAtts.emplace_back(FastAttitude(att));
+	}
+	allStats.emplace_back
+		( bench::measure
+			( "FastAttitude::operator()", numItems, numItems
+			, [&fastAtts, &vec] ()
+				{
+					for (FastAttitude const & fastAtt : fastAtts)
+					{
+						bench::keep(fastAtt(vec));
+					}
+				}
+			)
+		);
+
+	return bench::report("bench_type", allStats, argc, argv);
+}
+
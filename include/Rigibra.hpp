@@ -32,7 +32,27 @@
  */
 
 
+#include <block.hpp>
+#include <fast.hpp>
+#include <fit.hpp>
+#include <frame.hpp>
+#include <instrument.hpp>
 #include <func.hpp>
+#include <io.hpp>
+#include <jacobian.hpp>
+#include <linalg.hpp>
+#include <matrix.hpp>
+#include <mean.hpp>
+#include <pairs.hpp>
+#include <parallel.hpp>
+#include <pool.hpp>
+#include <poseindex.hpp>
+#include <precision.hpp>
+#include <ransac.hpp>
+#include <simd.hpp>
+#include <spin.hpp>
+#include <stream.hpp>
+#include <trajectory.hpp>
 #include <type.hpp>
 
 #include <string>
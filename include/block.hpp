@@ -0,0 +1,602 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_block_INCL_
+#define Rigibra_block_INCL_
+
+/*! \file
+\brief Contains TransformBlock for batch operations on many transforms.
+
+Example:
+\snippet test_block.cpp DoxyExample01
+
+*/
+
+
+#include "func.hpp"
+#include "type.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// (after other includes) defines Rigibra_LOOP_HINT - undefined at end
+#include "loophint.hpp"
+
+
+namespace rigibra
+{
+
+	//! Alignment (bytes) of TransformBlock arrays (a cache line).
+	constexpr std::size_t sBlockAlignment{ 64u };
+
+	//! Minimal allocator providing sBlockAlignment aligned storage.
+	template <typename Type>
+	struct AlignedAllocator
+	{
+		using value_type = Type;
+
+		//! Default construction
+		AlignedAllocator
+			() = default;
+
+		//! Rebind construction
+		template <typename Other>
+		constexpr
+		AlignedAllocator
+			( AlignedAllocator<Other> const &
+			) noexcept
+		{ }
+
+		//! Aligned storage for numItems values.
+		inline
+		Type *
+		allocate
+			( std::size_t const numItems
+			)
+		{
+			return static_cast<Type *>
+				(::operator new
+					( numItems * sizeof(Type)
+					, std::align_val_t{ sBlockAlignment }
+					)
+				);
+		}
+
+		//! Release storage from allocate()
+		inline
+		void
+		deallocate
+			( Type * const ptr
+			, std::size_t const
+			) noexcept
+		{
+			::operator delete(ptr, std::align_val_t{ sBlockAlignment });
+		}
+
+		//! All instances are interchangeable
+		template <typename Other>
+		constexpr
+		bool
+		operator==
+			( AlignedAllocator<Other> const &
+			) const noexcept
+		{
+			return true;
+		}
+
+		//! All instances are interchangeable
+		template <typename Other>
+		constexpr
+		bool
+		operator!=
+			( AlignedAllocator<Other> const &
+			) const noexcept
+		{
+			return false;
+		}
+
+	}; // AlignedAllocator
+
+	//! Cache line aligned array of values
+	using AlignedArray = std::vector<double, AlignedAllocator<double> >;
+
+
+	/*! \brief Collection of transforms stored as structure of arrays.
+	 *
+	 * Each transform parameter is stored in its own (cache line
+	 * aligned) array: location components (x,y,z) and the attitude
+	 * spinor components (scalar w, and bivector e23, e31, e12). This
+	 * layout allows the (branch free) element-wise operations below
+	 * to be auto-vectorized by the compiler.
+	 *
+	 * Element-wise operations mirror those in func.hpp:
+	 * \arg inverse(TransformBlock)
+	 * \arg operator*(TransformBlock, TransformBlock) - pairwise
+	 * \arg operator*(TransformBlock, SpinorTransform) - broadcast
+	 * \arg operator*(SpinorTransform, TransformBlock) - broadcast
+	 * \arg validMask(TransformBlock)
+	 *
+	 * Results have the same values as SpinorTransform operations on
+	 * each element (within roundoff). Unlike the SpinorTransform
+	 * operations, no validity check is performed; non-finite (e.g.
+	 * null) elements produce non-finite results via arithmetic.
+	 *
+	 * Example:
+	 * \snippet test_block.cpp DoxyExample01
+	 */
+	class TransformBlock
+	{
+		AlignedArray theLocX{};
+		AlignedArray theLocY{};
+		AlignedArray theLocZ{};
+		AlignedArray theSpinW{};
+		AlignedArray theSpinB0{};
+		AlignedArray theSpinB1{};
+		AlignedArray theSpinB2{};
+
+	public:
+
+		//! Construct an empty block
+		TransformBlock
+			() = default;
+
+		//! Construct block of numXfms null transforms.
+		inline
+		explicit
+		TransformBlock
+			( std::size_t const & numXfms
+			)
+		{
+			resize(numXfms);
+		}
+
+		//! Construct block with values from numXfms transforms.
+		inline
+		explicit
+		TransformBlock
+			( Transform const * const xfms
+			, std::size_t const & numXfms
+			)
+			: TransformBlock(numXfms)
+		{
+			for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+			{
+				set(nn, SpinorTransform::from(xfms[nn]));
+			}
+		}
+
+		//! Construct block with values from each transform in xfms.
+		inline
+		explicit
+		TransformBlock
+			( std::vector<Transform> const & xfms
+			)
+			: TransformBlock(xfms.data(), xfms.size())
+		{ }
+
+		//! Number of transforms in block
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theLocX.size();
+		}
+
+		//! Change number of transforms (new elements are null)
+		inline
+		void
+		resize
+			( std::size_t const & numXfms
+			)
+		{
+			for (AlignedArray * const & ptArray
+				: { &theLocX, &theLocY, &theLocZ
+				  , &theSpinW, &theSpinB0, &theSpinB1, &theSpinB2 })
+			{
+				ptArray->resize(numXfms, sNullValue);
+			}
+		}
+
+		//! Assign values of element ndx (no bounds checking)
+		inline
+		void
+		set
+			( std::size_t const & ndx
+			, SpinorTransform const & xfm
+			)
+		{
+			engabra::g3::Spinor const & spin = xfm.theAtt.spinor();
+			theLocX[ndx] = xfm.theLoc[0];
+			theLocY[ndx] = xfm.theLoc[1];
+			theLocZ[ndx] = xfm.theLoc[2];
+			theSpinW[ndx] = spin.theSca[0];
+			theSpinB0[ndx] = spin.theBiv[0];
+			theSpinB1[ndx] = spin.theBiv[1];
+			theSpinB2[ndx] = spin.theBiv[2];
+		}
+
+		//! Assign values of element ndx (no bounds checking)
+		inline
+		void
+		set
+			( std::size_t const & ndx
+			, Transform const & xfm
+			)
+		{
+			set(ndx, SpinorTransform::from(xfm));
+		}
+
+		//! Element ndx (no bounds checking)
+		inline
+		SpinorTransform
+		spinorTransform
+			( std::size_t const & ndx
+			) const
+		{
+			return SpinorTransform
+				{ Location{ theLocX[ndx], theLocY[ndx], theLocZ[ndx] }
+				, SpinorAttitude(engabra::g3::Spinor
+					{ theSpinW[ndx]
+					, theSpinB0[ndx], theSpinB1[ndx], theSpinB2[ndx]
+					})
+				};
+		}
+
+		//! Element ndx as Transform (evaluates logarithm)
+		inline
+		Transform
+		transform
+			( std::size_t const & ndx
+			) const
+		{
+			return spinorTransform(ndx).transform();
+		}
+
+		//! All elements as Transforms (evaluates logarithms)
+		inline
+		std::vector<Transform>
+		transforms
+			() const
+		{
+			std::vector<Transform> xfms;
+			xfms.reserve(size());
+			for (std::size_t nn{0u} ; nn < size() ; ++nn)
+			{
+				xfms.emplace_back(transform(nn));
+			}
+			return xfms;
+		}
+
+		//! Location x components (size() values)
+		inline double const * locX() const { return theLocX.data(); }
+		//! Location y components (size() values)
+		inline double const * locY() const { return theLocY.data(); }
+		//! Location z components (size() values)
+		inline double const * locZ() const { return theLocZ.data(); }
+		//! Spinor scalar components (size() values)
+		inline double const * spinW() const { return theSpinW.data(); }
+		//! Spinor e23 components (size() values)
+		inline double const * spinB0() const { return theSpinB0.data(); }
+		//! Spinor e31 components (size() values)
+		inline double const * spinB1() const { return theSpinB1.data(); }
+		//! Spinor e12 components (size() values)
+		inline double const * spinB2() const { return theSpinB2.data(); }
+
+		//! Location x components (size() values)
+		inline double * locX() { return theLocX.data(); }
+		//! Location y components (size() values)
+		inline double * locY() { return theLocY.data(); }
+		//! Location z components (size() values)
+		inline double * locZ() { return theLocZ.data(); }
+		//! Spinor scalar components (size() values)
+		inline double * spinW() { return theSpinW.data(); }
+		//! Spinor e23 components (size() values)
+		inline double * spinB0() { return theSpinB0.data(); }
+		//! Spinor e31 components (size() values)
+		inline double * spinB1() { return theSpinB1.data(); }
+		//! Spinor e12 components (size() values)
+		inline double * spinB2() { return theSpinB2.data(); }
+
+	}; // TransformBlock
+
+
+	/*! Element-wise inverse (such that result[nn]*fwd[nn] = identity)
+	 *
+	 * Example:
+	 * \snippet test_block.cpp DoxyExample01
+	 */
+	inline
+	TransformBlock
+	inverse
+		( TransformBlock const & fwd
+		)
+	{
+		std::size_t const numXfms{ fwd.size() };
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numXfms);
+		TransformBlock inv(numXfms);
+		double const * const tx = fwd.locX();
+		double const * const ty = fwd.locY();
+		double const * const tz = fwd.locZ();
+		double const * const sw = fwd.spinW();
+		double const * const s0 = fwd.spinB0();
+		double const * const s1 = fwd.spinB1();
+		double const * const s2 = fwd.spinB2();
+		double * const ix = inv.locX();
+		double * const iy = inv.locY();
+		double * const iz = inv.locZ();
+		double * const iw = inv.spinW();
+		double * const i0 = inv.spinB0();
+		double * const i1 = inv.spinB1();
+		double * const i2 = inv.spinB2();
+		Rigibra_LOOP_HINT
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			// inverse location is negative of rotated location
+			double const ww{ sw[nn] };
+			double const b0{ s0[nn] };
+			double const b1{ s1[nn] };
+			double const b2{ s2[nn] };
+			double const b00{ b0 * b0 };
+			double const b11{ b1 * b1 };
+			double const b22{ b2 * b2 };
+			double const magSq{ ww*ww + b00 + b11 + b22 };
+			double const scl{ 1. / magSq };
+			double const w0{ ww * b0 }, w1{ ww * b1 }, w2{ ww * b2 };
+			double const b01{ b0 * b1 }, b02{ b0 * b2 }, b12{ b1 * b2 };
+			double const x0{ tx[nn] }, x1{ ty[nn] }, x2{ tz[nn] };
+			ix[nn] = -scl * ( (magSq - 2.*(b11 + b22)) * x0
+							+ 2.*(b01 + w2) * x1
+							+ 2.*(b02 - w1) * x2 );
+			iy[nn] = -scl * ( 2.*(b01 - w2) * x0
+							+ (magSq - 2.*(b00 + b22)) * x1
+							+ 2.*(b12 + w0) * x2 );
+			iz[nn] = -scl * ( 2.*(b02 + w1) * x0
+							+ 2.*(b12 - w0) * x1
+							+ (magSq - 2.*(b00 + b11)) * x2 );
+			// inverse attitude is spinor reverse
+			iw[nn] = ww;
+			i0[nn] = -b0;
+			i1[nn] = -b1;
+			i2[nn] = -b2;
+		}
+		return inv;
+	}
+
+	/*! Composition of element nn of two blocks into element nn of result.
+	 *
+	 * Each of blocks xBwA and xAwX must have numXfms elements, or a
+	 * single element if the corresponding Stride is zero (i.e. for
+	 * broadcast of one transform). Strides are template parameters
+	 * so that the compiler can vectorize each case. Same math as
+	 * SpinorTransform operator*() in func.hpp.
+	 *
+	 * The result may be the same block as a (stride one) input but
+	 * must not be the same as a broadcast (stride zero) input.
+	 */
+	template <std::size_t StrideB, std::size_t StrideA>
+	inline
+	void
+	compose
+		( TransformBlock const & xBwA
+		, TransformBlock const & xAwX
+		, std::size_t const & numXfms
+		, TransformBlock * const & ptResult
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numXfms);
+		double const * const bx = xBwA.locX();
+		double const * const by = xBwA.locY();
+		double const * const bz = xBwA.locZ();
+		double const * const bw = xBwA.spinW();
+		double const * const b0 = xBwA.spinB0();
+		double const * const b1 = xBwA.spinB1();
+		double const * const b2 = xBwA.spinB2();
+		double const * const ax = xAwX.locX();
+		double const * const ay = xAwX.locY();
+		double const * const az = xAwX.locZ();
+		double const * const aw = xAwX.spinW();
+		double const * const a0 = xAwX.spinB0();
+		double const * const a1 = xAwX.spinB1();
+		double const * const a2 = xAwX.spinB2();
+		double * const rx = ptResult->locX();
+		double * const ry = ptResult->locY();
+		double * const rz = ptResult->locZ();
+		double * const rw = ptResult->spinW();
+		double * const r0 = ptResult->spinB0();
+		double * const r1 = ptResult->spinB1();
+		double * const r2 = ptResult->spinB2();
+		Rigibra_LOOP_HINT
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			std::size_t const nb{ StrideB * nn };
+			std::size_t const na{ StrideA * nn };
+
+			// attitude: spinor product (ref func.hpp)
+			double const uw{ bw[nb] }, u0{ b0[nb] }, u1{ b1[nb] }, u2{ b2[nb] };
+			double const vw{ aw[na] }, v0{ a0[na] }, v1{ a1[na] }, v2{ a2[na] };
+			double const pw{ uw*vw - (u0*v0 + u1*v1 + u2*v2) };
+			double const p0{ uw*v0 + vw*u0 - (u1*v2 - u2*v1) };
+			double const p1{ uw*v1 + vw*u1 - (u2*v0 - u0*v2) };
+			double const p2{ uw*v2 + vw*u2 - (u0*v1 - u1*v0) };
+
+			// location: aLoc + inverse(attA)(bLoc) - i.e. rotate bLoc
+			// with reversed spinor of attA
+			double const c0{ -v0 }, c1{ -v1 }, c2{ -v2 };
+			double const c00{ c0 * c0 }, c11{ c1 * c1 }, c22{ c2 * c2 };
+			double const magSq{ vw*vw + c00 + c11 + c22 };
+			double const scl{ 1. / magSq };
+			double const w0{ vw * c0 }, w1{ vw * c1 }, w2{ vw * c2 };
+			double const c01{ c0 * c1 }, c02{ c0 * c2 }, c12{ c1 * c2 };
+			double const x0{ bx[nb] }, x1{ by[nb] }, x2{ bz[nb] };
+			rx[nn] = ax[na] + scl * ( (magSq - 2.*(c11 + c22)) * x0
+									+ 2.*(c01 + w2) * x1
+									+ 2.*(c02 - w1) * x2 );
+			ry[nn] = ay[na] + scl * ( 2.*(c01 - w2) * x0
+									+ (magSq - 2.*(c00 + c22)) * x1
+									+ 2.*(c12 + w0) * x2 );
+			rz[nn] = az[na] + scl * ( 2.*(c02 + w1) * x0
+									+ 2.*(c12 - w0) * x1
+									+ (magSq - 2.*(c00 + c11)) * x2 );
+			rw[nn] = pw;
+			r0[nn] = p0;
+			r1[nn] = p1;
+			r2[nn] = p2;
+		}
+	}
+
+	/*! Pairwise composition: result[nn] = xBwA[nn] * xAwX[nn]
+	 *
+	 * Blocks must be the same size (otherwise result is empty).
+	 *
+	 * Example:
+	 * \snippet test_block.cpp DoxyExample01
+	 */
+	inline
+	TransformBlock
+	operator*
+		( TransformBlock const & xBwA
+		, TransformBlock const & xAwX
+		)
+	{
+		TransformBlock result{};
+		if (xBwA.size() == xAwX.size())
+		{
+			std::size_t const numXfms{ xBwA.size() };
+			result.resize(numXfms);
+			compose<1u, 1u>(xBwA, xAwX, numXfms, &result);
+		}
+		return result;
+	}
+
+	//! Broadcast composition: result[nn] = xBwA[nn] * xAwX
+	inline
+	TransformBlock
+	operator*
+		( TransformBlock const & xBwA
+		, SpinorTransform const & xAwX
+		)
+	{
+		TransformBlock one(1u);
+		one.set(0u, xAwX);
+		std::size_t const numXfms{ xBwA.size() };
+		TransformBlock result(numXfms);
+		compose<1u, 0u>(xBwA, one, numXfms, &result);
+		return result;
+	}
+
+	//! Broadcast composition: result[nn] = xBwA * xAwX[nn]
+	inline
+	TransformBlock
+	operator*
+		( SpinorTransform const & xBwA
+		, TransformBlock const & xAwX
+		)
+	{
+		TransformBlock one(1u);
+		one.set(0u, xBwA);
+		std::size_t const numXfms{ xAwX.size() };
+		TransformBlock result(numXfms);
+		compose<0u, 1u>(one, xAwX, numXfms, &result);
+		return result;
+	}
+
+	//! Broadcast composition: result[nn] = xBwA[nn] * xAwX
+	inline
+	TransformBlock
+	operator*
+		( TransformBlock const & xBwA
+		, Transform const & xAwX
+		)
+	{
+		return xBwA * SpinorTransform::from(xAwX);
+	}
+
+	//! Broadcast composition: result[nn] = xBwA * xAwX[nn]
+	inline
+	TransformBlock
+	operator*
+		( Transform const & xBwA
+		, TransformBlock const & xAwX
+		)
+	{
+		return SpinorTransform::from(xBwA) * xAwX;
+	}
+
+	/*! Validity of each element: mask[nn] is 1 if valid, else 0.
+	 *
+	 * The mask array must have space for block.size() values.
+	 */
+	inline
+	void
+	validMask
+		( TransformBlock const & block
+		, std::uint8_t * const mask
+		)
+	{
+		std::size_t const numXfms{ block.size() };
+		double const * const tx = block.locX();
+		double const * const ty = block.locY();
+		double const * const tz = block.locZ();
+		double const * const sw = block.spinW();
+		double const * const s0 = block.spinB0();
+		double const * const s1 = block.spinB1();
+		double const * const s2 = block.spinB2();
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			// same sense as isValid(): only NaN (not infinity) is invalid
+			// (bitwise '&' avoids branches of short circuit evaluation)
+			int const validLoc
+				{ (tx[nn] == tx[nn]) & (ty[nn] == ty[nn]) & (tz[nn] == tz[nn]) };
+			int const validSpin
+				{ (sw[nn] == sw[nn])
+				& (s0[nn] == s0[nn]) & (s1[nn] == s1[nn]) & (s2[nn] == s2[nn])
+				};
+			mask[nn] = static_cast<std::uint8_t>(validLoc & validSpin);
+		}
+	}
+
+	//! Validity of each element: return[nn] is 1 if valid, else 0.
+	inline
+	std::vector<std::uint8_t>
+	validMask
+		( TransformBlock const & block
+		)
+	{
+		std::vector<std::uint8_t> mask(block.size());
+		validMask(block, mask.data());
+		return mask;
+	}
+
+} // [rigibra]
+
+// loop hint is only for use within this header
+#undef Rigibra_LOOP_HINT
+
+
+#endif // Rigibra_block_INCL_
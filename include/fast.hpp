@@ -0,0 +1,224 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+#ifndef Rigibra_fast_INCL_
+#define Rigibra_fast_INCL_
+
+/*! \file
+\brief Contains precomputed forms of Attitude and Transform for bulk data.
+
+Example:
+\snippet test_fast.cpp DoxyExample01
+
+*/
+
+
+#include "type.hpp"
+
+#include <array>
+
+
+namespace rigibra
+{
+
+	/*! \brief Attitude with spinor and rotation matrix precomputed.
+	 *
+	 * The Attitude class stores a SpinAngle and evaluates the spinor
+	 * (an exponential) each time a vector is transformed. This class
+	 * evaluates the spinor once at construction and expands it into
+	 * an equivalent 3x3 rotation matrix. Each vector transformation
+	 * then costs 9 multiplies and 6 adds.
+	 *
+	 * Intended for transforming large quantities of data with the
+	 * same attitude. E.g.
+	 * \snippet test_fast.cpp DoxyExample01
+	 */
+	class FastAttitude
+	{
+		//! Spinor associated with attitude: y = theSpin * x * reverse(theSpin)
+		engabra::g3::Spinor theSpin{ engabra::g3::null<engabra::g3::Spinor>() };
+
+		//! Rotation matrix (row-major) equivalent to #theSpin sandwich.
+		std::array<double, 9u> theMat;
+
+		//! Rotation matrix (row-major) equivalent to spinor sandwich.
+		inline
+		static
+		std::array<double, 9u>
+		matrixFor
+			( engabra::g3::Spinor const & spin
+			)
+		{
+			// scalar and bivector (e23, e31, e12) components
+			double const & ww = spin.theSca[0];
+			double const & b0 = spin.theBiv[0];
+			double const & b1 = spin.theBiv[1];
+			double const & b2 = spin.theBiv[2];
+			//
+			double const w0{ ww * b0 };
+			double const w1{ ww * b1 };
+			double const w2{ ww * b2 };
+			double const b00{ b0 * b0 };
+			double const b11{ b1 * b1 };
+			double const b22{ b2 * b2 };
+			double const b01{ b0 * b1 };
+			double const b02{ b0 * b2 };
+			double const b12{ b1 * b2 };
+			return std::array<double, 9u>
+				{ 1. - 2.*(b11 + b22),      2.*(b01 + w2),      2.*(b02 - w1)
+				,      2.*(b01 - w2), 1. - 2.*(b00 + b22),      2.*(b12 + w0)
+				,      2.*(b02 + w1),      2.*(b12 - w0), 1. - 2.*(b00 + b11)
+				};
+		}
+
+	public:
+
+		//! Construct from (and to behave identically as) an Attitude.
+		inline
+		explicit
+		FastAttitude
+			( Attitude const & att
+			)
+			: theSpin{ att.spinor() }
+			, theMat{ matrixFor(theSpin) }
+		{ }
+
+		//! Construct from (and to behave identically as) a SpinorAttitude.
+		inline
+		explicit
+		FastAttitude
+			( SpinorAttitude const & att
+			)
+			: theSpin{ att.normalized().spinor() }
+			, theMat{ matrixFor(theSpin) }
+		{ }
+
+		//! True if this instance is not null
+		inline
+		bool
+		isValid
+			() const
+		{
+			return engabra::g3::isValid(theSpin);
+		}
+
+		//! Spinor representation (same as Attitude::spinor()).
+		inline
+		engabra::g3::Spinor const &
+		spinor
+			() const
+		{
+			return theSpin;
+		}
+
+		//! Rotation matrix (row-major) such that y[r] = sum_c(mat[3*r+c]*x[c])
+		inline
+		std::array<double, 9u> const &
+		matrix
+			() const
+		{
+			return theMat;
+		}
+
+		//! Expressed of vector in range(into) frame equiv to vecFrom in domain.
+		inline
+		engabra::g3::Vector
+		operator()
+			( engabra::g3::Vector const & vecFrom
+			) const
+		{
+			return engabra::g3::Vector
+				{ theMat[0]*vecFrom[0] + theMat[1]*vecFrom[1] + theMat[2]*vecFrom[2]
+				, theMat[3]*vecFrom[0] + theMat[4]*vecFrom[1] + theMat[5]*vecFrom[2]
+				, theMat[6]*vecFrom[0] + theMat[7]*vecFrom[1] + theMat[8]*vecFrom[2]
+				};
+		}
+
+	}; // FastAttitude
+
+
+	/*! \brief Transform with attitude precomputed for bulk data use.
+	 *
+	 * Behaves as Transform::operator()() but uses a FastAttitude
+	 * so that no exponential is evaluated per transformed vector.
+	 */
+	struct FastTransform
+	{
+		//! Location of body expressed in reference system.
+		engabra::g3::Vector theLoc{ engabra::g3::null<engabra::g3::Vector>() };
+
+		//! Precomputed attitude of body with respect to reference frame.
+		FastAttitude theAtt{ null<Attitude>() };
+
+		//! Construct from (and to behave identically as) a Transform.
+		inline
+		explicit
+		FastTransform
+			( Transform const & xfm
+			)
+			: theLoc{ xfm.theLoc }
+			, theAtt{ xfm.theAtt }
+		{ }
+
+		//! Construct from (and to behave identically as) a SpinorTransform.
+		inline
+		explicit
+		FastTransform
+			( SpinorTransform const & xfm
+			)
+			: theLoc{ xfm.theLoc }
+			, theAtt{ xfm.theAtt }
+		{ }
+
+		//! True if this instance is not null
+		inline
+		bool
+		isValid
+			() const
+		{
+			return
+				(  engabra::g3::isValid(theLoc)
+				&& theAtt.isValid()
+				);
+		}
+
+		//! Expressed of vector in range(into) frame equiv to vecFrom in domain.
+		inline
+		engabra::g3::Vector
+		operator()
+			( engabra::g3::Vector const & vecFrom
+			) const
+		{
+			using namespace engabra::g3;
+			return theAtt(vecFrom - theLoc);
+		}
+
+	}; // FastTransform
+
+
+} // [rigibra]
+
+
+#endif // Rigibra_fast_INCL_
@@ -0,0 +1,480 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_fit_INCL_
+#define Rigibra_fit_INCL_
+
+/*! \file
+\brief Contains closed-form Transform estimation from point correspondences.
+
+Example:
+\snippet test_fit.cpp DoxyExample01
+
+*/
+
+
+#include "linalg.hpp"
+#include "pool.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+namespace rigibra
+{
+
+	/*! \brief Streaming accumulator for best fit Transform (Horn's method).
+	 *
+	 * Accumulates (weighted) correspondences between points, x,
+	 * expressed in the domain (from) frame and the same points, y,
+	 * expressed in the range (into) frame. The solution is the
+	 * Transform, xfm, that minimizes
+	 * \arg sum( w * |y - xfm(x)|^2 )
+	 *
+	 * Only first moments (means) and centered second moments are kept
+	 * (updated incrementally for numerical stability with large
+	 * coordinate offsets). Memory use and solution cost are constant
+	 * (independent of number of correspondences). Partial accumulators
+	 * (e.g. from separate threads) are combined with merge().
+	 *
+	 * The attitude is the dominant eigen vector of Horn's 4x4 symmetric
+	 * matrix formed from the cross covariance. The solution is null if
+	 * it is not unique (e.g. fewer than three non-collinear points).
+	 *
+	 * Example:
+	 * \snippet test_fit.cpp DoxyExample01
+	 */
+	class FitAccumulator
+	{
+		//! Sum of weights
+		double theWeightSum{ 0. };
+
+		//! Number of correspondences added (with positive weight)
+		std::size_t theCount{ 0u };
+
+		//! Weighted mean of domain (from) points
+		std::array<double, 3u> theMeanFrom{};
+
+		//! Weighted mean of range (into) points
+		std::array<double, 3u> theMeanInto{};
+
+		//! Cross covariance, sum(w*dx[a]*dy[b]) at [3*a+b], about means
+		std::array<double, 9u> theCovar{};
+
+		//! Sum of (weighted) squared domain point deviations from mean
+		double theVarFrom{ 0. };
+
+		//! Sum of (weighted) squared range point deviations from mean
+		double theVarInto{ 0. };
+
+		//! True if all components of correspondence are finite
+		inline
+		static
+		bool
+		isFinitePair
+			( engabra::g3::Vector const & from
+			, engabra::g3::Vector const & into
+			)
+		{
+			return
+				(  isFinite(from[0]) && isFinite(from[1]) && isFinite(from[2])
+				&& isFinite(into[0]) && isFinite(into[1]) && isFinite(into[2])
+				);
+		}
+
+		//! Dominant eigen system of Horn's matrix (from cross covariance)
+		inline
+		linalg::EigenSystem4
+		hornEigen
+			() const
+		{
+			std::array<double, 9u> const & ss = theCovar;
+			double const sxx{ ss[0] }, sxy{ ss[1] }, sxz{ ss[2] };
+			double const syx{ ss[3] }, syy{ ss[4] }, syz{ ss[5] };
+			double const szx{ ss[6] }, szy{ ss[7] }, szz{ ss[8] };
+			linalg::Matrix4 const nMat
+				{ sxx + syy + szz, syz - szy, szx - sxz, sxy - syx
+				, syz - szy, sxx - syy - szz, sxy + syx, szx + sxz
+				, szx - sxz, sxy + syx, -sxx + syy - szz, syz + szy
+				, sxy - syx, szx + sxz, syz + szy, -sxx - syy + szz
+				};
+			return linalg::eigenSymmetric(nMat);
+		}
+
+	public:
+
+		//! Relative eigen value separation below which fit is not unique.
+		static constexpr double sGapTolerance{ 1.e-12 };
+
+		//! Incorporate correspondence (into = xfm(from)) with weight.
+		inline
+		void
+		add
+			( engabra::g3::Vector const & from
+			, engabra::g3::Vector const & into
+			, double const & weight = 1.
+			)
+		{
+			if ((0. < weight) && isFinitePair(from, into)) // ignores NaNs
+			{
+				theWeightSum += weight;
+				double const frac{ weight / theWeightSum };
+				std::array<double, 3u> dx;
+				std::array<double, 3u> dy;
+				for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+				{
+					dx[kk] = from[kk] - theMeanFrom[kk];
+					dy[kk] = into[kk] - theMeanInto[kk];
+					theMeanFrom[kk] += frac * dx[kk];
+					theMeanInto[kk] += frac * dy[kk];
+				}
+				double const wgt{ weight * (1. - frac) };
+				for (std::size_t aa{0u} ; aa < 3u ; ++aa)
+				{
+					double const wdx{ wgt * dx[aa] };
+					for (std::size_t bb{0u} ; bb < 3u ; ++bb)
+					{
+						theCovar[3u*aa + bb] += wdx * dy[bb];
+					}
+					theVarFrom += wdx * dx[aa];
+					theVarInto += wgt * dy[aa] * dy[aa];
+				}
+				++theCount;
+			}
+		}
+
+		/*! Incorporate a batch of correspondences.
+		 *
+		 * The batch moments are accumulated in one pass about the first
+		 * (valid) pair (which avoids loss of precision from large
+		 * coordinate offsets), centered, and then merged into this
+		 * instance. If weights is not null, pair nn is added with
+		 * weight weights[nn], otherwise all weights are one.
+		 */
+		inline
+		void
+		add
+			( engabra::g3::Vector const * const froms
+			, engabra::g3::Vector const * const intos
+			, std::size_t const & numPairs
+			, double const * const weights = nullptr
+			)
+		{
+			FitAccumulator batch;
+			std::array<double, 3u> & sumX = batch.theMeanFrom;
+			std::array<double, 3u> & sumY = batch.theMeanInto;
+			engabra::g3::Vector shiftX{};
+			engabra::g3::Vector shiftY{};
+			for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+			{
+				double const weight{ weights ? weights[nn] : 1. };
+				if (! ((0. < weight) && isFinitePair(froms[nn], intos[nn])))
+				{
+					continue;
+				}
+				if (0u == batch.theCount)
+				{
+					shiftX = froms[nn];
+					shiftY = intos[nn];
+				}
+				std::array<double, 3u> const dx
+					{ froms[nn][0] - shiftX[0]
+					, froms[nn][1] - shiftX[1]
+					, froms[nn][2] - shiftX[2]
+					};
+				std::array<double, 3u> const dy
+					{ intos[nn][0] - shiftY[0]
+					, intos[nn][1] - shiftY[1]
+					, intos[nn][2] - shiftY[2]
+					};
+				for (std::size_t aa{0u} ; aa < 3u ; ++aa)
+				{
+					double const wdx{ weight * dx[aa] };
+					double const wdy{ weight * dy[aa] };
+					for (std::size_t bb{0u} ; bb < 3u ; ++bb)
+					{
+						batch.theCovar[3u*aa + bb] += wdx * dy[bb];
+					}
+					batch.theVarFrom += wdx * dx[aa];
+					batch.theVarInto += wdy * dy[aa];
+					sumX[aa] += wdx;
+					sumY[aa] += wdy;
+				}
+				batch.theWeightSum += weight;
+				++batch.theCount;
+			}
+			if (! (0u < batch.theCount))
+			{
+				return;
+			}
+
+			// center second moments: sum(w*dx*dy^T) - W*mx*my^T
+			double const invWeight{ 1. / batch.theWeightSum };
+			for (std::size_t aa{0u} ; aa < 3u ; ++aa)
+			{
+				for (std::size_t bb{0u} ; bb < 3u ; ++bb)
+				{
+					batch.theCovar[3u*aa + bb] -= invWeight * sumX[aa] * sumY[bb];
+				}
+				batch.theVarFrom -= invWeight * sumX[aa] * sumX[aa];
+				batch.theVarInto -= invWeight * sumY[aa] * sumY[aa];
+			}
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				sumX[kk] = shiftX[kk] + invWeight * sumX[kk];
+				sumY[kk] = shiftY[kk] + invWeight * sumY[kk];
+			}
+			merge(batch);
+		}
+
+		//! Combine other (partial) accumulation into this one.
+		inline
+		void
+		merge
+			( FitAccumulator const & other
+			)
+		{
+			if (! (0. < other.theWeightSum))
+			{
+				return;
+			}
+			if (! (0. < theWeightSum))
+			{
+				*this = other;
+				return;
+			}
+			double const sumWeight{ theWeightSum + other.theWeightSum };
+			double const frac{ other.theWeightSum / sumWeight };
+			double const wgt{ theWeightSum * frac };
+			std::array<double, 3u> dx;
+			std::array<double, 3u> dy;
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				dx[kk] = other.theMeanFrom[kk] - theMeanFrom[kk];
+				dy[kk] = other.theMeanInto[kk] - theMeanInto[kk];
+				theMeanFrom[kk] += frac * dx[kk];
+				theMeanInto[kk] += frac * dy[kk];
+			}
+			for (std::size_t aa{0u} ; aa < 3u ; ++aa)
+			{
+				double const wdx{ wgt * dx[aa] };
+				for (std::size_t bb{0u} ; bb < 3u ; ++bb)
+				{
+					theCovar[3u*aa + bb] += other.theCovar[3u*aa + bb]
+						+ wdx * dy[bb];
+				}
+				theVarFrom += wdx * dx[aa];
+				theVarInto += wgt * dy[aa] * dy[aa];
+			}
+			theVarFrom += other.theVarFrom;
+			theVarInto += other.theVarInto;
+			theWeightSum = sumWeight;
+			theCount += other.theCount;
+		}
+
+		//! Number of correspondences added (with positive weight)
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theCount;
+		}
+
+		//! Sum of weights
+		inline
+		double
+		weight
+			() const
+		{
+			return theWeightSum;
+		}
+
+		/*! Best fit transformation (null if not unique).
+		 *
+		 * Evaluation cost is independent of the number of
+		 * correspondences (one 4x4 eigen decomposition).
+		 */
+		inline
+		SpinorTransform
+		spinorTransform
+			() const
+		{
+			if (theCount < 3u)
+			{
+				return null<SpinorTransform>();
+			}
+			linalg::EigenSystem4 const eig{ hornEigen() };
+			double const scale
+				{ std::max(std::abs(eig.theValues[0]), std::abs(eig.theValues[3])) };
+			double const gap{ eig.theValues[0] - eig.theValues[1] };
+			if (! (sGapTolerance * scale < gap)) // also if scale is zero
+			{
+				return null<SpinorTransform>();
+			}
+
+			// Horn quaternion (w,x,y,z) with spinor as (w,-x,-y,-z)
+			linalg::Vector4 const & qq = eig.theVectors[0];
+			double const sgn{ (qq[0] < 0.) ? -1. : 1. };
+			double const mag
+				{ std::sqrt(qq[0]*qq[0] + qq[1]*qq[1] + qq[2]*qq[2] + qq[3]*qq[3]) };
+			double const scl{ sgn / mag };
+			SpinorAttitude const att(engabra::g3::Spinor
+				{ scl*qq[0], -scl*qq[1], -scl*qq[2], -scl*qq[3] });
+
+			// location, t, such that meanInto = att(meanFrom - t)
+			SpinorAttitude const inv(engabra::g3::Spinor
+				{ scl*qq[0], scl*qq[1], scl*qq[2], scl*qq[3] });
+			engabra::g3::Vector const back
+				{ inv(engabra::g3::Vector
+					{ theMeanInto[0], theMeanInto[1], theMeanInto[2] })
+				};
+			return SpinorTransform
+				{ engabra::g3::Vector
+					{ theMeanFrom[0] - back[0]
+					, theMeanFrom[1] - back[1]
+					, theMeanFrom[2] - back[2]
+					}
+				, att
+				};
+		}
+
+		//! Best fit transformation (ref spinorTransform())
+		inline
+		Transform
+		transform
+			() const
+		{
+			SpinorTransform const xfm{ spinorTransform() };
+			if (! xfm.isValid())
+			{
+				return null<Transform>();
+			}
+			return xfm.transform();
+		}
+
+		/*! Minimum (weighted) sum of squared residuals for best fit.
+		 *
+		 * I.e. sum(w*|y - xfm(x)|^2) for xfm = spinorTransform() - which
+		 * is obtained from the accumulated moments without revisiting
+		 * any correspondences. Since it is a difference of moments, its
+		 * precision is relative to the sum of squared point deviations
+		 * (e.g. near-zero residuals are not resolved exactly).
+		 */
+		inline
+		double
+		residualSumSquared
+			() const
+		{
+			if (theCount < 1u)
+			{
+				return sNullValue;
+			}
+			linalg::EigenSystem4 const eig{ hornEigen() };
+			double const sumSq
+				{ theVarFrom + theVarInto - 2. * eig.theValues[0] };
+			return std::max(0., sumSq);
+		}
+
+	}; // FitAccumulator
+
+	//! Accumulation of correspondences (ref FitAccumulator::add()).
+	inline
+	FitAccumulator
+	fitAccumulatorFor
+		( engabra::g3::Vector const * const froms
+		, engabra::g3::Vector const * const intos
+		, std::size_t const & numPairs
+		, double const * const weights = nullptr
+		)
+	{
+		FitAccumulator accum;
+		accum.add(froms, intos, numPairs, weights);
+		return accum;
+	}
+
+	//! Default number of correspondences accumulated by each parallel chunk.
+	constexpr std::size_t sFitChunkSize{ 16u * 1024u };
+
+	/*! Multi-threaded accumulation (ref fitAccumulatorFor()).
+	 *
+	 * Each chunk is accumulated concurrently and the chunk results are
+	 * merged in order (such that results are deterministic).
+	 */
+	inline
+	FitAccumulator
+	fitAccumulatorFor
+		( ThreadPool & pool
+		, engabra::g3::Vector const * const froms
+		, engabra::g3::Vector const * const intos
+		, std::size_t const & numPairs
+		, double const * const weights = nullptr
+		, std::size_t const & chunkSize = sFitChunkSize
+		)
+	{
+		std::size_t const useSize{ std::max(std::size_t{ 1u }, chunkSize) };
+		std::size_t const numChunks{ (numPairs + useSize - 1u) / useSize };
+		std::vector<FitAccumulator> chunkAccums(numChunks);
+		pool.parallelFor
+			( numPairs
+			, useSize
+			, [&] (std::size_t const & beg, std::size_t const & end)
+				{
+					chunkAccums[beg / useSize] = fitAccumulatorFor
+						( froms + beg, intos + beg, (end - beg)
+						, (weights ? (weights + beg) : nullptr)
+						);
+				}
+			);
+		FitAccumulator accum;
+		for (FitAccumulator const & chunkAccum : chunkAccums)
+		{
+			accum.merge(chunkAccum);
+		}
+		return accum;
+	}
+
+	//! Best fit Transform such that intos[nn] ~= xfm(froms[nn]).
+	inline
+	Transform
+	fitTransform
+		( engabra::g3::Vector const * const froms
+		, engabra::g3::Vector const * const intos
+		, std::size_t const & numPairs
+		, double const * const weights = nullptr
+		)
+	{
+		return fitAccumulatorFor(froms, intos, numPairs, weights).transform();
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_fit_INCL_
@@ -0,0 +1,446 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_frame_INCL_
+#define Rigibra_frame_INCL_
+
+/*! \file
+\brief Contains FrameTree for managing hierarchies of coordinate frames.
+
+Example:
+\snippet test_frame.cpp DoxyExample01
+
+*/
+
+
+#include "func.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace rigibra
+{
+
+	/*! \brief Hierarchy of frames, each with a Transform wrt its parent.
+	 *
+	 * A tree is created with a single root frame (e.g. a world or
+	 * reference frame). Other frames are added with a parent frame
+	 * and a local transform (of the frame with respect to the parent).
+	 *
+	 * Query results are cached:
+	 * \arg world(): Transform of frame wrt root. Cached per frame.
+	 *      When a local transform is changed, only the cached values
+	 *      for the affected subtree are invalidated (dirty flags).
+	 * \arg relative(): Transform between any two frames. Composed
+	 *      through the lowest common ancestor (LCA) of the two frames
+	 *      and cached per frame pair. A cached value remains valid
+	 *      until a local transform on one of the two paths to the LCA
+	 *      changes - e.g. updating a vehicle pose wrt the world does
+	 *      NOT invalidate relative transforms between sensors mounted
+	 *      on the vehicle. Each query walks both paths to the LCA
+	 *      (O(depth)) to check validity such that a cache hit saves
+	 *      only the compositions (and transform conversion). At most
+	 *      sMaxRelatives pairs are cached: the cache is cleared when
+	 *      full (memory use is bounded for any query pattern).
+	 *
+	 * Compositions are performed with SpinorTransform values so that
+	 * (re)computation requires no exponential evaluations.
+	 *
+	 * Note: query methods update (mutable) caches and are therefore
+	 * not safe for concurrent use from multiple threads.
+	 *
+	 * Example:
+	 * \snippet test_frame.cpp DoxyExample01
+	 */
+	class FrameTree
+	{
+	public:
+
+		//! Identifier for frames within the tree
+		using FrameId = std::size_t;
+
+		//! Identifier value indicating no (or an invalid) frame.
+		static constexpr FrameId sNullId
+			{ std::numeric_limits<FrameId>::max() };
+
+		//! Maximum number of frame pairs with cached relative transform.
+		static constexpr std::size_t sMaxRelatives{ 4096u };
+
+	private:
+
+		//! Per-frame data and cached world transform
+		struct Node
+		{
+			FrameId theParentId{ sNullId };
+			std::size_t theDepth{ 0u };
+			Transform theLocal{ null<Transform>() };
+			SpinorTransform theLocalSpin{ null<SpinorTransform>() };
+			std::size_t theStamp{ 0u }; //!< update count at last change
+			std::vector<FrameId> theChildIds{};
+			mutable bool theWorldDirty{ true };
+			mutable SpinorTransform theWorldSpin{ null<SpinorTransform>() };
+			mutable Transform theWorld{ null<Transform>() };
+		};
+
+		//! Cached relative transform and newest stamp used to compute it
+		struct Relative
+		{
+			std::size_t theStamp{ 0u };
+			Transform theXfm{ null<Transform>() };
+		};
+
+		std::vector<Node> theNodes{};
+		std::size_t theUpdateCount{ 0u };
+		mutable std::map<std::pair<FrameId, FrameId>, Relative> theRelatives{};
+
+		/*! Mark frame and all its descendants as needing world update.
+		 *
+		 * Clean frames always have clean ancestors (updates proceed
+		 * top down). Therefore a dirty frame implies an entirely
+		 * dirty subtree and traversal can stop there.
+		 */
+		inline
+		void
+		invalidate
+			( FrameId const & id
+			)
+		{
+			std::vector<FrameId> todo{ id };
+			while (! todo.empty())
+			{
+				FrameId const curr{ todo.back() };
+				todo.pop_back();
+				Node const & node = theNodes[curr];
+				if (! node.theWorldDirty)
+				{
+					node.theWorldDirty = true;
+					todo.insert
+						( todo.end()
+						, node.theChildIds.cbegin(), node.theChildIds.cend()
+						);
+				}
+			}
+		}
+
+		//! Cached world transform (updating dirty chain as needed)
+		inline
+		Node const &
+		worldNode
+			( FrameId const & id
+			) const
+		{
+			// find chain of dirty frames up to first clean ancestor
+			std::vector<FrameId> chain;
+			FrameId curr{ id };
+			while ((sNullId != curr) && theNodes[curr].theWorldDirty)
+			{
+				chain.emplace_back(curr);
+				curr = theNodes[curr].theParentId;
+			}
+			// recompute top down
+			for (std::size_t nn{chain.size()} ; 0u < nn ; --nn)
+			{
+				Node const & node = theNodes[chain[nn - 1u]];
+				if (sNullId == node.theParentId)
+				{
+					node.theWorldSpin = node.theLocalSpin;
+				}
+				else
+				{
+					Node const & parent = theNodes[node.theParentId];
+					node.theWorldSpin = node.theLocalSpin * parent.theWorldSpin;
+				}
+				node.theWorld = node.theWorldSpin.transform();
+				node.theWorldDirty = false;
+			}
+			return theNodes[id];
+		}
+
+		//! Lowest common ancestor of two frames
+		inline
+		FrameId
+		lowestCommonAncestor
+			( FrameId idA
+			, FrameId idB
+			) const
+		{
+			while (theNodes[idA].theDepth < theNodes[idB].theDepth)
+			{
+				idB = theNodes[idB].theParentId;
+			}
+			while (theNodes[idB].theDepth < theNodes[idA].theDepth)
+			{
+				idA = theNodes[idA].theParentId;
+			}
+			while (idA != idB)
+			{
+				idA = theNodes[idA].theParentId;
+				idB = theNodes[idB].theParentId;
+			}
+			return idA;
+		}
+
+		//! Newest change stamp for frames from id up to (excluding) ancId
+		inline
+		std::size_t
+		newestStamp
+			( FrameId id
+			, FrameId const & ancId
+			) const
+		{
+			std::size_t stamp{ 0u };
+			while (id != ancId)
+			{
+				stamp = std::max(stamp, theNodes[id].theStamp);
+				id = theNodes[id].theParentId;
+			}
+			return stamp;
+		}
+
+		//! Transform of frame id wrt ancestor frame ancId
+		inline
+		SpinorTransform
+		wrtAncestor
+			( FrameId id
+			, FrameId const & ancId
+			) const
+		{
+			SpinorTransform xfm{ identity<SpinorTransform>() };
+			while (id != ancId)
+			{
+				Node const & node = theNodes[id];
+				xfm = xfm * node.theLocalSpin;
+				id = node.theParentId;
+			}
+			return xfm;
+		}
+
+	public:
+
+		//! Construct with a root frame (id = rootId()).
+		inline
+		explicit
+		FrameTree
+			()
+		{
+			Node root;
+			root.theLocal = identity<Transform>();
+			root.theLocalSpin = identity<SpinorTransform>();
+			theNodes.emplace_back(root);
+		}
+
+		//! Identifier of the root frame
+		inline
+		static
+		constexpr
+		FrameId
+		rootId
+			()
+		{
+			return 0u;
+		}
+
+		//! Number of frames (including root)
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theNodes.size();
+		}
+
+		//! True if id is a frame in this tree
+		inline
+		bool
+		isValid
+			( FrameId const & id
+			) const
+		{
+			return (id < theNodes.size());
+		}
+
+		/*! Add frame attached to parent with transform xFrameWrtParent.
+		 *
+		 * Returns identifier of new frame, or sNullId if parentId
+		 * is not valid.
+		 */
+		inline
+		FrameId
+		addFrame
+			( FrameId const & parentId
+			, Transform const & xFrameWrtParent
+			)
+		{
+			FrameId id{ sNullId };
+			if (isValid(parentId))
+			{
+				id = theNodes.size();
+				Node node;
+				node.theParentId = parentId;
+				node.theDepth = theNodes[parentId].theDepth + 1u;
+				node.theLocal = xFrameWrtParent;
+				node.theLocalSpin = SpinorTransform::from(xFrameWrtParent);
+				node.theStamp = ++theUpdateCount;
+				theNodes.emplace_back(node);
+				theNodes[parentId].theChildIds.emplace_back(id);
+			}
+			return id;
+		}
+
+		/*! Change transform of frame wrt its parent.
+		 *
+		 * Invalidates cached world transforms within the subtree
+		 * starting at frame id. Returns false (and makes no change)
+		 * if id is not valid or is the root frame.
+		 */
+		inline
+		bool
+		setLocal
+			( FrameId const & id
+			, Transform const & xFrameWrtParent
+			)
+		{
+			bool okay{ false };
+			if (isValid(id) && (rootId() != id))
+			{
+				Node & node = theNodes[id];
+				node.theLocal = xFrameWrtParent;
+				node.theLocalSpin = SpinorTransform::from(xFrameWrtParent);
+				node.theStamp = ++theUpdateCount;
+				invalidate(id);
+				okay = true;
+			}
+			return okay;
+		}
+
+		//! Number of frame pairs with cached relative() transform.
+		inline
+		std::size_t
+		numCachedRelatives
+			() const
+		{
+			return theRelatives.size();
+		}
+
+		//! Transform of frame wrt its parent (null if id is not valid).
+		inline
+		Transform
+		local
+			( FrameId const & id
+			) const
+		{
+			Transform xfm{ null<Transform>() };
+			if (isValid(id))
+			{
+				xfm = theNodes[id].theLocal;
+			}
+			return xfm;
+		}
+
+		//! Parent of frame (sNullId for root or if id is not valid).
+		inline
+		FrameId
+		parent
+			( FrameId const & id
+			) const
+		{
+			FrameId parentId{ sNullId };
+			if (isValid(id))
+			{
+				parentId = theNodes[id].theParentId;
+			}
+			return parentId;
+		}
+
+		//! Transform of frame wrt root (null if id is not valid).
+		inline
+		Transform
+		world
+			( FrameId const & id
+			) const
+		{
+			Transform xfm{ null<Transform>() };
+			if (isValid(id))
+			{
+				xfm = worldNode(id).theWorld;
+			}
+			return xfm;
+		}
+
+		/*! Transform of frame idB with respect to frame idA.
+		 *
+		 * I.e. the returned transform, xBwA, maps vectors expressed
+		 * in frame A into their expression in frame B. Composition
+		 * is through the lowest common ancestor (LCA), L, as:
+		 * \arg xBwA = xBwL * inverse(xAwL)
+		 *
+		 * Returns null if either id is not valid.
+		 */
+		inline
+		Transform
+		relative
+			( FrameId const & idA
+			, FrameId const & idB
+			) const
+		{
+			Transform xfm{ null<Transform>() };
+			if (isValid(idA) && isValid(idB))
+			{
+				FrameId const idL{ lowestCommonAncestor(idA, idB) };
+				std::size_t const stamp
+					{ std::max(newestStamp(idA, idL), newestStamp(idB, idL)) };
+				std::pair<FrameId, FrameId> const key{ idA, idB };
+				if ( (! (theRelatives.size() < sMaxRelatives))
+				  && (theRelatives.end() == theRelatives.find(key))
+				   )
+				{
+					theRelatives.clear(); // bound memory use
+				}
+				Relative & rel = theRelatives[key];
+				if ((0u == rel.theStamp) || (rel.theStamp < stamp))
+				{
+					SpinorTransform const xAwL{ wrtAncestor(idA, idL) };
+					SpinorTransform const xBwL{ wrtAncestor(idB, idL) };
+					rel.theXfm = (xBwL * inverse(xAwL)).transform();
+					rel.theStamp = std::max(stamp, std::size_t{ 1u });
+				}
+				xfm = rel.theXfm;
+			}
+			return xfm;
+		}
+
+	}; // FrameTree
+
+} // [rigibra]
+
+
+#endif // Rigibra_frame_INCL_
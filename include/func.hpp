@@ -35,34 +35,56 @@ Example:
 */
 
 
+#include "fast.hpp"
 #include "type.hpp"
 
+#include <cstddef>
+#include <vector>
+
 
 namespace rigibra
 {
 
 	//! Inverse Attitude (such that return*fwd = identity)
-	inline
+	constexpr
 	Attitude
 	inverse
 		( Attitude const & fwd
 		)
 	{
-		using namespace engabra::g3;
-		SpinAngle const fwdSpinAngle{ fwd.spinAngle() };
-		SpinAngle const invSpinAngle{ -fwdSpinAngle.theBiv };
+		Rigibra_INSTRUMENT_COUNT(Inverse);
+		engabra::g3::BiVector const & fwdBiv = fwd.spinAngle().theBiv;
+		SpinAngle const invSpinAngle
+			{ engabra::g3::BiVector{ -fwdBiv[0], -fwdBiv[1], -fwdBiv[2] } };
 		return Attitude(invSpinAngle);
 	}
 
-	//! Inverse Transformation (such that return*fwd = identity)
-	inline
+	/*! Inverse Transformation (such that return*fwd = identity)
+	 *
+	 * Transforms with zero spin angle (pure translations, including
+	 * identity<Transform>()) are inverted without evaluating the
+	 * attitude and may therefore be inverted in constant expressions.
+	 * This gives the same (bitwise) result as the general case since
+	 * spinExp() of a zero bivector is exactly {1,0,0,0}.
+	 */
+	constexpr
 	Transform
 	inverse
 		( Transform const & fwd
 		)
 	{
-		Attitude const invAtt{ inverse(fwd.theAtt) };
-		Location const invLoc{ -fwd.theAtt(fwd.theLoc) };
+		Rigibra_INSTRUMENT_COUNT(Inverse);
+		engabra::g3::BiVector const & fwdBiv = fwd.theAtt.spinAngle().theBiv;
+		Attitude const invAtt
+			{ SpinAngle
+				{ engabra::g3::BiVector{ -fwdBiv[0], -fwdBiv[1], -fwdBiv[2] } }
+			};
+		Location rotLoc{ fwd.theLoc };
+		if (! ((0. == fwdBiv[0]) && (0. == fwdBiv[1]) && (0. == fwdBiv[2])))
+		{
+			rotLoc = fwd.theAtt(fwd.theLoc);
+		}
+		Location const invLoc{ -rotLoc[0], -rotLoc[1], -rotLoc[2] };
 		return Transform{ invLoc, invAtt };
 	}
 
@@ -77,9 +99,41 @@ namespace rigibra
 	//	Attitude const & attA = attAwX;
 	//	Attitude const & attB = attBwA;
 	//	return Attitude{ attB * attA };
+		Rigibra_INSTRUMENT_SCOPE(Compose);
 		return Attitude(attBwA.spinor() * attAwX.spinor());
 	}
 
+	/*! Composition as operator*(Transform, Transform) without validity tests.
+	 *
+	 * For use in tight loops over data that are (mostly) known to be
+	 * valid. Null inputs are not detected explicitly; instead, the
+	 * (NaN) null values propagate through the arithmetic (per IEEE-754)
+	 * such that a null input produces a result with NaN components
+	 * (i.e. for which isValid() is false).
+	 */
+	inline
+	Transform
+	composeUnchecked
+		( Transform const & xBwA //!< e.g. xfm frameB wrt frameA
+		, Transform const & xAwX //!< e.g. xfm frameA wrt frameRef
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE(Compose);
+		using namespace engabra::g3;
+		// evaluate each spinor once (for both attitude and location)
+		Spinor const spinAwX{ xAwX.theAtt.spinor() };
+		Spinor const spinBwA{ xBwA.theAtt.spinor() };
+		Attitude const attBwX(spinBwA * spinAwX);
+		//
+		// inverse of attAwX applied to bLoc
+		Location const & aLoc = xAwX.theLoc;
+		Location const & bLoc = xBwA.theLoc;
+		Location const locBinX
+			{ aLoc + (reverse(spinAwX) * bLoc * spinAwX).theVec };
+		//
+		return Transform{ locBinX, attBwX };
+	}
+
 	/*! Composition Transformations result is xBwRef(pnt) = xBwA(xAwRef(pnt)).
 	 *
 	 * Ref theory/Transforms.lyx document for math details. Overall, the
@@ -102,20 +156,441 @@ namespace rigibra
 		Transform xfm{ null<Transform>() };
 		if (isValid(xBwA) && isValid(xAwX))
 		{
-			Attitude const & attAwX = xAwX.theAtt;
-			Attitude const & attBwA = xBwA.theAtt;
-			Attitude const attBwX{ attBwA * attAwX };
-			//
-			Attitude const invA{ inverse(xAwX.theAtt) };
-			Location const & aLoc = xAwX.theLoc;
-			Location const & bLoc = xBwA.theLoc;
-			Location const locBinX{ aLoc + invA(bLoc) };
-			//
-			xfm = Transform{ locBinX, attBwX };
+			xfm = composeUnchecked(xBwA, xAwX);
 		}
 		return xfm;
 	}
 
+//
+// Spinor representations
+//
+
+	//! Inverse SpinorAttitude (such that return*fwd = identity)
+	constexpr
+	SpinorAttitude
+	inverse
+		( SpinorAttitude const & fwd
+		)
+	{
+		// reverse of the spinor
+		engabra::g3::Spinor const & spin = fwd.spinor();
+		return SpinorAttitude(engabra::g3::Spinor
+			{ spin.theSca[0], -spin.theBiv[0], -spin.theBiv[1], -spin.theBiv[2] });
+	}
+
+	//! Inverse SpinorTransform (such that return*fwd = identity)
+	constexpr
+	SpinorTransform
+	inverse
+		( SpinorTransform const & fwd
+		)
+	{
+		SpinorAttitude const invAtt{ inverse(fwd.theAtt) };
+		Location const rotLoc{ fwd.theAtt(fwd.theLoc) };
+		Location const invLoc{ -rotLoc[0], -rotLoc[1], -rotLoc[2] };
+		return SpinorTransform{ invLoc, invAtt };
+	}
+
+	/*! Composition of two SpinorAttitudes: attBwX = attBwA * attAwX.
+	 *
+	 * Requires only a spinor product (no exponential or logarithm).
+	 * With spinors expressed as scalar and bivector parts, (a+A)
+	 * and (b+B), and bivectors as duals of vectors, A=I*u and B=I*v,
+	 * the product is (a*b - u.v) + I*(a*v + b*u - u x v).
+	 */
+	constexpr
+	SpinorAttitude
+	operator*
+		( SpinorAttitude const & attBwA
+		, SpinorAttitude const & attAwX
+		)
+	{
+		engabra::g3::Spinor const & spinA = attBwA.spinor();
+		engabra::g3::Spinor const & spinB = attAwX.spinor();
+		double const & aa = spinA.theSca[0];
+		double const & u0 = spinA.theBiv[0];
+		double const & u1 = spinA.theBiv[1];
+		double const & u2 = spinA.theBiv[2];
+		double const & bb = spinB.theSca[0];
+		double const & v0 = spinB.theBiv[0];
+		double const & v1 = spinB.theBiv[1];
+		double const & v2 = spinB.theBiv[2];
+		return SpinorAttitude(engabra::g3::Spinor
+			{ aa*bb - (u0*v0 + u1*v1 + u2*v2)
+			, aa*v0 + bb*u0 - (u1*v2 - u2*v1)
+			, aa*v1 + bb*u1 - (u2*v0 - u0*v2)
+			, aa*v2 + bb*u2 - (u0*v1 - u1*v0)
+			});
+	}
+
+	/*! Composition as operator*(SpinorTransform, SpinorTransform) unchecked.
+	 *
+	 * Polynomial operations only and no validity tests or branches.
+	 * Null (NaN) inputs propagate into a null result (per IEEE-754).
+	 */
+	constexpr
+	SpinorTransform
+	composeUnchecked
+		( SpinorTransform const & xBwA //!< e.g. xfm frameB wrt frameA
+		, SpinorTransform const & xAwX //!< e.g. xfm frameA wrt frameRef
+		)
+	{
+		SpinorAttitude const attBwX{ xBwA.theAtt * xAwX.theAtt };
+		Location const & aLoc = xAwX.theLoc;
+		Location const bLocInX{ inverse(xAwX.theAtt)(xBwA.theLoc) };
+		Location const locBinX
+			{ aLoc[0] + bLocInX[0]
+			, aLoc[1] + bLocInX[1]
+			, aLoc[2] + bLocInX[2]
+			};
+		return SpinorTransform{ locBinX, attBwX };
+	}
+
+	/*! Composition of SpinorTransforms: xBwX(pnt) = xBwA(xAwX(pnt)).
+	 *
+	 * Same as operator*(Transform, Transform), but requiring only
+	 * polynomial operations. Null inputs produce a null result.
+	 *
+	 * May be used in constant expressions, e.g. to compose fixed
+	 * (compile-time) sensor mounting transforms.
+	 * \snippet test_func.cpp DoxyExampleConstexpr
+	 */
+	constexpr
+	SpinorTransform
+	operator*
+		( SpinorTransform const & xBwA //!< e.g. xfm frameB wrt frameA
+		, SpinorTransform const & xAwX //!< e.g. xfm frameA wrt frameRef
+		)
+	{
+		SpinorTransform xfm{ null<SpinorTransform>() };
+		if (isValid(xBwA) && isValid(xAwX))
+		{
+			xfm = composeUnchecked(xBwA, xAwX);
+		}
+		return xfm;
+	}
+
+	/*! Pairwise composition, xBwXs[nn] = xBwAs[nn] * xAwXs[nn], unchecked.
+	 *
+	 * Uses composeUnchecked() such that the loop body is free of
+	 * validity branches (null inputs produce null outputs via NaN
+	 * propagation). The xBwXs array may be the same as either input.
+	 */
+	inline
+	void
+	composeUnchecked
+		( SpinorTransform const * const xBwAs
+		, SpinorTransform const * const xAwXs
+		, std::size_t const & numXfms
+		, SpinorTransform * const xBwXs
+		)
+	{
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			xBwXs[nn] = composeUnchecked(xBwAs[nn], xAwXs[nn]);
+		}
+	}
+
+//
+// Batch application
+//
+
+	/*! Transform numPnts vectors from pntsIn into pntsOut (AoS layout).
+	 *
+	 * Spinor evaluation is performed once for the entire batch. Each
+	 * output is the same as xfm(pntsIn[nn]) (within roundoff). The
+	 * pntsOut array may be the same as the pntsIn array (in-place).
+	 *
+	 * There are no validity tests (and no branches) in the loop. A null
+	 * xfm or a null input point produces null (NaN) output values.
+	 *
+	 * Example:
+	 * \snippet test_func.cpp DoxyExampleBatch
+	 */
+	inline
+	void
+	apply
+		( Transform const & xfm
+		, engabra::g3::Vector const * const pntsIn
+		, std::size_t const & numPnts
+		, engabra::g3::Vector * const pntsOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numPnts);
+		FastTransform const fastXfm(xfm);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			pntsOut[nn] = fastXfm(pntsIn[nn]);
+		}
+	}
+
+	//! Transformed copy of each vector in pntsIn (AoS layout)
+	inline
+	std::vector<engabra::g3::Vector>
+	apply
+		( Transform const & xfm
+		, std::vector<engabra::g3::Vector> const & pntsIn
+		)
+	{
+		std::vector<engabra::g3::Vector> pntsOut(pntsIn.size());
+		apply(xfm, pntsIn.data(), pntsIn.size(), pntsOut.data());
+		return pntsOut;
+	}
+
+	/*! Transform numPnts points with separate x,y,z arrays (SoA layout).
+	 *
+	 * Point nn is {xIn[nn], yIn[nn], zIn[nn]} and its transformed
+	 * result is stored into {xOut[nn], yOut[nn], zOut[nn]}. Output
+	 * arrays may be the same as input arrays (in-place operation).
+	 *
+	 * The loop body is simple scalar arithmetic on contiguous data
+	 * (with the rotation held in local values) so that it can be
+	 * auto-vectorized by the compiler.
+	 */
+	inline
+	void
+	apply
+		( Transform const & xfm
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numPnts);
+		FastTransform const fastXfm(xfm);
+		std::array<double, 9u> const & mat = fastXfm.theAtt.matrix();
+		double const m00{ mat[0] }, m01{ mat[1] }, m02{ mat[2] };
+		double const m10{ mat[3] }, m11{ mat[4] }, m12{ mat[5] };
+		double const m20{ mat[6] }, m21{ mat[7] }, m22{ mat[8] };
+		double const t0{ fastXfm.theLoc[0] };
+		double const t1{ fastXfm.theLoc[1] };
+		double const t2{ fastXfm.theLoc[2] };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			double const d0{ xIn[nn] - t0 };
+			double const d1{ yIn[nn] - t1 };
+			double const d2{ zIn[nn] - t2 };
+			xOut[nn] = m00*d0 + m01*d1 + m02*d2;
+			yOut[nn] = m10*d0 + m11*d1 + m12*d2;
+			zOut[nn] = m20*d0 + m21*d1 + m22*d2;
+		}
+	}
+
+//
+// Batch rotation (attitude only - no translation)
+//
+
+	/*! Rotate numVecs (direction) vectors, vecsOut[nn] = att(vecsIn[nn]).
+	 *
+	 * For quantities that are not translated by a Transform (e.g.
+	 * surface normals, ray directions, velocities) apply xfm.theAtt.
+	 * The rotation matrix is evaluated once for the entire batch.
+	 * The vecsOut array may be the same as vecsIn (in-place).
+	 *
+	 * Example:
+	 * \snippet test_func.cpp DoxyExampleRotate
+	 */
+	inline
+	void
+	rotate
+		( Attitude const & att
+		, engabra::g3::Vector const * const vecsIn
+		, std::size_t const & numVecs
+		, engabra::g3::Vector * const vecsOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numVecs);
+		FastAttitude const fastAtt(att);
+		for (std::size_t nn{0u} ; nn < numVecs ; ++nn)
+		{
+			vecsOut[nn] = fastAtt(vecsIn[nn]);
+		}
+	}
+
+	/*! Rotate numBivs bivectors (e.g. plane orientations, angular rates).
+	 *
+	 * A bivector is the dual of a vector (e23, e31, e12 components
+	 * correspond to e1, e2, e3 respectively) and the dual commutes
+	 * with spinor sandwich products. Bivector components therefore
+	 * rotate with the same matrix as vector components.
+	 */
+	inline
+	void
+	rotate
+		( Attitude const & att
+		, engabra::g3::BiVector const * const bivsIn
+		, std::size_t const & numBivs
+		, engabra::g3::BiVector * const bivsOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numBivs);
+		FastAttitude const fastAtt(att);
+		std::array<double, 9u> const & mat = fastAtt.matrix();
+		for (std::size_t nn{0u} ; nn < numBivs ; ++nn)
+		{
+			engabra::g3::BiVector const & biv = bivsIn[nn];
+			bivsOut[nn] = engabra::g3::BiVector
+				{ mat[0]*biv[0] + mat[1]*biv[1] + mat[2]*biv[2]
+				, mat[3]*biv[0] + mat[4]*biv[1] + mat[5]*biv[2]
+				, mat[6]*biv[0] + mat[7]*biv[1] + mat[8]*biv[2]
+				};
+		}
+	}
+
+	//! Rotated copy of each vector in vecsIn (AoS layout)
+	inline
+	std::vector<engabra::g3::Vector>
+	rotate
+		( Attitude const & att
+		, std::vector<engabra::g3::Vector> const & vecsIn
+		)
+	{
+		std::vector<engabra::g3::Vector> vecsOut(vecsIn.size());
+		rotate(att, vecsIn.data(), vecsIn.size(), vecsOut.data());
+		return vecsOut;
+	}
+
+	//! Rotated copy of each bivector in bivsIn
+	inline
+	std::vector<engabra::g3::BiVector>
+	rotate
+		( Attitude const & att
+		, std::vector<engabra::g3::BiVector> const & bivsIn
+		)
+	{
+		std::vector<engabra::g3::BiVector> bivsOut(bivsIn.size());
+		rotate(att, bivsIn.data(), bivsIn.size(), bivsOut.data());
+		return bivsOut;
+	}
+
+	/*! Rotate numVecs vectors with separate x,y,z arrays (SoA layout).
+	 *
+	 * Same as apply() for SoA data but without location subtraction.
+	 * Also suitable for bivector components (e23, e31, e12 arrays).
+	 * Output arrays may be the same as input arrays (in-place).
+	 */
+	inline
+	void
+	rotate
+		( Attitude const & att
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numVecs
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numVecs);
+		FastAttitude const fastAtt(att);
+		std::array<double, 9u> const & mat = fastAtt.matrix();
+		double const m00{ mat[0] }, m01{ mat[1] }, m02{ mat[2] };
+		double const m10{ mat[3] }, m11{ mat[4] }, m12{ mat[5] };
+		double const m20{ mat[6] }, m21{ mat[7] }, m22{ mat[8] };
+		for (std::size_t nn{0u} ; nn < numVecs ; ++nn)
+		{
+			double const d0{ xIn[nn] };
+			double const d1{ yIn[nn] };
+			double const d2{ zIn[nn] };
+			xOut[nn] = m00*d0 + m01*d1 + m02*d2;
+			yOut[nn] = m10*d0 + m11*d1 + m12*d2;
+			zOut[nn] = m20*d0 + m21*d1 + m22*d2;
+		}
+	}
+
+//
+// Sequence composition
+//
+
+	/*! Cumulative composition of a sequence of transforms (serial).
+	 *
+	 * For increments xfmsIn[nn] of frame (nn) with respect to frame
+	 * (nn-1), the result xfmsOut[nn] is the transform of frame (nn)
+	 * with respect to frame (-1) (i.e. with respect to the domain of
+	 * xfmsIn[0]). I.e. xfmsOut[0] = xfmsIn[0] and otherwise
+	 * \arg xfmsOut[nn] = xfmsIn[nn] * xfmsOut[nn-1]
+	 *
+	 * Composition is performed with SpinorTransform values such that
+	 * only one exponential and one logarithm is evaluated per item.
+	 * The xfmsOut array may be the same as xfmsIn (in-place). A null
+	 * increment produces null values for all subsequent outputs.
+	 *
+	 * Multi-threaded version is in parallel.hpp
+	 */
+	inline
+	void
+	inclusiveScan
+		( Transform const * const xfmsIn
+		, std::size_t const & numXfms
+		, Transform * const xfmsOut
+		)
+	{
+		SpinorTransform xAccum{ identity<SpinorTransform>() };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			xAccum = SpinorTransform::from(xfmsIn[nn]) * xAccum;
+			xfmsOut[nn] = xAccum.transform();
+		}
+	}
+
+	//! Cumulative composition of SpinorTransform sequence (serial).
+	inline
+	void
+	inclusiveScan
+		( SpinorTransform const * const xfmsIn
+		, std::size_t const & numXfms
+		, SpinorTransform * const xfmsOut
+		)
+	{
+		SpinorTransform xAccum{ identity<SpinorTransform>() };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			xAccum = xfmsIn[nn] * xAccum;
+			xfmsOut[nn] = xAccum;
+		}
+	}
+
+	/*! Composition of entire sequence (last value from inclusiveScan()).
+	 *
+	 * I.e. xfmsIn[numXfms-1] * ... * xfmsIn[1] * xfmsIn[0]. Returns
+	 * identity for an empty sequence.
+	 */
+	inline
+	SpinorTransform
+	reduce
+		( SpinorTransform const * const xfmsIn
+		, std::size_t const & numXfms
+		)
+	{
+		SpinorTransform xAccum{ identity<SpinorTransform>() };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			xAccum = xfmsIn[nn] * xAccum;
+		}
+		return xAccum;
+	}
+
+	//! Composition of entire sequence (ref reduce(SpinorTransform...)).
+	inline
+	Transform
+	reduce
+		( Transform const * const xfmsIn
+		, std::size_t const & numXfms
+		)
+	{
+		SpinorTransform xAccum{ identity<SpinorTransform>() };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			xAccum = SpinorTransform::from(xfmsIn[nn]) * xAccum;
+		}
+		return xAccum.transform();
+	}
+
 } // [rigibra]
 
 
@@ -0,0 +1,382 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_instrument_INCL_
+#define Rigibra_instrument_INCL_
+
+/*! \file
+\brief Contains optional (compile-time enabled) hot path instrumentation.
+
+Instrumentation is compiled in only if the preprocessor symbol
+Rigibra_INSTRUMENT is defined (e.g. by configuring CMake with option
+-DRigibra_ENABLE_INSTRUMENT=ON). Otherwise, the instrumentation
+macros expand to nothing and there is no run time cost. The snapshot
+API is always available (and reports zeros if not enabled).
+
+Example:
+\snippet test_instrument.cpp DoxyExample01
+
+*/
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+namespace rigibra
+{
+
+/*! \brief Per-thread operation counters and timers.
+ *
+ * Each thread accumulates into its own (thread local) counters
+ * without locks. A snapshot() sums the counters from all live
+ * threads along with those from threads that have exited.
+ *
+ * Only the functions noted for each Op are instrumented. Others,
+ * notably SpinorAttitude/SpinorTransform operations (including
+ * their batch composeUnchecked()) and the mean.hpp functions, are
+ * neither counted nor timed.
+ */
+namespace instrument
+{
+	//! Instrumented operations.
+	enum class Op : std::size_t
+	{
+		  SpinExp = 0u //!< Attitude::spinor(), Trajectory interpolation
+		, SpinLog //!< SpinAngle::from(), Trajectory insertion
+		, Compose //!< Attitude or Transform operator*, composeUnchecked()
+		, Inverse //!< inverse() of Attitude or Transform (count only)
+		, BatchElement //!< Points/elements of batch apply/rotate functions
+		, NumOps //!< Number of items in this enum (not an operation)
+	};
+
+	//! Number of instrumented operations
+	constexpr std::size_t sNumOps{ static_cast<std::size_t>(Op::NumOps) };
+
+	//! True if instrumentation has been compiled into this build.
+	constexpr
+	bool
+	isEnabled
+		()
+	{
+#		if defined(Rigibra_INSTRUMENT)
+		return true;
+#		else
+		return false;
+#		endif
+	}
+
+	//! Name associated with operation
+	inline
+	std::string
+	nameFor
+		( Op const & op
+		)
+	{
+		static std::array<std::string, sNumOps> const sNames
+			{ "SpinExp"
+			, "SpinLog"
+			, "Compose"
+			, "Inverse"
+			, "BatchElement"
+			};
+		std::string name("Unknown");
+		std::size_t const ndx{ static_cast<std::size_t>(op) };
+		if (ndx < sNumOps)
+		{
+			name = sNames[ndx];
+		}
+		return name;
+	}
+
+	//! Counts and cumulative times (at some point in time).
+	struct Snapshot
+	{
+		//! Number of calls (or number of elements for BatchElement)
+		std::array<std::uint64_t, sNumOps> theCounts{};
+
+		//! Cumulative time [nanoseconds] spent in each operation
+		std::array<std::uint64_t, sNumOps> theNanos{};
+
+		//! Number of operations performed
+		inline
+		std::uint64_t
+		count
+			( Op const & op
+			) const
+		{
+			return theCounts[static_cast<std::size_t>(op)];
+		}
+
+		/*! Cumulative time [seconds] spent in operation.
+		 *
+		 * Times are inclusive: e.g. Compose time includes that of
+		 * the SpinExp/SpinLog operations it performs (which are also
+		 * recorded under their own Op). Inverse time is not recorded
+		 * (only its count) since inverse() may be constexpr.
+		 *
+		 * BatchElement includes the func.hpp apply() and rotate()
+		 * batch functions, simd::apply(), the parallel.hpp apply()
+		 * functions, the matrix.hpp and precision.hpp apply()
+		 * functions, and TransformBlock inverse() and composition.
+		 */
+		inline
+		double
+		seconds
+			( Op const & op
+			) const
+		{
+			return 1.e-9 * static_cast<double>
+				(theNanos[static_cast<std::size_t>(op)]);
+		}
+
+	}; // Snapshot
+
+	//! Activity between two snapshots (e.g. snapAfter - snapBefore).
+	inline
+	Snapshot
+	operator-
+		( Snapshot const & snapEnd
+		, Snapshot const & snapBeg
+		)
+	{
+		Snapshot delta;
+		for (std::size_t nn{0u} ; nn < sNumOps ; ++nn)
+		{
+			delta.theCounts[nn] = snapEnd.theCounts[nn] - snapBeg.theCounts[nn];
+			delta.theNanos[nn] = snapEnd.theNanos[nn] - snapBeg.theNanos[nn];
+		}
+		return delta;
+	}
+
+	//! Counters for the current thread (written only by owning thread).
+	class ThreadCounters
+	{
+		std::array<std::atomic<std::uint64_t>, sNumOps> theCounts{};
+		std::array<std::atomic<std::uint64_t>, sNumOps> theNanos{};
+
+	public:
+
+		//! Register with global collection (for snapshot()).
+		ThreadCounters
+			();
+
+		//! Add current values into global collection and unregister.
+		~ThreadCounters
+			();
+
+		ThreadCounters(ThreadCounters const &) = delete;
+		ThreadCounters & operator=(ThreadCounters const &) = delete;
+
+		/*! Accumulate count and elapsed time (nanoseconds) for op.
+		 *
+		 * Only the owning thread writes values. Relaxed load/store
+		 * (instead of read-modify-write) is sufficient and allows
+		 * other threads to read (approximately current) values.
+		 */
+		inline
+		void
+		add
+			( Op const & op
+			, std::uint64_t const & count
+			, std::uint64_t const & nanos
+			)
+		{
+			std::size_t const ndx{ static_cast<std::size_t>(op) };
+			std::atomic<std::uint64_t> & cnt = theCounts[ndx];
+			std::atomic<std::uint64_t> & tim = theNanos[ndx];
+			cnt.store
+				( cnt.load(std::memory_order_relaxed) + count
+				, std::memory_order_relaxed
+				);
+			tim.store
+				( tim.load(std::memory_order_relaxed) + nanos
+				, std::memory_order_relaxed
+				);
+		}
+
+		//! Current values
+		inline
+		Snapshot
+		snapshot
+			() const
+		{
+			Snapshot snap;
+			for (std::size_t nn{0u} ; nn < sNumOps ; ++nn)
+			{
+				snap.theCounts[nn] = theCounts[nn].load(std::memory_order_relaxed);
+				snap.theNanos[nn] = theNanos[nn].load(std::memory_order_relaxed);
+			}
+			return snap;
+		}
+
+	}; // ThreadCounters
+
+	//! Counters for the calling thread
+	inline
+	ThreadCounters &
+	threadCounters
+		()
+	{
+		thread_local ThreadCounters tCounters;
+		return tCounters;
+	}
+
+	//! Activity (so far) of the calling thread only.
+	inline
+	Snapshot
+	threadSnapshot
+		()
+	{
+		return threadCounters().snapshot();
+	}
+
+	//! Activity (so far) of all threads (including those that have exited).
+	Snapshot
+	snapshot
+		();
+
+	//! Accumulate count (without time) for op in calling thread.
+	inline
+	void
+	addCount
+		( Op const & op
+		, std::uint64_t const & count = 1u
+		)
+	{
+		threadCounters().add(op, count, 0u);
+	}
+
+	//! Count one op (or numElem ops) and time spent during scope lifetime.
+	class ScopedTimer
+	{
+		using Clock = std::chrono::steady_clock;
+
+		Op const theOp;
+		std::uint64_t const theCount;
+		Clock::time_point const theBeg;
+
+	public:
+
+		//! Start timer
+		inline
+		explicit
+		ScopedTimer
+			( Op const & op
+			, std::uint64_t const & count = 1u
+			)
+			: theOp{ op }
+			, theCount{ count }
+			, theBeg{ Clock::now() }
+		{ }
+
+		//! Accumulate elapsed time into calling thread counters
+		inline
+		~ScopedTimer
+			()
+		{
+			std::chrono::nanoseconds const elapsed{ Clock::now() - theBeg };
+			threadCounters().add
+				( theOp
+				, theCount
+				, static_cast<std::uint64_t>(elapsed.count())
+				);
+		}
+
+		ScopedTimer(ScopedTimer const &) = delete;
+		ScopedTimer & operator=(ScopedTimer const &) = delete;
+
+	}; // ScopedTimer
+
+} // [instrument]
+
+} // [rigibra]
+
+
+namespace
+{
+	//! Put snapshot values to stream (one line per operation)
+	inline
+	std::ostream &
+	operator<<
+		( std::ostream & ostrm
+		, rigibra::instrument::Snapshot const & snap
+		)
+	{
+		using namespace rigibra::instrument;
+		for (std::size_t nn{0u} ; nn < sNumOps ; ++nn)
+		{
+			Op const op{ static_cast<Op>(nn) };
+			ostrm
+				<< nameFor(op)
+				<< " count: " << snap.count(op)
+				<< " seconds: " << snap.seconds(op)
+				<< '\n';
+		}
+		return ostrm;
+	}
+
+} // [anon]
+
+
+#if defined(Rigibra_INSTRUMENT)
+
+	//! Count and time (remainder of) enclosing scope as operation op.
+#	define Rigibra_INSTRUMENT_SCOPE(op) \
+		::rigibra::instrument::ScopedTimer const rigibraInstrumentTimer_ \
+			(::rigibra::instrument::Op::op)
+
+	//! Count numElem and time (remainder of) enclosing scope as op.
+#	define Rigibra_INSTRUMENT_SCOPE_N(op, numElem) \
+		::rigibra::instrument::ScopedTimer const rigibraInstrumentTimer_ \
+			(::rigibra::instrument::Op::op, numElem)
+
+	//! Count (no time) op - usable within constexpr functions.
+#	define Rigibra_INSTRUMENT_COUNT(op) \
+		do \
+		{ \
+			if (! __builtin_is_constant_evaluated()) \
+			{ \
+				::rigibra::instrument::addCount \
+					(::rigibra::instrument::Op::op); \
+			} \
+		} while (0)
+
+#else
+
+#	define Rigibra_INSTRUMENT_SCOPE(op)
+#	define Rigibra_INSTRUMENT_SCOPE_N(op, numElem)
+#	define Rigibra_INSTRUMENT_COUNT(op)
+
+#endif
+
+
+#endif // Rigibra_instrument_INCL_
@@ -0,0 +1,374 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_io_INCL_
+#define Rigibra_io_INCL_
+
+/*! \file
+\brief Contains binary file storage for arrays of Transform and Attitude.
+
+Example:
+\snippet test_io.cpp DoxyExample01
+
+*/
+
+
+#include "type.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace rigibra
+{
+
+/*! \brief Binary (fixed record) file storage of rigibra types.
+ *
+ * Files contain a fixed size header followed by an array of fixed
+ * size records. Records are plain data such that a memory mapped
+ * file may be used directly (ref MappedFile) without parsing.
+ */
+namespace binio
+{
+	/*! \brief Kinds of records that may be stored in a binary file.
+	 *
+	 * Values are stored in files - do not renumber.
+	 */
+	enum class RecordKind : std::uint32_t
+	{
+		  Unknown = 0u
+		, Transform = 1u //!< TransformRecord
+		, Attitude = 2u //!< AttitudeRecord
+	};
+
+	//! Fixed size (on-disk) record for a Transform.
+	struct TransformRecord
+	{
+		//! Location components (e1, e2, e3)
+		double theLoc[3];
+
+		//! SpinAngle bivector components (e23, e31, e12)
+		double theSpinAngle[3];
+	};
+
+	//! Fixed size (on-disk) record for an Attitude.
+	struct AttitudeRecord
+	{
+		//! SpinAngle bivector components (e23, e31, e12)
+		double theSpinAngle[3];
+	};
+
+	/*! \brief Leading (fixed size) block of a binary file.
+	 *
+	 * File layout is:
+	 * \arg FileHeader (64 bytes)
+	 * \arg theNumRecords records each of theRecordSize bytes
+	 *
+	 * Records are stored in the byte order of the writing machine.
+	 * Files written on a machine with a different byte order (as
+	 * indicated by theEndianMark) are rejected by the reader.
+	 */
+	struct FileHeader
+	{
+		//! File identification: "Rigibra" with trailing null.
+		char theMagic[8];
+
+		//! Value sEndianMark as stored by writing machine.
+		std::uint32_t theEndianMark;
+
+		//! Format version (sFormatVersion when written)
+		std::uint32_t theVersion;
+
+		//! Kind of records that follow the header.
+		RecordKind theRecordKind;
+
+		//! Size of each record in bytes.
+		std::uint32_t theRecordSize;
+
+		//! Number of records that follow the header.
+		std::uint64_t theNumRecords;
+
+		//! FNV-1a (64 bit) checksum of all record bytes.
+		std::uint64_t theChecksum;
+
+		//! Padding such that records are 64 byte aligned in mapped file.
+		std::uint8_t theReserved[24];
+	};
+
+	static_assert(64u == sizeof(FileHeader), "Unexpected FileHeader size");
+	static_assert(48u == sizeof(TransformRecord), "Unexpected record size");
+	static_assert(24u == sizeof(AttitudeRecord), "Unexpected record size");
+
+	//! Current format version written into FileHeader::theVersion
+	constexpr std::uint32_t sFormatVersion{ 1u };
+
+	//! Value written in FileHeader::theEndianMark
+	constexpr std::uint32_t sEndianMark{ 0x01020304u };
+
+	//! FNV-1a (64 bit) hash of numBytes (continuing from prior hash).
+	inline
+	std::uint64_t
+	checksumFor
+		( void const * const data
+		, std::size_t const & numBytes
+		, std::uint64_t const & hash = 0xcbf29ce484222325u
+		)
+	{
+		std::uint64_t sum{ hash };
+		unsigned char const * const bytes
+			{ static_cast<unsigned char const *>(data) };
+		for (std::size_t nn{0u} ; nn < numBytes ; ++nn)
+		{
+			sum = (sum ^ bytes[nn]) * 0x00000100000001b3u;
+		}
+		return sum;
+	}
+
+	//! Record with values from xfm.
+	inline
+	TransformRecord
+	recordFor
+		( Transform const & xfm
+		)
+	{
+		engabra::g3::BiVector const & biv = xfm.theAtt.spinAngle().theBiv;
+		return TransformRecord
+			{ { xfm.theLoc[0], xfm.theLoc[1], xfm.theLoc[2] }
+			, { biv[0], biv[1], biv[2] }
+			};
+	}
+
+	//! Record with values from att.
+	inline
+	AttitudeRecord
+	recordFor
+		( Attitude const & att
+		)
+	{
+		engabra::g3::BiVector const & biv = att.spinAngle().theBiv;
+		return AttitudeRecord{ { biv[0], biv[1], biv[2] } };
+	}
+
+	//! Transform with values from record.
+	inline
+	Transform
+	transformFrom
+		( TransformRecord const & rec
+		)
+	{
+		return Transform
+			{ Location{ rec.theLoc[0], rec.theLoc[1], rec.theLoc[2] }
+			, Attitude(SpinAngle{ engabra::g3::BiVector
+				{ rec.theSpinAngle[0], rec.theSpinAngle[1], rec.theSpinAngle[2] }
+				})
+			};
+	}
+
+	//! Attitude with values from record.
+	inline
+	Attitude
+	attitudeFrom
+		( AttitudeRecord const & rec
+		)
+	{
+		return Attitude(SpinAngle{ engabra::g3::BiVector
+			{ rec.theSpinAngle[0], rec.theSpinAngle[1], rec.theSpinAngle[2] }
+			});
+	}
+
+	/*! Write numXfms transforms to a (new) binary file at path.
+	 *
+	 * Returns false if the file could not be (completely) written.
+	 *
+	 * Example:
+	 * \snippet test_io.cpp DoxyExample01
+	 */
+	bool
+	writeBinary
+		( std::string const & path
+		, Transform const * const xfms
+		, std::size_t const & numXfms
+		);
+
+	//! Write numAtts attitudes to a (new) binary file at path.
+	bool
+	writeBinary
+		( std::string const & path
+		, Attitude const * const atts
+		, std::size_t const & numAtts
+		);
+
+	/*! \brief Read-only memory mapped binary file (zero-copy access).
+	 *
+	 * The file is mapped into memory at construction and records
+	 * are accessed in place (without copying or parsing) through
+	 * the transformRecords() or attitudeRecords() pointers. The
+	 * mapping is released when the instance is destroyed.
+	 *
+	 * An instance is not valid if the file cannot be mapped, if
+	 * the header is not consistent with the file (e.g. magic,
+	 * version, byte order or size), or (if requested) the checksum
+	 * does not match. By default, only the header is checked such
+	 * that construction does not touch the (record) pages. Verifying
+	 * the checksum reads the entire file and is performed only when
+	 * requested (at construction or by hasValidChecksum()).
+	 *
+	 * Memory mapping is available on POSIX systems. Elsewhere,
+	 * instances are never valid.
+	 *
+	 * Example:
+	 * \snippet test_io.cpp DoxyExample01
+	 */
+	class MappedFile
+	{
+		//! Start of mapped memory (or nullptr)
+		void * theData{ nullptr };
+
+		//! Number of bytes mapped (file size)
+		std::size_t theNumBytes{ 0u };
+
+		//! True if file contents are consistent
+		bool theIsValid{ false };
+
+		//! Release mapping (if any)
+		void
+		close
+			();
+
+	public:
+
+		//! Map file at path (and check its checksum if verifyChecksum).
+		explicit
+		MappedFile
+			( std::string const & path
+			, bool const & verifyChecksum = false
+			);
+
+		//! Transfer ownership of mapping
+		MappedFile
+			( MappedFile && orig
+			) noexcept;
+
+		//! Transfer ownership of mapping
+		MappedFile &
+		operator=
+			( MappedFile && orig
+			) noexcept;
+
+		// Non-copyable (owns mapping)
+		MappedFile(MappedFile const &) = delete;
+		MappedFile & operator=(MappedFile const &) = delete;
+
+		//! Unmap file
+		~MappedFile
+			();
+
+		//! True if file is mapped and consistent with its header.
+		inline
+		bool
+		isValid
+			() const
+		{
+			return theIsValid;
+		}
+
+		/*! True if valid and record bytes match header checksum.
+		 *
+		 * Reads every byte of the mapped file (e.g. for integrity
+		 * checks that are not start-up time critical).
+		 */
+		bool
+		hasValidChecksum
+			() const;
+
+		//! Header at start of file (nullptr if not valid)
+		inline
+		FileHeader const *
+		header
+			() const
+		{
+			FileHeader const * ptHeader{ nullptr };
+			if (theIsValid)
+			{
+				ptHeader = static_cast<FileHeader const *>(theData);
+			}
+			return ptHeader;
+		}
+
+		//! Number of records in file (zero if not valid)
+		inline
+		std::size_t
+		size
+			() const
+		{
+			std::size_t numRecs{ 0u };
+			if (theIsValid)
+			{
+				numRecs = static_cast<std::size_t>(header()->theNumRecords);
+			}
+			return numRecs;
+		}
+
+		//! Pointer to size() records (nullptr unless Transform records)
+		inline
+		TransformRecord const *
+		transformRecords
+			() const
+		{
+			TransformRecord const * ptRecs{ nullptr };
+			if (theIsValid
+				&& (RecordKind::Transform == header()->theRecordKind))
+			{
+				ptRecs = reinterpret_cast<TransformRecord const *>
+					(static_cast<char const *>(theData) + sizeof(FileHeader));
+			}
+			return ptRecs;
+		}
+
+		//! Pointer to size() records (nullptr unless Attitude records)
+		inline
+		AttitudeRecord const *
+		attitudeRecords
+			() const
+		{
+			AttitudeRecord const * ptRecs{ nullptr };
+			if (theIsValid
+				&& (RecordKind::Attitude == header()->theRecordKind))
+			{
+				ptRecs = reinterpret_cast<AttitudeRecord const *>
+					(static_cast<char const *>(theData) + sizeof(FileHeader));
+			}
+			return ptRecs;
+		}
+
+	}; // MappedFile
+
+} // [binio]
+} // [rigibra]
+
+
+#endif // Rigibra_io_INCL_
@@ -0,0 +1,389 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_jacobian_INCL_
+#define Rigibra_jacobian_INCL_
+
+/*! \file
+\brief Contains analytic Jacobians of Transform operations.
+
+Parameters are those stored by Transform: the location, theLoc, and
+the spin angle, theAtt.spinAngle().theBiv (components e23,e31,e12).
+The parameter order is (loc[0],loc[1],loc[2], spin[0],spin[1],spin[2]).
+
+Jacobians are stored row-major with one row per result component and
+one column per parameter.
+
+Example:
+\snippet test_jacobian.cpp DoxyExample01
+
+*/
+
+
+#include "fast.hpp"
+#include "func.hpp"
+#include "linalg.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+
+
+namespace rigibra
+{
+
+	//! Jacobian of point (3 rows) w.r.t. one Transform (6 columns)
+	using Jacobian3x6 = std::array<double, 18u>;
+
+	//! Jacobian of Transform (6 rows) w.r.t. one Transform (6 columns)
+	using Jacobian6x6 = std::array<double, 36u>;
+
+	//! Jacobian of Transform (6 rows) w.r.t. two Transforms (12 columns)
+	using Jacobian6x12 = std::array<double, 72u>;
+
+	/*! Left Jacobian of SO(3) for rotation associated with spinAngle.
+	 *
+	 * The rotation matrix of Attitude(spinAngle) is exp(skew(omega))
+	 * with rotation vector omega = -2*spinAngle (in order e23,e31,e12).
+	 * The left Jacobian, Jl, relates a change in omega to the equivalent
+	 * (small) rotation applied on the left, i.e.
+	 * \arg exp(skew(omega+dw)) ~= exp(skew(Jl*dw)) * exp(skew(omega))
+	 */
+	inline
+	linalg::Matrix3
+	leftJacobian
+		( SpinAngle const & spinAngle
+		)
+	{
+		engabra::g3::BiVector const & biv = spinAngle.theBiv;
+		linalg::Vector3 const omega{ -2.*biv[0], -2.*biv[1], -2.*biv[2] };
+		double const thetaSq
+			{ omega[0]*omega[0] + omega[1]*omega[1] + omega[2]*omega[2] };
+		double const theta{ std::sqrt(thetaSq) };
+		// Jl = I + ca*skew(omega) + cb*skew(omega)^2
+		double ca{ .5 - thetaSq / 24. };
+		if (0. < theta)
+		{
+			double const sinHalf{ std::sin(.5 * theta) };
+			ca = 2. * sinHalf * sinHalf / thetaSq;
+		}
+		double cb{ (1./6.) - thetaSq * ((1./120.) - thetaSq / 5040.) };
+		if (! (theta < .1)) // series (above) avoids cancellation
+		{
+			cb = (theta - std::sin(theta)) / (thetaSq * theta);
+		}
+		linalg::Matrix3 const skw{ linalg::skew(omega) };
+		linalg::Matrix3 const skwSq{ linalg::product(skw, skw) };
+		linalg::Matrix3 jac{};
+		for (std::size_t kk{0u} ; kk < 9u ; ++kk)
+		{
+			jac[kk] = ca * skw[kk] + cb * skwSq[kk];
+		}
+		jac[0] += 1.;
+		jac[4] += 1.;
+		jac[8] += 1.;
+		return jac;
+	}
+
+	/*! Inverse of leftJacobian() (closed form).
+	 *
+	 * Singular for physical rotation angles that are (nonzero) multiples
+	 * of a full turn (i.e. for spin angle magnitudes of pi).
+	 */
+	inline
+	linalg::Matrix3
+	leftJacobianInverse
+		( SpinAngle const & spinAngle
+		)
+	{
+		engabra::g3::BiVector const & biv = spinAngle.theBiv;
+		linalg::Vector3 const omega{ -2.*biv[0], -2.*biv[1], -2.*biv[2] };
+		double const thetaSq
+			{ omega[0]*omega[0] + omega[1]*omega[1] + omega[2]*omega[2] };
+		double const theta{ std::sqrt(thetaSq) };
+		// Jl^-1 = I - skew(omega)/2 + cc*skew(omega)^2
+		double cc{ (1./12.) + thetaSq * ((1./720.) + thetaSq / 30240.) };
+		if (! (theta < .1))
+		{
+			double const cotHalf
+				{ std::cos(.5 * theta) / std::sin(.5 * theta) };
+			cc = (1. / thetaSq) - cotHalf / (2. * theta);
+		}
+		linalg::Matrix3 const skw{ linalg::skew(omega) };
+		linalg::Matrix3 const skwSq{ linalg::product(skw, skw) };
+		linalg::Matrix3 jac{};
+		for (std::size_t kk{0u} ; kk < 9u ; ++kk)
+		{
+			jac[kk] = -.5 * skw[kk] + cc * skwSq[kk];
+		}
+		jac[0] += 1.;
+		jac[4] += 1.;
+		jac[8] += 1.;
+		return jac;
+	}
+
+	//! Copy 3x3 block into row-major matrix (with numCols) at (row0,col0)
+	inline
+	void
+	setJacobianBlock
+		( double * const & mat
+		, std::size_t const & numCols
+		, std::size_t const & row0
+		, std::size_t const & col0
+		, linalg::Matrix3 const & block
+		)
+	{
+		for (std::size_t row{0u} ; row < 3u ; ++row)
+		{
+			double * const rowPtr{ mat + (row0 + row)*numCols + col0 };
+			rowPtr[0] = block[3u*row     ];
+			rowPtr[1] = block[3u*row + 1u];
+			rowPtr[2] = block[3u*row + 2u];
+		}
+	}
+
+	/*! Jacobians of xfm(pnts[nn]) w.r.t. xfm parameters (batch form).
+	 *
+	 * For y = xfm(x) = R*(x - loc) the Jacobian (3x6) is
+	 * \arg dy/dloc = -R
+	 * \arg dy/dspin = 2*skew(y)*Jl (ref leftJacobian())
+	 *
+	 * The rotation and Jl are evaluated once for all points. Each
+	 * Jacobian is written to jacs[18*nn + ...] (row-major 3x6 blocks).
+	 * If ptYs is not null, ptYs[nn] is set to xfm(pnts[nn]). Note that
+	 * the Jacobian w.r.t. the point, dy/dx, is R (i.e. -dy/dloc).
+	 */
+	inline
+	void
+	jacobianApply
+		( Transform const & xfm
+		, engabra::g3::Vector const * const pnts
+		, std::size_t const & numPnts
+		, double * const jacs
+		, engabra::g3::Vector * const ptYs = nullptr
+		)
+	{
+		constexpr std::size_t stride{ std::tuple_size<Jacobian3x6>::value };
+		FastTransform const fastXfm(xfm);
+		std::array<double, 9u> const & rot = fastXfm.theAtt.matrix();
+		linalg::Matrix3 jl2{ leftJacobian(xfm.theAtt.spinAngle()) };
+		for (double & elem : jl2)
+		{
+			elem *= 2.;
+		}
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			engabra::g3::Vector const yy{ fastXfm(pnts[nn]) };
+			double * const jac{ jacs + stride*nn };
+			// dy/dloc = -R
+			for (std::size_t row{0u} ; row < 3u ; ++row)
+			{
+				jac[6u*row     ] = -rot[3u*row     ];
+				jac[6u*row + 1u] = -rot[3u*row + 1u];
+				jac[6u*row + 2u] = -rot[3u*row + 2u];
+			}
+			// dy/dspin = skew(y) * (2*Jl)
+			linalg::Matrix3 const dyds
+				{ linalg::product
+					(linalg::skew(linalg::Vector3{ yy[0], yy[1], yy[2] }), jl2)
+				};
+			setJacobianBlock(jac, 6u, 0u, 3u, dyds);
+			if (ptYs)
+			{
+				ptYs[nn] = yy;
+			}
+		}
+	}
+
+	//! Jacobian of xfm(pnt) w.r.t. xfm parameters (ref batch form).
+	inline
+	Jacobian3x6
+	jacobianApply
+		( Transform const & xfm
+		, engabra::g3::Vector const & pnt
+		)
+	{
+		Jacobian3x6 jac;
+		jacobianApply(xfm, &pnt, 1u, jac.data());
+		return jac;
+	}
+
+	/*! Jacobian of xBwX = xBwA * xAwX w.r.t. parameters of both inputs.
+	 *
+	 * Rows are the result parameters (loc, spin). Columns 0-5 are
+	 * parameters of xBwA (first argument) and columns 6-11 are those of
+	 * xAwX (second argument). With rotations Rb, Ra and the result
+	 * loc = locA + Ra^T*locB, the nonzero blocks are
+	 * \arg dloc/dlocB = Ra^T
+	 * \arg dloc/dlocA = I
+	 * \arg dloc/dspinA = -2*Ra^T*skew(locB)*Jl(spinA)
+	 * \arg dspin/dspinB = Jl(spin)^-1 * Jl(spinB)
+	 * \arg dspin/dspinA = Jl(spin)^-1 * Rb * Jl(spinA)
+	 *
+	 * where spin is the result spin angle (as evaluated by operator*()).
+	 */
+	inline
+	Jacobian6x12
+	jacobianCompose
+		( Transform const & xBwA
+		, Transform const & xAwX
+		)
+	{
+		using namespace engabra::g3;
+		Jacobian6x12 jac{};
+		constexpr std::size_t numCols{ 12u };
+		Transform const xBwX{ composeUnchecked(xBwA, xAwX) };
+		linalg::Matrix3 const rotB{ FastAttitude(xBwA.theAtt).matrix() };
+		linalg::Matrix3 const rotAT
+			{ linalg::transpose(FastAttitude(xAwX.theAtt).matrix()) };
+		linalg::Matrix3 const jlB{ leftJacobian(xBwA.theAtt.spinAngle()) };
+		linalg::Matrix3 const jlA{ leftJacobian(xAwX.theAtt.spinAngle()) };
+		linalg::Matrix3 const jlInvX
+			{ leftJacobianInverse(xBwX.theAtt.spinAngle()) };
+		Location const & locB = xBwA.theLoc;
+
+		// location rows
+		setJacobianBlock(jac.data(), numCols, 0u, 0u, rotAT);
+		setJacobianBlock
+			( jac.data(), numCols, 0u, 6u
+			, linalg::Matrix3{ 1., 0., 0.,  0., 1., 0.,  0., 0., 1. }
+			);
+		linalg::Matrix3 const skewB
+			{ linalg::skew(linalg::Vector3{ locB[0], locB[1], locB[2] }) };
+		linalg::Matrix3 dlds
+			{ linalg::product(linalg::product(rotAT, skewB), jlA) };
+		for (double & elem : dlds)
+		{
+			elem *= -2.;
+		}
+		setJacobianBlock(jac.data(), numCols, 0u, 9u, dlds);
+
+		// spin angle rows
+		setJacobianBlock
+			(jac.data(), numCols, 3u, 3u, linalg::product(jlInvX, jlB));
+		setJacobianBlock
+			( jac.data(), numCols, 3u, 9u
+			, linalg::product(jlInvX, linalg::product(rotB, jlA))
+			);
+		return jac;
+	}
+
+	/*! Jacobians of xBwAs[nn] * xAwXs[nn] (batch form).
+	 *
+	 * Each Jacobian (ref jacobianCompose()) is written to
+	 * jacs[72*nn + ...] (row-major 6x12 blocks).
+	 */
+	inline
+	void
+	jacobianCompose
+		( Transform const * const xBwAs
+		, Transform const * const xAwXs
+		, std::size_t const & numXfms
+		, double * const jacs
+		)
+	{
+		constexpr std::size_t stride{ std::tuple_size<Jacobian6x12>::value };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			Jacobian6x12 const jac{ jacobianCompose(xBwAs[nn], xAwXs[nn]) };
+			std::copy(jac.cbegin(), jac.cend(), jacs + stride*nn);
+		}
+	}
+
+	/*! Jacobian of inverse(xfm) w.r.t. parameters of xfm.
+	 *
+	 * With rotation R and result location, invLoc = -R*loc, the
+	 * nonzero blocks are
+	 * \arg dinvLoc/dloc = -R
+	 * \arg dinvLoc/dspin = 2*skew(invLoc)*Jl(spin)
+	 * \arg dinvSpin/dspin = -I
+	 */
+	inline
+	Jacobian6x6
+	jacobianInverse
+		( Transform const & xfm
+		)
+	{
+		Jacobian6x6 jac{};
+		constexpr std::size_t numCols{ 6u };
+		linalg::Matrix3 const rot{ FastAttitude(xfm.theAtt).matrix() };
+		linalg::Vector3 const invLoc
+			{ linalg::product
+				( rot
+				, linalg::Vector3
+					{ -xfm.theLoc[0], -xfm.theLoc[1], -xfm.theLoc[2] }
+				)
+			};
+		linalg::Matrix3 negRot{ rot };
+		for (double & elem : negRot)
+		{
+			elem = -elem;
+		}
+		setJacobianBlock(jac.data(), numCols, 0u, 0u, negRot);
+		linalg::Matrix3 dlds
+			{ linalg::product
+				(linalg::skew(invLoc), leftJacobian(xfm.theAtt.spinAngle()))
+			};
+		for (double & elem : dlds)
+		{
+			elem *= 2.;
+		}
+		setJacobianBlock(jac.data(), numCols, 0u, 3u, dlds);
+		setJacobianBlock
+			( jac.data(), numCols, 3u, 3u
+			, linalg::Matrix3{ -1., 0., 0.,  0., -1., 0.,  0., 0., -1. }
+			);
+		return jac;
+	}
+
+	/*! Jacobians of inverse(xfms[nn]) (batch form).
+	 *
+	 * Each Jacobian (ref jacobianInverse()) is written to
+	 * jacs[36*nn + ...] (row-major 6x6 blocks).
+	 */
+	inline
+	void
+	jacobianInverse
+		( Transform const * const xfms
+		, std::size_t const & numXfms
+		, double * const jacs
+		)
+	{
+		constexpr std::size_t stride{ std::tuple_size<Jacobian6x6>::value };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			Jacobian6x6 const jac{ jacobianInverse(xfms[nn]) };
+			std::copy(jac.cbegin(), jac.cend(), jacs + stride*nn);
+		}
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_jacobian_INCL_
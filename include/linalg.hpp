@@ -0,0 +1,272 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_linalg_INCL_
+#define Rigibra_linalg_INCL_
+
+/*! \file
+\brief Contains small (fixed size) linear algebra utilities.
+
+Example:
+\snippet test_linalg.cpp DoxyExample01
+
+*/
+
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+
+namespace rigibra
+{
+
+/*! \brief Fixed size linear algebra support for estimation functions.
+ *
+ * E.g. eigen decomposition of 4x4 symmetric matrices such as those
+ * arising in quaternion (spinor) averaging and in absolute
+ * orientation solutions.
+ */
+namespace linalg
+{
+	//! 4x4 matrix elements (row-major): element (row,col) at [4*row+col]
+	using Matrix4 = std::array<double, 16u>;
+
+	//! 4-component vector
+	using Vector4 = std::array<double, 4u>;
+
+	//! 3x3 matrix elements (row-major): element (row,col) at [3*row+col]
+	using Matrix3 = std::array<double, 9u>;
+
+	//! 3-component vector
+	using Vector3 = std::array<double, 3u>;
+
+	//! Eigen values and (unit) eigen vectors sorted by decreasing value.
+	struct EigenSystem4
+	{
+		//! Eigen values: theValues[0] >= theValues[1] >= ...
+		Vector4 theValues{};
+
+		//! Unit eigen vectors: theVectors[k] associated with theValues[k]
+		std::array<Vector4, 4u> theVectors{};
+
+		//! Number of Jacobi sweeps performed (for diagnostic use).
+		std::size_t theNumSweeps{ 0u };
+
+	}; // EigenSystem4
+
+	/*! Eigen decomposition of symmetric matrix (by cyclic Jacobi method).
+	 *
+	 * Only the upper triangle of symMat is used. The Jacobi method is
+	 * robust for repeated (or nearly repeated) eigen values and yields
+	 * eigen vectors orthogonal to working precision. Iteration stops
+	 * when off-diagonal elements are negligible (relative to the
+	 * matrix norm) or after maxSweeps sweeps.
+	 *
+	 * Example:
+	 * \snippet test_linalg.cpp DoxyExample01
+	 */
+	inline
+	EigenSystem4
+	eigenSymmetric
+		( Matrix4 const & symMat
+		, std::size_t const & maxSweeps = 32u
+		)
+	{
+		// working copy (symmetric from upper triangle) and rotations
+		std::array<Vector4, 4u> aa{};
+		std::array<Vector4, 4u> vv{};
+		double normSq{ 0. };
+		for (std::size_t row{0u} ; row < 4u ; ++row)
+		{
+			for (std::size_t col{0u} ; col < 4u ; ++col)
+			{
+				std::size_t const ndx
+					{ (row <= col) ? (4u*row + col) : (4u*col + row) };
+				aa[row][col] = symMat[ndx];
+				normSq += aa[row][col] * aa[row][col];
+			}
+			vv[row][row] = 1.;
+		}
+		double const epsSq{ 1.e-32 * normSq };
+
+		EigenSystem4 eig;
+		for (std::size_t sweep{0u} ; sweep < maxSweeps ; ++sweep)
+		{
+			double offSq{ 0. };
+			for (std::size_t pp{0u} ; pp < 3u ; ++pp)
+			{
+				for (std::size_t qq{pp + 1u} ; qq < 4u ; ++qq)
+				{
+					offSq += aa[pp][qq] * aa[pp][qq];
+				}
+			}
+			if (! (epsSq < offSq)) // also terminates for NaN
+			{
+				break;
+			}
+			++eig.theNumSweeps;
+
+			for (std::size_t pp{0u} ; pp < 3u ; ++pp)
+			{
+				for (std::size_t qq{pp + 1u} ; qq < 4u ; ++qq)
+				{
+					double const apq{ aa[pp][qq] };
+					if (0. == apq)
+					{
+						continue;
+					}
+					// rotation angle that zeros element (pp,qq)
+					double const theta{ (aa[qq][qq] - aa[pp][pp]) / (2.*apq) };
+					double const tt
+						{ std::copysign(1., theta)
+						/ (std::abs(theta) + std::sqrt(theta*theta + 1.))
+						};
+					double const cc{ 1. / std::sqrt(tt*tt + 1.) };
+					double const ss{ tt * cc };
+					// A <- A*J (columns) then A <- J^T*A (rows)
+					for (std::size_t kk{0u} ; kk < 4u ; ++kk)
+					{
+						double const akp{ aa[kk][pp] };
+						double const akq{ aa[kk][qq] };
+						aa[kk][pp] = cc*akp - ss*akq;
+						aa[kk][qq] = ss*akp + cc*akq;
+					}
+					for (std::size_t kk{0u} ; kk < 4u ; ++kk)
+					{
+						double const apk{ aa[pp][kk] };
+						double const aqk{ aa[qq][kk] };
+						aa[pp][kk] = cc*apk - ss*aqk;
+						aa[qq][kk] = ss*apk + cc*aqk;
+					}
+					// V <- V*J (eigen vectors are columns of V)
+					for (std::size_t kk{0u} ; kk < 4u ; ++kk)
+					{
+						double const vkp{ vv[kk][pp] };
+						double const vkq{ vv[kk][qq] };
+						vv[kk][pp] = cc*vkp - ss*vkq;
+						vv[kk][qq] = ss*vkp + cc*vkq;
+					}
+				}
+			}
+		}
+
+		// sort by decreasing eigen value
+		std::array<std::size_t, 4u> order{ 0u, 1u, 2u, 3u };
+		for (std::size_t ii{1u} ; ii < 4u ; ++ii)
+		{
+			for (std::size_t jj{ii} ; (0u < jj) ; --jj)
+			{
+				if (aa[order[jj-1u]][order[jj-1u]] < aa[order[jj]][order[jj]])
+				{
+					std::swap(order[jj-1u], order[jj]);
+				}
+			}
+		}
+		for (std::size_t kk{0u} ; kk < 4u ; ++kk)
+		{
+			std::size_t const col{ order[kk] };
+			eig.theValues[kk] = aa[col][col];
+			for (std::size_t row{0u} ; row < 4u ; ++row)
+			{
+				eig.theVectors[kk][row] = vv[row][col];
+			}
+		}
+		return eig;
+	}
+
+	//! Skew symmetric (cross product) matrix: skew(aa)*bb = aa x bb
+	constexpr
+	Matrix3
+	skew
+		( Vector3 const & aa
+		)
+	{
+		return Matrix3
+			{    0.  , -aa[2],  aa[1]
+			,  aa[2],    0.  , -aa[0]
+			, -aa[1],  aa[0],    0.
+			};
+	}
+
+	//! Transpose of matrix
+	constexpr
+	Matrix3
+	transpose
+		( Matrix3 const & mat
+		)
+	{
+		return Matrix3
+			{ mat[0], mat[3], mat[6]
+			, mat[1], mat[4], mat[7]
+			, mat[2], mat[5], mat[8]
+			};
+	}
+
+	//! Matrix product matA*matB
+	inline
+	Matrix3
+	product
+		( Matrix3 const & matA
+		, Matrix3 const & matB
+		)
+	{
+		Matrix3 prod{};
+		for (std::size_t row{0u} ; row < 3u ; ++row)
+		{
+			for (std::size_t col{0u} ; col < 3u ; ++col)
+			{
+				prod[3u*row + col] =
+					  matA[3u*row     ] * matB[     col]
+					+ matA[3u*row + 1u] * matB[3u + col]
+					+ matA[3u*row + 2u] * matB[6u + col];
+			}
+		}
+		return prod;
+	}
+
+	//! Matrix vector product mat*vec
+	constexpr
+	Vector3
+	product
+		( Matrix3 const & mat
+		, Vector3 const & vec
+		)
+	{
+		return Vector3
+			{ mat[0]*vec[0] + mat[1]*vec[1] + mat[2]*vec[2]
+			, mat[3]*vec[0] + mat[4]*vec[1] + mat[5]*vec[2]
+			, mat[6]*vec[0] + mat[7]*vec[1] + mat[8]*vec[2]
+			};
+	}
+
+} // [linalg]
+
+} // [rigibra]
+
+
+#endif // Rigibra_linalg_INCL_
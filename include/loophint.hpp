@@ -0,0 +1,52 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief (Internal) loop vectorization hint for library headers.
+
+Defines macro Rigibra_LOOP_HINT to precede loops whose iterations
+are independent but which access (many) arrays that compilers cannot
+prove do not overlap.
+
+Intentionally has no include guard: each library header that uses
+the macro includes this file (after its other includes) and then
+does "#undef Rigibra_LOOP_HINT" at its end, such that the macro
+does not leak into code including the library headers.
+
+*/
+
+
+#if ! defined(Rigibra_LOOP_HINT)
+#	if defined(__clang__)
+#		define Rigibra_LOOP_HINT \
+			_Pragma("clang loop vectorize(assume_safety)")
+#	elif defined(__GNUC__)
+#		define Rigibra_LOOP_HINT _Pragma("GCC ivdep")
+#	else
+#		define Rigibra_LOOP_HINT
+#	endif
+#endif
+
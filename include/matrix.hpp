@@ -0,0 +1,405 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_matrix_INCL_
+#define Rigibra_matrix_INCL_
+
+/*! \file
+\brief Contains conversions between rigibra types and matrix forms.
+
+Example:
+\snippet test_matrix.cpp DoxyExample01
+
+*/
+
+
+#include "fast.hpp"
+#include "type.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+
+namespace rigibra
+{
+
+	//! Storage order of matrix elements in a linear array.
+	enum class MatrixOrder
+	{
+		  RowMajor //!< Element (row,col) at [row*numCols + col]
+		, ColMajor //!< Element (row,col) at [col*numRows + row]
+	};
+
+	//! 3x3 rotation matrix elements
+	using Matrix3x3 = std::array<double, 9u>;
+
+	//! 3x4 (affine) matrix elements: [R | off]
+	using Matrix3x4 = std::array<double, 12u>;
+
+	//! 4x4 homogeneous matrix elements: [R | off] with last row [0 0 0 1]
+	using Matrix4x4 = std::array<double, 16u>;
+
+	/*! Rotation matrix, R, such that R*x is same as att(x).
+	 *
+	 * Example:
+	 * \snippet test_matrix.cpp DoxyExample01
+	 */
+	inline
+	Matrix3x3
+	rotationMatrix
+		( Attitude const & att
+		, MatrixOrder const & order = MatrixOrder::RowMajor
+		)
+	{
+		Matrix3x3 mat{ FastAttitude(att).matrix() };
+		if (MatrixOrder::ColMajor == order)
+		{
+			mat = Matrix3x3
+				{ mat[0], mat[3], mat[6]
+				, mat[1], mat[4], mat[7]
+				, mat[2], mat[5], mat[8]
+				};
+		}
+		return mat;
+	}
+
+	/*! Affine 3x4 matrix, [R | off], such that R*x + off is xfm(x).
+	 *
+	 * Since xfm(x) = R*(x - loc), the offset is off = -R*loc.
+	 */
+	inline
+	Matrix3x4
+	affineMatrix
+		( Transform const & xfm
+		, MatrixOrder const & order = MatrixOrder::RowMajor
+		)
+	{
+		Matrix3x3 const rot{ rotationMatrix(xfm.theAtt) };
+		Location const & loc = xfm.theLoc;
+		double const off0{ -(rot[0]*loc[0] + rot[1]*loc[1] + rot[2]*loc[2]) };
+		double const off1{ -(rot[3]*loc[0] + rot[4]*loc[1] + rot[5]*loc[2]) };
+		double const off2{ -(rot[6]*loc[0] + rot[7]*loc[1] + rot[8]*loc[2]) };
+		Matrix3x4 mat;
+		if (MatrixOrder::ColMajor == order)
+		{
+			mat = Matrix3x4
+				{ rot[0], rot[3], rot[6]
+				, rot[1], rot[4], rot[7]
+				, rot[2], rot[5], rot[8]
+				, off0, off1, off2
+				};
+		}
+		else
+		{
+			mat = Matrix3x4
+				{ rot[0], rot[1], rot[2], off0
+				, rot[3], rot[4], rot[5], off1
+				, rot[6], rot[7], rot[8], off2
+				};
+		}
+		return mat;
+	}
+
+	//! Homogeneous 4x4 matrix (affineMatrix() with row [0 0 0 1] added).
+	inline
+	Matrix4x4
+	homogeneousMatrix
+		( Transform const & xfm
+		, MatrixOrder const & order = MatrixOrder::RowMajor
+		)
+	{
+		Matrix3x4 const aff{ affineMatrix(xfm, MatrixOrder::RowMajor) };
+		Matrix4x4 mat;
+		if (MatrixOrder::ColMajor == order)
+		{
+			mat = Matrix4x4
+				{ aff[0], aff[4], aff[ 8], 0.
+				, aff[1], aff[5], aff[ 9], 0.
+				, aff[2], aff[6], aff[10], 0.
+				, aff[3], aff[7], aff[11], 1.
+				};
+		}
+		else
+		{
+			mat = Matrix4x4
+				{ aff[0], aff[1], aff[ 2], aff[ 3]
+				, aff[4], aff[5], aff[ 6], aff[ 7]
+				, aff[8], aff[9], aff[10], aff[11]
+				, 0., 0., 0., 1.
+				};
+		}
+		return mat;
+	}
+
+	/*! Unit spinor (with non-negative scalar) equivalent to rotation.
+	 *
+	 * Uses Shepperd's method: the spinor component of largest size
+	 * is computed from the largest of the trace and the diagonal
+	 * elements, and the remaining components are then obtained from
+	 * (sums or differences of) off diagonal elements with division
+	 * by that largest component. This is numerically stable for all
+	 * rotations (including those near a half turn).
+	 *
+	 * For input that is only approximately a rotation (e.g. roundoff
+	 * or slightly non-orthogonal data), the result is normalized.
+	 * Returns null if the matrix is not finite or if its determinant
+	 * is not positive (e.g. a reflection).
+	 */
+	inline
+	engabra::g3::Spinor
+	spinorFromRotation
+		( Matrix3x3 const & mat
+		, MatrixOrder const & order = MatrixOrder::RowMajor
+		)
+	{
+		using namespace engabra::g3;
+		Spinor spin{ null<Spinor>() };
+
+		// row-major element access
+		Matrix3x3 rr{ mat };
+		if (MatrixOrder::ColMajor == order)
+		{
+			rr = Matrix3x3
+				{ mat[0], mat[3], mat[6]
+				, mat[1], mat[4], mat[7]
+				, mat[2], mat[5], mat[8]
+				};
+		}
+
+		double const det
+			{ rr[0] * (rr[4]*rr[8] - rr[5]*rr[7])
+			- rr[1] * (rr[3]*rr[8] - rr[5]*rr[6])
+			+ rr[2] * (rr[3]*rr[7] - rr[4]*rr[6])
+			};
+		if (! (isFinite(det) && (0. < det)))
+		{
+			return spin;
+		}
+
+		double const trace{ rr[0] + rr[4] + rr[8] };
+		double ww{}, b0{}, b1{}, b2{};
+		if ((rr[0] < trace) && (rr[4] < trace) && (rr[8] < trace))
+		{
+			ww = .5 * std::sqrt(1. + trace);
+			double const scl{ .25 / ww };
+			b0 = scl * (rr[5] - rr[7]);
+			b1 = scl * (rr[6] - rr[2]);
+			b2 = scl * (rr[1] - rr[3]);
+		}
+		else
+		if ((rr[4] <= rr[0]) && (rr[8] <= rr[0]))
+		{
+			b0 = .5 * std::sqrt(1. + rr[0] - rr[4] - rr[8]);
+			double const scl{ .25 / b0 };
+			ww = scl * (rr[5] - rr[7]);
+			b1 = scl * (rr[1] + rr[3]);
+			b2 = scl * (rr[2] + rr[6]);
+		}
+		else
+		if (rr[8] <= rr[4])
+		{
+			b1 = .5 * std::sqrt(1. - rr[0] + rr[4] - rr[8]);
+			double const scl{ .25 / b1 };
+			ww = scl * (rr[6] - rr[2]);
+			b0 = scl * (rr[1] + rr[3]);
+			b2 = scl * (rr[5] + rr[7]);
+		}
+		else
+		{
+			b2 = .5 * std::sqrt(1. - rr[0] - rr[4] + rr[8]);
+			double const scl{ .25 / b2 };
+			ww = scl * (rr[1] - rr[3]);
+			b0 = scl * (rr[2] + rr[6]);
+			b1 = scl * (rr[5] + rr[7]);
+		}
+
+		// normalize (for approximate rotations) with ww non-negative
+		double const mag{ std::sqrt(ww*ww + b0*b0 + b1*b1 + b2*b2) };
+		double const scl{ (ww < 0.) ? (-1. / mag) : (1. / mag) };
+		spin = Spinor{ scl*ww, scl*b0, scl*b1, scl*b2 };
+		return spin;
+	}
+
+	//! Attitude equivalent to rotation matrix (ref spinorFromRotation()).
+	inline
+	Attitude
+	attitudeFromRotation
+		( Matrix3x3 const & mat
+		, MatrixOrder const & order = MatrixOrder::RowMajor
+		)
+	{
+		Attitude att{ null<Attitude>() };
+		engabra::g3::Spinor const spin{ spinorFromRotation(mat, order) };
+		if (engabra::g3::isValid(spin))
+		{
+			att = Attitude(spin);
+		}
+		return att;
+	}
+
+	//! Transform equivalent to affine matrix [R | off] (ref affineMatrix()).
+	inline
+	Transform
+	transformFromAffine
+		( Matrix3x4 const & mat
+		, MatrixOrder const & order = MatrixOrder::RowMajor
+		)
+	{
+		// row-major rotation and offset
+		Matrix3x3 rot;
+		std::array<double, 3u> off;
+		if (MatrixOrder::ColMajor == order)
+		{
+			rot = Matrix3x3
+				{ mat[0], mat[3], mat[6]
+				, mat[1], mat[4], mat[7]
+				, mat[2], mat[5], mat[8]
+				};
+			off = std::array<double, 3u>{ mat[9], mat[10], mat[11] };
+		}
+		else
+		{
+			rot = Matrix3x3
+				{ mat[0], mat[1], mat[ 2]
+				, mat[4], mat[5], mat[ 6]
+				, mat[8], mat[9], mat[10]
+				};
+			off = std::array<double, 3u>{ mat[3], mat[7], mat[11] };
+		}
+
+		Transform xfm{ null<Transform>() };
+		engabra::g3::Spinor const spin{ spinorFromRotation(rot) };
+		if (engabra::g3::isValid(spin))
+		{
+			// loc = -inverse(R)*off, with inverse(R) from (orthonormal)
+			// spinor rotation to be consistent with attitude
+			Matrix3x3 const rv{ FastAttitude(SpinorAttitude(spin)).matrix() };
+			Location const loc
+				{ -(rv[0]*off[0] + rv[3]*off[1] + rv[6]*off[2])
+				, -(rv[1]*off[0] + rv[4]*off[1] + rv[7]*off[2])
+				, -(rv[2]*off[0] + rv[5]*off[1] + rv[8]*off[2])
+				};
+			xfm = Transform{ loc, Attitude(spin) };
+		}
+		return xfm;
+	}
+
+	/*! Transform equivalent to homogeneous 4x4 matrix.
+	 *
+	 * The last row is assumed to be [0 0 0 1] (it is not used).
+	 */
+	inline
+	Transform
+	transformFromHomogeneous
+		( Matrix4x4 const & mat
+		, MatrixOrder const & order = MatrixOrder::RowMajor
+		)
+	{
+		Matrix3x4 aff;
+		if (MatrixOrder::ColMajor == order)
+		{
+			// first 12 column-major values are the 3x4 part w/o last row
+			aff = Matrix3x4
+				{ mat[ 0], mat[ 1], mat[ 2]
+				, mat[ 4], mat[ 5], mat[ 6]
+				, mat[ 8], mat[ 9], mat[10]
+				, mat[12], mat[13], mat[14]
+				};
+		}
+		else
+		{
+			aff = Matrix3x4
+				{ mat[0], mat[1], mat[ 2], mat[ 3]
+				, mat[4], mat[5], mat[ 6], mat[ 7]
+				, mat[8], mat[9], mat[10], mat[11]
+				};
+		}
+		return transformFromAffine(aff, order);
+	}
+
+	/*! Transform numPnts points (SoA layout) with affine (row-major) matrix.
+	 *
+	 * Computes out = R*in + off with mat = [R | off]. The result is
+	 * the same as apply(xfm, ...) in func.hpp for mat=affineMatrix(xfm)
+	 * but with the location subtraction folded into the offset (9
+	 * multiplies and 9 adds per point). Output arrays may be the same
+	 * as the input arrays (in-place operation).
+	 */
+	inline
+	void
+	apply
+		( Matrix3x4 const & mat
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numPnts);
+		double const m00{ mat[0] }, m01{ mat[1] }, m02{ mat[ 2] }, o0{ mat[ 3] };
+		double const m10{ mat[4] }, m11{ mat[5] }, m12{ mat[ 6] }, o1{ mat[ 7] };
+		double const m20{ mat[8] }, m21{ mat[9] }, m22{ mat[10] }, o2{ mat[11] };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			double const x0{ xIn[nn] };
+			double const x1{ yIn[nn] };
+			double const x2{ zIn[nn] };
+			xOut[nn] = m00*x0 + m01*x1 + m02*x2 + o0;
+			yOut[nn] = m10*x0 + m11*x1 + m12*x2 + o1;
+			zOut[nn] = m20*x0 + m21*x1 + m22*x2 + o2;
+		}
+	}
+
+	//! Transform numPnts points (AoS layout) with affine (row-major) matrix.
+	inline
+	void
+	apply
+		( Matrix3x4 const & mat
+		, engabra::g3::Vector const * const pntsIn
+		, std::size_t const & numPnts
+		, engabra::g3::Vector * const pntsOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			engabra::g3::Vector const & pnt = pntsIn[nn];
+			pntsOut[nn] = engabra::g3::Vector
+				{ mat[0]*pnt[0] + mat[1]*pnt[1] + mat[ 2]*pnt[2] + mat[ 3]
+				, mat[4]*pnt[0] + mat[5]*pnt[1] + mat[ 6]*pnt[2] + mat[ 7]
+				, mat[8]*pnt[0] + mat[9]*pnt[1] + mat[10]*pnt[2] + mat[11]
+				};
+		}
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_matrix_INCL_
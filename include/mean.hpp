@@ -0,0 +1,603 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_mean_INCL_
+#define Rigibra_mean_INCL_
+
+/*! \file
+\brief Contains averaging (mean rotation) of Attitudes and Transforms.
+
+Example:
+\snippet test_mean.cpp DoxyExample01
+
+*/
+
+
+#include "linalg.hpp"
+#include "pool.hpp"
+#include "spin.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+namespace rigibra
+{
+
+	/*! \brief Streaming accumulator for (weighted) mean attitude/location.
+	 *
+	 * Accumulates the (weighted) outer product moments, sum(w*q*q^T),
+	 * of unit spinors, q=(w,b0,b1,b2), along with (weighted) location
+	 * sums. Memory use is constant (independent of number of items).
+	 * Partial accumulators (e.g. from separate threads) are combined
+	 * with merge().
+	 *
+	 * The mean attitude is the unit spinor that maximizes q^T*M*q
+	 * (the principal eigen vector of moment matrix M). This is the
+	 * chordal L2 mean (minimizing the weighted sum of squared
+	 * Frobenius norms of rotation matrix differences). Since q*q^T
+	 * is the same for q and -q, the result is independent of spinor
+	 * sign and is well behaved for rotations near (and at) a half
+	 * turn.
+	 *
+	 * Example:
+	 * \snippet test_mean.cpp DoxyExample01
+	 */
+	class MeanAccumulator
+	{
+		//! Upper triangle of sum(w*q*q^T) in order 00,01,02,03,11,12,...
+		std::array<double, 10u> theMoments{};
+
+		//! Weighted sum of locations (if any)
+		std::array<double, 3u> theLocSum{};
+
+		//! Sum of weights (for attitudes)
+		double theWeightSum{ 0. };
+
+		//! Sum of weights for locations (zero if only Attitudes added)
+		double theLocWeightSum{ 0. };
+
+		//! Number of items added
+		std::size_t theCount{ 0u };
+
+		//! Accumulate weighted location
+		inline
+		void
+		addLocation
+			( Location const & loc
+			, double const & weight
+			)
+		{
+			theLocSum[0] += weight * loc[0];
+			theLocSum[1] += weight * loc[1];
+			theLocSum[2] += weight * loc[2];
+			theLocWeightSum += weight;
+		}
+
+	public:
+
+		//! Incorporate unit spinor (e.g. Attitude::spinor()) with weight.
+		inline
+		void
+		add
+			( engabra::g3::Spinor const & unitSpin
+			, double const & weight = 1.
+			)
+		{
+			if (0. < weight) // also ignores NaN weights
+			{
+				linalg::Vector4 const qq
+					{ unitSpin.theSca[0]
+					, unitSpin.theBiv[0], unitSpin.theBiv[1], unitSpin.theBiv[2]
+					};
+				std::size_t ndx{ 0u };
+				for (std::size_t row{0u} ; row < 4u ; ++row)
+				{
+					double const wq{ weight * qq[row] };
+					for (std::size_t col{row} ; col < 4u ; ++col)
+					{
+						theMoments[ndx++] += wq * qq[col];
+					}
+				}
+				theWeightSum += weight;
+				++theCount;
+			}
+		}
+
+		//! Incorporate attitude with weight
+		inline
+		void
+		add
+			( Attitude const & att
+			, double const & weight = 1.
+			)
+		{
+			add(att.spinor(), weight);
+		}
+
+		//! Incorporate attitude with weight
+		inline
+		void
+		add
+			( SpinorAttitude const & att
+			, double const & weight = 1.
+			)
+		{
+			add(att.normalized().spinor(), weight);
+		}
+
+		//! Incorporate transform (location and attitude) with weight
+		inline
+		void
+		add
+			( Transform const & xfm
+			, double const & weight = 1.
+			)
+		{
+			if (0. < weight)
+			{
+				addLocation(xfm.theLoc, weight);
+				add(xfm.theAtt.spinor(), weight);
+			}
+		}
+
+		//! Incorporate transform (location and attitude) with weight
+		inline
+		void
+		add
+			( SpinorTransform const & xfm
+			, double const & weight = 1.
+			)
+		{
+			if (0. < weight)
+			{
+				addLocation(xfm.theLoc, weight);
+				add(xfm.theAtt.normalized().spinor(), weight);
+			}
+		}
+
+		//! Combine other (partial) accumulation into this one.
+		inline
+		void
+		merge
+			( MeanAccumulator const & other
+			)
+		{
+			for (std::size_t nn{0u} ; nn < theMoments.size() ; ++nn)
+			{
+				theMoments[nn] += other.theMoments[nn];
+			}
+			for (std::size_t nn{0u} ; nn < theLocSum.size() ; ++nn)
+			{
+				theLocSum[nn] += other.theLocSum[nn];
+			}
+			theWeightSum += other.theWeightSum;
+			theLocWeightSum += other.theLocWeightSum;
+			theCount += other.theCount;
+		}
+
+		//! Number of items added (with positive weight)
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theCount;
+		}
+
+		//! Sum of weights
+		inline
+		double
+		weight
+			() const
+		{
+			return theWeightSum;
+		}
+
+		//! Moment matrix, sum(w*q*q^T), with q in order (w,b0,b1,b2).
+		inline
+		linalg::Matrix4
+		moments
+			() const
+		{
+			std::array<double, 10u> const & mm = theMoments;
+			return linalg::Matrix4
+				{ mm[0], mm[1], mm[2], mm[3]
+				, mm[1], mm[4], mm[5], mm[6]
+				, mm[2], mm[5], mm[7], mm[8]
+				, mm[3], mm[6], mm[8], mm[9]
+				};
+		}
+
+		//! Chordal mean as spinor (with non-negative scalar), null if empty
+		inline
+		engabra::g3::Spinor
+		spinor
+			() const
+		{
+			engabra::g3::Spinor spin{ engabra::g3::null<engabra::g3::Spinor>() };
+			if (0. < theWeightSum)
+			{
+				linalg::EigenSystem4 const eig
+					{ linalg::eigenSymmetric(moments()) };
+				linalg::Vector4 const & qq = eig.theVectors[0];
+				double const sgn{ (qq[0] < 0.) ? -1. : 1. };
+				spin = engabra::g3::Spinor
+					{ sgn*qq[0], sgn*qq[1], sgn*qq[2], sgn*qq[3] };
+			}
+			return spin;
+		}
+
+		//! Chordal mean attitude (null if empty)
+		inline
+		Attitude
+		attitude
+			() const
+		{
+			Attitude att{ null<Attitude>() };
+			if (0. < theWeightSum)
+			{
+				att = Attitude(spinor());
+			}
+			return att;
+		}
+
+		//! Weighted mean location (null if no Transforms were added)
+		inline
+		Location
+		location
+			() const
+		{
+			Location loc{ null<Location>() };
+			if (0. < theLocWeightSum)
+			{
+				double const scl{ 1. / theLocWeightSum };
+				loc = Location
+					{ scl * theLocSum[0], scl * theLocSum[1], scl * theLocSum[2] };
+			}
+			return loc;
+		}
+
+		//! Mean location and chordal mean attitude
+		inline
+		Transform
+		transform
+			() const
+		{
+			return Transform{ location(), attitude() };
+		}
+
+	}; // MeanAccumulator
+
+	/*! Accumulation of items (Attitude, Transform or Spinor* types).
+	 *
+	 * If weights is not null, item nn is added with weight weights[nn],
+	 * otherwise all weights are one.
+	 */
+	template <typename Item>
+	inline
+	MeanAccumulator
+	meanAccumulatorFor
+		( Item const * const items
+		, std::size_t const & numItems
+		, double const * const weights = nullptr
+		)
+	{
+		MeanAccumulator accum;
+		for (std::size_t nn{0u} ; nn < numItems ; ++nn)
+		{
+			double const weight{ weights ? weights[nn] : 1. };
+			accum.add(items[nn], weight);
+		}
+		return accum;
+	}
+
+	//! Default number of items accumulated by each parallel chunk.
+	constexpr std::size_t sMeanChunkSize{ 4u * 1024u };
+
+	/*! Multi-threaded accumulation (ref meanAccumulatorFor()).
+	 *
+	 * Each chunk is accumulated concurrently and the chunk results are
+	 * merged in order (such that results are deterministic).
+	 */
+	template <typename Item>
+	inline
+	MeanAccumulator
+	meanAccumulatorFor
+		( ThreadPool & pool
+		, Item const * const items
+		, std::size_t const & numItems
+		, double const * const weights = nullptr
+		, std::size_t const & chunkSize = sMeanChunkSize
+		)
+	{
+		std::size_t const useSize{ std::max(std::size_t{ 1u }, chunkSize) };
+		std::size_t const numChunks{ (numItems + useSize - 1u) / useSize };
+		std::vector<MeanAccumulator> chunkAccums(numChunks);
+		pool.parallelFor
+			( numItems
+			, useSize
+			, [&] (std::size_t const & beg, std::size_t const & end)
+				{
+					chunkAccums[beg / useSize] = meanAccumulatorFor
+						( items + beg, (end - beg)
+						, (weights ? (weights + beg) : nullptr)
+						);
+				}
+			);
+		MeanAccumulator accum;
+		for (MeanAccumulator const & chunkAccum : chunkAccums)
+		{
+			accum.merge(chunkAccum);
+		}
+		return accum;
+	}
+
+	//! Chordal (weighted) mean of attitudes (ref MeanAccumulator)
+	inline
+	Attitude
+	chordalMean
+		( Attitude const * const atts
+		, std::size_t const & numAtts
+		, double const * const weights = nullptr
+		)
+	{
+		return meanAccumulatorFor(atts, numAtts, weights).attitude();
+	}
+
+	//! Chordal mean attitude and (weighted) mean location of transforms
+	inline
+	Transform
+	chordalMean
+		( Transform const * const xfms
+		, std::size_t const & numXfms
+		, double const * const weights = nullptr
+		)
+	{
+		return meanAccumulatorFor(xfms, numXfms, weights).transform();
+	}
+
+	//! Multi-threaded chordalMean() of attitudes.
+	inline
+	Attitude
+	chordalMean
+		( ThreadPool & pool
+		, Attitude const * const atts
+		, std::size_t const & numAtts
+		, double const * const weights = nullptr
+		)
+	{
+		return meanAccumulatorFor(pool, atts, numAtts, weights).attitude();
+	}
+
+	//! Multi-threaded chordalMean() of transforms.
+	inline
+	Transform
+	chordalMean
+		( ThreadPool & pool
+		, Transform const * const xfms
+		, std::size_t const & numXfms
+		, double const * const weights = nullptr
+		)
+	{
+		return meanAccumulatorFor(pool, xfms, numXfms, weights).transform();
+	}
+
+	//! Iteration control for karcherMean().
+	struct KarcherOptions
+	{
+		//! Maximum number of refinement iterations
+		std::size_t theMaxIterations{ 32u };
+
+		//! Stop when update spin angle magnitude is below this [rad]
+		double theTolerance{ 1.e-13 };
+
+	}; // KarcherOptions
+
+	/*! Geodesic (Karcher) mean of unit spinors starting from spinInit.
+	 *
+	 * Iteratively refines the mean, mu, such that the weighted mean of
+	 * the (shortest) spin angles, log(q[nn]*reverse(mu)), is zero. Each
+	 * iteration is a (multi-threaded if ptPool not null) reduction over
+	 * all spinors. The spinors (and weights) must remain available for
+	 * all iterations (i.e. refinement is not a streaming operation).
+	 */
+	inline
+	engabra::g3::Spinor
+	karcherSpinor
+		( ThreadPool * const & ptPool
+		, engabra::g3::Spinor const * const spins
+		, std::size_t const & numSpins
+		, double const * const weights
+		, engabra::g3::Spinor const & spinInit
+		, KarcherOptions const & options = {}
+		)
+	{
+		using namespace engabra::g3;
+		Spinor mu{ spinInit };
+
+		// weighted sum of spin angles of each spinor relative to mu
+		std::size_t const chunkSize{ sMeanChunkSize };
+		std::size_t const numChunks{ (numSpins + chunkSize - 1u) / chunkSize };
+		std::vector<std::array<double, 4u> > chunkSums(numChunks);
+		auto const sumFunc
+			{ [&] (std::size_t const & beg, std::size_t const & end)
+			{
+				double const mw{ mu.theSca[0] };
+				double const m0{ -mu.theBiv[0] };
+				double const m1{ -mu.theBiv[1] };
+				double const m2{ -mu.theBiv[2] };
+				std::array<double, 4u> sums{};
+				for (std::size_t nn{beg} ; nn < end ; ++nn)
+				{
+					double const weight{ weights ? weights[nn] : 1. };
+					if (! (0. < weight))
+					{
+						continue;
+					}
+					// relative spinor: q[nn] * reverse(mu) (ref func.hpp)
+					Spinor const & qq = spins[nn];
+					double const uw{ qq.theSca[0] };
+					double const u0{ qq.theBiv[0] };
+					double const u1{ qq.theBiv[1] };
+					double const u2{ qq.theBiv[2] };
+					double rw{ uw*mw - (u0*m0 + u1*m1 + u2*m2) };
+					double r0{ uw*m0 + mw*u0 - (u1*m2 - u2*m1) };
+					double r1{ uw*m1 + mw*u1 - (u2*m0 - u0*m2) };
+					double r2{ uw*m2 + mw*u2 - (u0*m1 - u1*m0) };
+					// shortest rotation (same attitude for either sign)
+					if (rw < 0.)
+					{
+						rw = -rw;
+						r0 = -r0;
+						r1 = -r1;
+						r2 = -r2;
+					}
+					BiVector const ang{ spinLog(Spinor{ rw, r0, r1, r2 }) };
+					sums[0] += weight * ang[0];
+					sums[1] += weight * ang[1];
+					sums[2] += weight * ang[2];
+					sums[3] += weight;
+				}
+				chunkSums[beg / chunkSize] = sums;
+			}
+			};
+
+		for (std::size_t iter{0u} ; iter < options.theMaxIterations ; ++iter)
+		{
+			if (ptPool)
+			{
+				ptPool->parallelFor(numSpins, chunkSize, sumFunc);
+			}
+			else
+			{
+				for (std::size_t beg{0u} ; beg < numSpins ; beg += chunkSize)
+				{
+					sumFunc(beg, std::min(numSpins, beg + chunkSize));
+				}
+			}
+			std::array<double, 4u> sums{};
+			for (std::array<double, 4u> const & chunkSum : chunkSums)
+			{
+				for (std::size_t kk{0u} ; kk < 4u ; ++kk)
+				{
+					sums[kk] += chunkSum[kk];
+				}
+			}
+			if (! (0. < sums[3]))
+			{
+				mu = null<Spinor>();
+				break;
+			}
+			double const scl{ 1. / sums[3] };
+			BiVector const delta{ scl * sums[0], scl * sums[1], scl * sums[2] };
+			mu = spinExp(delta) * mu;
+			if (! (options.theTolerance < magnitude(delta)))
+			{
+				break;
+			}
+		}
+		return mu;
+	}
+
+	/*! Geodesic (Karcher) mean of attitudes (refined from chordal mean).
+	 *
+	 * The chordal mean is a close approximation to the Karcher mean
+	 * (exact for symmetric distributions) and is used as the initial
+	 * value for refinement by karcherSpinor(). If ptPool is not null,
+	 * its threads are used for each (reduction) pass.
+	 */
+	inline
+	Attitude
+	karcherMean
+		( Attitude const * const atts
+		, std::size_t const & numAtts
+		, double const * const weights = nullptr
+		, ThreadPool * const & ptPool = nullptr
+		, KarcherOptions const & options = {}
+		)
+	{
+		Attitude att{ null<Attitude>() };
+		std::vector<engabra::g3::Spinor> spins(numAtts);
+		for (std::size_t nn{0u} ; nn < numAtts ; ++nn)
+		{
+			spins[nn] = atts[nn].spinor();
+		}
+		MeanAccumulator const accum
+			{ meanAccumulatorFor(spins.data(), numAtts, weights) };
+		if (0. < accum.weight())
+		{
+			att = Attitude(karcherSpinor
+				( ptPool, spins.data(), numAtts, weights
+				, accum.spinor(), options
+				));
+		}
+		return att;
+	}
+
+	//! Mean location and Karcher mean attitude (ref karcherMean(Attitude)).
+	inline
+	Transform
+	karcherMean
+		( Transform const * const xfms
+		, std::size_t const & numXfms
+		, double const * const weights = nullptr
+		, ThreadPool * const & ptPool = nullptr
+		, KarcherOptions const & options = {}
+		)
+	{
+		Transform xfm{ null<Transform>() };
+		std::vector<engabra::g3::Spinor> spins(numXfms);
+		MeanAccumulator accum;
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			spins[nn] = xfms[nn].theAtt.spinor();
+			double const weight{ weights ? weights[nn] : 1. };
+			accum.add
+				( SpinorTransform{ xfms[nn].theLoc, SpinorAttitude(spins[nn]) }
+				, weight
+				);
+		}
+		if (0. < accum.weight())
+		{
+			xfm = Transform
+				{ accum.location()
+				, Attitude(karcherSpinor
+					( ptPool, spins.data(), numXfms, weights
+					, accum.spinor(), options
+					))
+				};
+		}
+		return xfm;
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_mean_INCL_
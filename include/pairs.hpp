@@ -0,0 +1,449 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_pairs_INCL_
+#define Rigibra_pairs_INCL_
+
+/*! \file
+\brief Contains all-pairs relative pose computations (blocked, parallel).
+
+Example:
+\snippet test_pairs.cpp DoxyExample01
+
+*/
+
+
+#include "block.hpp"
+#include "pool.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// (after other includes) defines Rigibra_LOOP_HINT - undefined at end
+#include "loophint.hpp"
+
+
+namespace rigibra
+{
+
+	/*! \brief Number of (column) poses in each cache block.
+	 *
+	 * Each pose in a TransformBlock occupies 56 bytes such that a
+	 * tile of this size (approx 28kB) fits within a typical per-core
+	 * L1/L2 cache while it is reused for every row of a chunk.
+	 */
+	constexpr std::size_t sPairTileSize{ 512u };
+
+	//! Number of (row) poses in each parallel processing chunk.
+	constexpr std::size_t sPairRowChunk{ 64u };
+
+	//! Indices, distance and angle magnitude of a relative pose pair.
+	struct PosePair
+	{
+		//! Index of first pose (the "from" pose, A)
+		std::size_t theNdxA{ 0u };
+
+		//! Index of second pose (the "into" pose, B)
+		std::size_t theNdxB{ 0u };
+
+		//! Distance between pose locations.
+		double theDistance{ sNullValue };
+
+		//! Magnitude of (physical) relative rotation angle in [0,pi].
+		double theAngle{ sNullValue };
+
+	}; // PosePair
+
+	/*! Process tiles of [colBeg,colEnd) for each row in [rowBeg,rowEnd).
+	 *
+	 * Calls rowFunc(row, tileBeg, tileEnd) such that all rows of the
+	 * chunk are processed against one (cache resident) column tile
+	 * before moving to the next tile. Columns before firstColFunc(row)
+	 * are skipped (e.g. for upper triangle processing).
+	 */
+	template <typename RowFunc, typename FirstColFunc>
+	inline
+	void
+	forPairTiles
+		( std::size_t const & rowBeg
+		, std::size_t const & rowEnd
+		, std::size_t const & numCols
+		, RowFunc const & rowFunc
+		, FirstColFunc const & firstColFunc
+		)
+	{
+		for (std::size_t tileBeg{0u} ; tileBeg < numCols
+			; tileBeg += sPairTileSize)
+		{
+			std::size_t const tileEnd
+				{ std::min(numCols, tileBeg + sPairTileSize) };
+			for (std::size_t row{rowBeg} ; row < rowEnd ; ++row)
+			{
+				std::size_t const colBeg
+					{ std::max(tileBeg, firstColFunc(row)) };
+				if (colBeg < tileEnd)
+				{
+					rowFunc(row, colBeg, tileEnd);
+				}
+			}
+		}
+	}
+
+	/*! Relative transforms, xBwA = xB * inverse(xA), for all pairs.
+	 *
+	 * For poses (transforms w.r.t. a common reference frame) xA and xB,
+	 * the relative transform, xBwA, is that of frame B with respect
+	 * to frame A (i.e. operator*(xBwRef, xRefwA) per func.hpp). The
+	 * result is stored (row-major) into the caller provided matrix:
+	 * \arg xBwAs[nA*posesB.size() + nB] = posesB[nB] * inverse(posesA[nA])
+	 *
+	 * Computation involves only polynomial operations (spinor products)
+	 * and is performed in cache blocks by threads of pool. The same
+	 * block may be provided for both posesA and posesB (all pairs).
+	 *
+	 * Example:
+	 * \snippet test_pairs.cpp DoxyExample01
+	 */
+	inline
+	void
+	relativeTransforms
+		( ThreadPool & pool
+		, TransformBlock const & posesA
+		, TransformBlock const & posesB
+		, SpinorTransform * const xBwAs
+		)
+	{
+		std::size_t const numA{ posesA.size() };
+		std::size_t const numB{ posesB.size() };
+		double const * const bx = posesB.locX();
+		double const * const by = posesB.locY();
+		double const * const bz = posesB.locZ();
+		double const * const bw = posesB.spinW();
+		double const * const b0 = posesB.spinB0();
+		double const * const b1 = posesB.spinB1();
+		double const * const b2 = posesB.spinB2();
+
+		auto const rowFunc
+			{ [&] (std::size_t const & nA, std::size_t const & beg
+				, std::size_t const & end)
+			{
+				// rotation (matrix with scale) associated with spinor of A
+				double const ax{ posesA.locX()[nA] };
+				double const ay{ posesA.locY()[nA] };
+				double const az{ posesA.locZ()[nA] };
+				double const vw{ posesA.spinW()[nA] };
+				double const v0{ posesA.spinB0()[nA] };
+				double const v1{ posesA.spinB1()[nA] };
+				double const v2{ posesA.spinB2()[nA] };
+				double const v00{ v0 * v0 }, v11{ v1 * v1 }, v22{ v2 * v2 };
+				double const magSq{ vw*vw + v00 + v11 + v22 };
+				double const scl{ 1. / magSq };
+				double const w0{ vw * v0 }, w1{ vw * v1 }, w2{ vw * v2 };
+				double const v01{ v0 * v1 }, v02{ v0 * v2 }, v12{ v1 * v2 };
+				double const m00{ scl * (magSq - 2.*(v11 + v22)) };
+				double const m01{ scl * 2.*(v01 + w2) };
+				double const m02{ scl * 2.*(v02 - w1) };
+				double const m10{ scl * 2.*(v01 - w2) };
+				double const m11{ scl * (magSq - 2.*(v00 + v22)) };
+				double const m12{ scl * 2.*(v12 + w0) };
+				double const m20{ scl * 2.*(v02 + w1) };
+				double const m21{ scl * 2.*(v12 - w0) };
+				double const m22{ scl * (magSq - 2.*(v00 + v11)) };
+				SpinorTransform * const outRow{ xBwAs + nA*numB };
+				for (std::size_t nB{beg} ; nB < end ; ++nB)
+				{
+					// location: attA(locB - locA)
+					double const d0{ bx[nB] - ax };
+					double const d1{ by[nB] - ay };
+					double const d2{ bz[nB] - az };
+					// attitude: spinB * reverse(spinA) (ref func.hpp)
+					double const uw{ bw[nB] }, u0{ b0[nB] }
+						, u1{ b1[nB] }, u2{ b2[nB] };
+					outRow[nB] = SpinorTransform
+						{ Location
+							{ m00*d0 + m01*d1 + m02*d2
+							, m10*d0 + m11*d1 + m12*d2
+							, m20*d0 + m21*d1 + m22*d2
+							}
+						, SpinorAttitude(engabra::g3::Spinor
+							{ uw*vw + (u0*v0 + u1*v1 + u2*v2)
+							, vw*u0 - uw*v0 + (u1*v2 - u2*v1)
+							, vw*u1 - uw*v1 + (u2*v0 - u0*v2)
+							, vw*u2 - uw*v2 + (u0*v1 - u1*v0)
+							})
+						};
+				}
+			}
+			};
+
+		pool.parallelFor
+			( numA
+			, sPairRowChunk
+			, [&] (std::size_t const & rowBeg, std::size_t const & rowEnd)
+				{
+					forPairTiles
+						( rowBeg, rowEnd, numB, rowFunc
+						, [] (std::size_t const &) { return std::size_t{ 0u }; }
+						);
+				}
+			);
+	}
+
+	/*! Distance and rotation angle magnitudes for all pairs.
+	 *
+	 * Same pairs as relativeTransforms() but only the magnitudes are
+	 * computed. Values are stored (row-major) into caller provided
+	 * arrays (each of size posesA.size()*posesB.size()) as
+	 * \arg distances[nA*numB + nB]: magnitude of locB - locA
+	 * \arg angles[nA*numB + nB]: relative (physical) angle in [0,pi]
+	 */
+	inline
+	void
+	relativeMagnitudes
+		( ThreadPool & pool
+		, TransformBlock const & posesA
+		, TransformBlock const & posesB
+		, double * const distances
+		, double * const angles
+		)
+	{
+		std::size_t const numA{ posesA.size() };
+		std::size_t const numB{ posesB.size() };
+		double const * const bx = posesB.locX();
+		double const * const by = posesB.locY();
+		double const * const bz = posesB.locZ();
+		double const * const bw = posesB.spinW();
+		double const * const b0 = posesB.spinB0();
+		double const * const b1 = posesB.spinB1();
+		double const * const b2 = posesB.spinB2();
+
+		auto const rowFunc
+			{ [&] (std::size_t const & nA, std::size_t const & beg
+				, std::size_t const & end)
+			{
+				double const ax{ posesA.locX()[nA] };
+				double const ay{ posesA.locY()[nA] };
+				double const az{ posesA.locZ()[nA] };
+				double const vw{ posesA.spinW()[nA] };
+				double const v0{ posesA.spinB0()[nA] };
+				double const v1{ posesA.spinB1()[nA] };
+				double const v2{ posesA.spinB2()[nA] };
+				double * const distRow{ distances + nA*numB };
+				double * const angRow{ angles + nA*numB };
+				Rigibra_LOOP_HINT
+				for (std::size_t nB{beg} ; nB < end ; ++nB)
+				{
+					double const d0{ bx[nB] - ax };
+					double const d1{ by[nB] - ay };
+					double const d2{ bz[nB] - az };
+					distRow[nB] = std::sqrt(d0*d0 + d1*d1 + d2*d2);
+					// spinB * reverse(spinA): scalar and bivector parts
+					double const uw{ bw[nB] }, u0{ b0[nB] }
+						, u1{ b1[nB] }, u2{ b2[nB] };
+					double const pw{ uw*vw + (u0*v0 + u1*v1 + u2*v2) };
+					double const p0{ vw*u0 - uw*v0 + (u1*v2 - u2*v1) };
+					double const p1{ vw*u1 - uw*v1 + (u2*v0 - u0*v2) };
+					double const p2{ vw*u2 - uw*v2 + (u0*v1 - u1*v0) };
+					double const bivMag{ std::sqrt(p0*p0 + p1*p1 + p2*p2) };
+					angRow[nB] = 2. * std::atan2(bivMag, std::abs(pw));
+				}
+			}
+			};
+
+		pool.parallelFor
+			( numA
+			, sPairRowChunk
+			, [&] (std::size_t const & rowBeg, std::size_t const & rowEnd)
+				{
+					forPairTiles
+						( rowBeg, rowEnd, numB, rowFunc
+						, [] (std::size_t const &) { return std::size_t{ 0u }; }
+						);
+				}
+			);
+	}
+
+	/*! Pairs of poses, nA < nB, within distance and angle thresholds.
+	 *
+	 * Returns all (unordered) pairs with distance <= maxDistance
+	 * and relative rotation angle <= maxAngle (ref PosePair) without
+	 * storing the full matrix of pair values. Tests are performed
+	 * with (vectorizable) squared distance and spinor dot products;
+	 * distance and angle are evaluated only for accepted pairs. The
+	 * result is sorted by (theNdxA, theNdxB). Invalid poses never
+	 * produce pairs.
+	 */
+	inline
+	std::vector<PosePair>
+	pairsWithin
+		( ThreadPool & pool
+		, TransformBlock const & poses
+		, double const & maxDistance
+		, double const & maxAngle
+		)
+	{
+		std::size_t const numPoses{ poses.size() };
+		double const * const px = poses.locX();
+		double const * const py = poses.locY();
+		double const * const pz = poses.locZ();
+		double const * const pw = poses.spinW();
+		double const * const p0 = poses.spinB0();
+		double const * const p1 = poses.spinB1();
+		double const * const p2 = poses.spinB2();
+
+		// spinor magnitudes (for non-unit spinors)
+		std::vector<double> spinMags(numPoses);
+		for (std::size_t nn{0u} ; nn < numPoses ; ++nn)
+		{
+			spinMags[nn] = std::sqrt
+				( pw[nn]*pw[nn] + p0[nn]*p0[nn]
+				+ p1[nn]*p1[nn] + p2[nn]*p2[nn]
+				);
+		}
+
+		// angle <= maxAngle iff |cos(angle/2)| >= cos(maxAngle/2)
+		double const maxDistSq{ maxDistance * maxDistance };
+		double const minCosHalf
+			{ std::cos(.5 * std::min(maxAngle, engabra::g3::pi)) };
+
+		// pairs from each chunk of rows (assembled in order afterwards)
+		std::size_t const numChunks
+			{ (numPoses + sPairRowChunk - 1u) / sPairRowChunk };
+		std::vector<std::vector<PosePair> > chunkPairs(numChunks);
+
+		pool.parallelFor
+			( numPoses
+			, sPairRowChunk
+			, [&] (std::size_t const & rowBeg, std::size_t const & rowEnd)
+				{
+					std::vector<PosePair> & pairs
+						= chunkPairs[rowBeg / sPairRowChunk];
+					std::vector<unsigned char> accepts(sPairTileSize);
+					unsigned char * const accept{ accepts.data() };
+					auto const rowFunc
+						{ [&] (std::size_t const & nA, std::size_t const & beg
+							, std::size_t const & end)
+						{
+							double const ax{ px[nA] };
+							double const ay{ py[nA] };
+							double const az{ pz[nA] };
+							double const vw{ pw[nA] };
+							double const v0{ p0[nA] };
+							double const v1{ p1[nA] };
+							double const v2{ p2[nA] };
+							double const cosScl{ minCosHalf * spinMags[nA] };
+							std::size_t const numCols{ end - beg };
+							Rigibra_LOOP_HINT
+							for (std::size_t nc{0u} ; nc < numCols ; ++nc)
+							{
+								std::size_t const nB{ beg + nc };
+								double const d0{ px[nB] - ax };
+								double const d1{ py[nB] - ay };
+								double const d2{ pz[nB] - az };
+								double const distSq{ d0*d0 + d1*d1 + d2*d2 };
+								double const dot
+									{ pw[nB]*vw + p0[nB]*v0
+									+ p1[nB]*v1 + p2[nB]*v2
+									};
+								// comparisons with NaN are false
+								accept[nc] = static_cast<unsigned char>
+									(  (distSq <= maxDistSq)
+									&& (cosScl * spinMags[nB] <= std::abs(dot))
+									);
+							}
+							for (std::size_t nc{0u} ; nc < numCols ; ++nc)
+							{
+								if (accept[nc])
+								{
+									std::size_t const nB{ beg + nc };
+									double const d0{ px[nB] - ax };
+									double const d1{ py[nB] - ay };
+									double const d2{ pz[nB] - az };
+									double const uw{ pw[nB] }, u0{ p0[nB] }
+										, u1{ p1[nB] }, u2{ p2[nB] };
+									double const sw
+										{ uw*vw + (u0*v0 + u1*v1 + u2*v2) };
+									double const s0
+										{ vw*u0 - uw*v0 + (u1*v2 - u2*v1) };
+									double const s1
+										{ vw*u1 - uw*v1 + (u2*v0 - u0*v2) };
+									double const s2
+										{ vw*u2 - uw*v2 + (u0*v1 - u1*v0) };
+									double const bivMag
+										{ std::sqrt(s0*s0 + s1*s1 + s2*s2) };
+									pairs.emplace_back(PosePair
+										{ nA
+										, nB
+										, std::sqrt(d0*d0 + d1*d1 + d2*d2)
+										, 2. * std::atan2(bivMag, std::abs(sw))
+										});
+								}
+							}
+						}
+						};
+					forPairTiles
+						( rowBeg, rowEnd, numPoses, rowFunc
+						, [] (std::size_t const & nA) { return nA + 1u; }
+						);
+					std::sort
+						( pairs.begin(), pairs.end()
+						, [] (PosePair const & p1, PosePair const & p2)
+							{
+								return
+									(  (p1.theNdxA < p2.theNdxA)
+									|| (  (p1.theNdxA == p2.theNdxA)
+									   && (p1.theNdxB < p2.theNdxB)
+									   )
+									);
+							}
+						);
+				}
+			);
+
+		std::size_t numPairs{ 0u };
+		for (std::vector<PosePair> const & pairs : chunkPairs)
+		{
+			numPairs += pairs.size();
+		}
+		std::vector<PosePair> allPairs;
+		allPairs.reserve(numPairs);
+		for (std::vector<PosePair> const & pairs : chunkPairs)
+		{
+			allPairs.insert(allPairs.end(), pairs.cbegin(), pairs.cend());
+		}
+		return allPairs;
+	}
+
+} // [rigibra]
+
+// loop hint is only for use within this header
+#undef Rigibra_LOOP_HINT
+
+
+#endif // Rigibra_pairs_INCL_
@@ -0,0 +1,357 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_parallel_INCL_
+#define Rigibra_parallel_INCL_
+
+/*! \file
+\brief Contains multi-threaded versions of batch operations.
+
+Example:
+\snippet test_parallel.cpp DoxyExample01
+
+*/
+
+
+#include "func.hpp"
+#include "pool.hpp"
+#include "simd.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace rigibra
+{
+
+	/*! \brief Default number of points processed by each parallel chunk.
+	 *
+	 * SoA input and output arrays use 48 bytes per point such that
+	 * a chunk of this size (approx 400kB) fits within a typical
+	 * per-core L2 cache.
+	 */
+	constexpr std::size_t sParallelChunkSize{ 8u * 1024u };
+
+	/*! Multi-threaded transformation of SoA points.
+	 *
+	 * Same result as rigibra::simd::apply() but with chunks of
+	 * chunkSize points processed concurrently by threads in pool.
+	 *
+	 * Example:
+	 * \snippet test_parallel.cpp DoxyExample01
+	 */
+	inline
+	void
+	apply
+		( ThreadPool & pool
+		, Transform const & xfm
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		, std::size_t const & chunkSize = sParallelChunkSize
+		)
+	{
+		pool.parallelFor
+			( numPnts
+			, chunkSize
+			, [&] (std::size_t const & beg, std::size_t const & end)
+				{
+					simd::apply
+						( xfm
+						, xIn + beg, yIn + beg, zIn + beg, (end - beg)
+						, xOut + beg, yOut + beg, zOut + beg
+						);
+				}
+			);
+	}
+
+	//! Multi-threaded transformation of AoS points (ref func.hpp apply()).
+	inline
+	void
+	apply
+		( ThreadPool & pool
+		, Transform const & xfm
+		, engabra::g3::Vector const * const pntsIn
+		, std::size_t const & numPnts
+		, engabra::g3::Vector * const pntsOut
+		, std::size_t const & chunkSize = sParallelChunkSize
+		)
+	{
+		FastTransform const fastXfm(xfm);
+		pool.parallelFor
+			( numPnts
+			, chunkSize
+			, [&] (std::size_t const & beg, std::size_t const & end)
+				{
+					Rigibra_INSTRUMENT_SCOPE_N(BatchElement, end - beg);
+					for (std::size_t nn{beg} ; nn < end ; ++nn)
+					{
+						pntsOut[nn] = fastXfm(pntsIn[nn]);
+					}
+				}
+			);
+	}
+
+	/*! \brief Default number of transforms in each parallel scan chunk.
+	 *
+	 * Each item involves (at least) a spinor product such that
+	 * chunks of this size amortize the per-chunk scheduling cost.
+	 */
+	constexpr std::size_t sParallelScanChunkSize{ 4u * 1024u };
+
+namespace detail
+{
+	//! SpinorTransform equivalent of sequence item (no conversion).
+	inline
+	SpinorTransform const &
+	spinorXfmFor
+		( SpinorTransform const & xfm
+		)
+	{
+		return xfm;
+	}
+
+	//! SpinorTransform equivalent of sequence item (exponential).
+	inline
+	SpinorTransform
+	spinorXfmFor
+		( Transform const & xfm
+		)
+	{
+		return SpinorTransform::from(xfm);
+	}
+
+	//! Set sequence output item from (accumulated) SpinorTransform.
+	inline
+	void
+	setFrom
+		( SpinorTransform const & xAccum
+		, SpinorTransform * const & ptOut
+		)
+	{
+		*ptOut = xAccum;
+	}
+
+	//! Set sequence output item from (accumulated) SpinorTransform.
+	inline
+	void
+	setFrom
+		( SpinorTransform const & xAccum
+		, Transform * const & ptOut
+		)
+	{
+		*ptOut = xAccum.transform();
+	}
+
+	/*! Composition of each chunk (concurrently): one value per chunk.
+	 *
+	 * Chunk nc covers items [nc*chunkSize, (nc+1)*chunkSize) and
+	 * its value is the (func.hpp reduce()) composition of these
+	 * items: i.e. xfmsIn[ndx1-1] * ... * xfmsIn[ndx0]. Xfm is one
+	 * of SpinorTransform or Transform.
+	 */
+	template <typename Xfm>
+	inline
+	std::vector<SpinorTransform>
+	chunkReductions
+		( ThreadPool & pool
+		, Xfm const * const xfmsIn
+		, std::size_t const & numXfms
+		, std::size_t const & chunkSize
+		)
+	{
+		std::size_t const numChunks{ (numXfms + chunkSize - 1u) / chunkSize };
+		std::vector<SpinorTransform> chunkXfms(numChunks);
+		pool.parallelFor
+			( numChunks
+			, 1u
+			, [&] (std::size_t const & beg, std::size_t const & end)
+				{
+					for (std::size_t nc{beg} ; nc < end ; ++nc)
+					{
+						std::size_t const ndx0{ nc * chunkSize };
+						std::size_t const ndx1
+							{ std::min(ndx0 + chunkSize, numXfms) };
+						SpinorTransform xCurr{ identity<SpinorTransform>() };
+						for (std::size_t nn{ndx0} ; nn < ndx1 ; ++nn)
+						{
+							xCurr = spinorXfmFor(xfmsIn[nn]) * xCurr;
+						}
+						chunkXfms[nc] = xCurr;
+					}
+				}
+			);
+		return chunkXfms;
+	}
+
+	//! Two-pass inclusive scan (Xfm: SpinorTransform or Transform).
+	template <typename Xfm>
+	inline
+	void
+	inclusiveScan
+		( ThreadPool & pool
+		, Xfm const * const xfmsIn
+		, std::size_t const & numXfms
+		, Xfm * const xfmsOut
+		, std::size_t const & chunkSize
+		)
+	{
+		std::size_t const useSize{ std::max(chunkSize, std::size_t{1u}) };
+		std::size_t const numChunks{ (numXfms + useSize - 1u) / useSize };
+		if ((numChunks < 2u) || (pool.size() < 2u))
+		{
+			// two-pass scan is only worthwhile with concurrent chunks
+			rigibra::inclusiveScan(xfmsIn, numXfms, xfmsOut);
+			return;
+		}
+
+		// composition of each chunk
+		std::vector<SpinorTransform> chunkXfms
+			{ chunkReductions(pool, xfmsIn, numXfms, useSize) };
+
+		// exclusive scan of chunk results (starting value for each chunk)
+		SpinorTransform xAccum{ identity<SpinorTransform>() };
+		for (SpinorTransform & chunkXfm : chunkXfms)
+		{
+			SpinorTransform const xNext{ chunkXfm * xAccum };
+			chunkXfm = xAccum;
+			xAccum = xNext;
+		}
+
+		// scan within each chunk
+		pool.parallelFor
+			( numChunks
+			, 1u
+			, [&] (std::size_t const & beg, std::size_t const & end)
+				{
+					for (std::size_t nc{beg} ; nc < end ; ++nc)
+					{
+						std::size_t const ndx0{ nc * useSize };
+						std::size_t const ndx1
+							{ std::min(ndx0 + useSize, numXfms) };
+						SpinorTransform xCurr{ chunkXfms[nc] };
+						for (std::size_t nn{ndx0} ; nn < ndx1 ; ++nn)
+						{
+							xCurr = spinorXfmFor(xfmsIn[nn]) * xCurr;
+							setFrom(xCurr, xfmsOut + nn);
+						}
+					}
+				}
+			);
+	}
+
+} // [detail]
+
+	/*! Multi-threaded reduce (ref func.hpp reduce()).
+	 *
+	 * Each chunk of chunkSize transforms is composed concurrently
+	 * and the (few) chunk results are then composed in order.
+	 */
+	inline
+	SpinorTransform
+	reduce
+		( ThreadPool & pool
+		, SpinorTransform const * const xfmsIn
+		, std::size_t const & numXfms
+		, std::size_t const & chunkSize = sParallelScanChunkSize
+		)
+	{
+		std::size_t const useSize{ std::max(chunkSize, std::size_t{1u}) };
+		std::vector<SpinorTransform> const chunkXfms
+			{ detail::chunkReductions(pool, xfmsIn, numXfms, useSize) };
+		return reduce(chunkXfms.data(), chunkXfms.size());
+	}
+
+	/*! Multi-threaded inclusive scan (ref func.hpp inclusiveScan()).
+	 *
+	 * Uses a two-pass blocked scan: first each chunk is reduced
+	 * concurrently, then chunk results are (serially) scanned to
+	 * provide the starting value for each chunk, and finally each
+	 * chunk is scanned concurrently from its starting value. The
+	 * serial func.hpp inclusiveScan() is used if there is only a
+	 * single chunk or if pool has fewer than two worker threads.
+	 *
+	 * Example:
+	 * \snippet test_parallel.cpp DoxyExampleScan
+	 */
+	inline
+	void
+	inclusiveScan
+		( ThreadPool & pool
+		, SpinorTransform const * const xfmsIn
+		, std::size_t const & numXfms
+		, SpinorTransform * const xfmsOut
+		, std::size_t const & chunkSize = sParallelScanChunkSize
+		)
+	{
+		detail::inclusiveScan(pool, xfmsIn, numXfms, xfmsOut, chunkSize);
+	}
+
+	/*! Multi-threaded inclusive scan of Transform sequence.
+	 *
+	 * Same result as func.hpp inclusiveScan() (within roundoff).
+	 * Conversions to SpinorTransform (exponential) are performed in
+	 * both passes such that no intermediate storage is required.
+	 */
+	inline
+	void
+	inclusiveScan
+		( ThreadPool & pool
+		, Transform const * const xfmsIn
+		, std::size_t const & numXfms
+		, Transform * const xfmsOut
+		, std::size_t const & chunkSize = sParallelScanChunkSize
+		)
+	{
+		detail::inclusiveScan(pool, xfmsIn, numXfms, xfmsOut, chunkSize);
+	}
+
+	//! Multi-threaded reduce of Transform sequence (ref func.hpp reduce()).
+	inline
+	Transform
+	reduce
+		( ThreadPool & pool
+		, Transform const * const xfmsIn
+		, std::size_t const & numXfms
+		, std::size_t const & chunkSize = sParallelScanChunkSize
+		)
+	{
+		std::size_t const useSize{ std::max(chunkSize, std::size_t{1u}) };
+		std::vector<SpinorTransform> const chunkXfms
+			{ detail::chunkReductions(pool, xfmsIn, numXfms, useSize) };
+		return reduce(chunkXfms.data(), chunkXfms.size()).transform();
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_parallel_INCL_
@@ -0,0 +1,130 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_pool_INCL_
+#define Rigibra_pool_INCL_
+
+/*! \file
+\brief Contains a reusable work-stealing thread pool for batch operations.
+
+Example:
+\snippet test_pool.cpp DoxyExample01
+
+*/
+
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+
+namespace rigibra
+{
+
+	/*! \brief Reusable pool of worker threads with work-stealing queues.
+	 *
+	 * Work is submitted as a range of item indices which is split
+	 * into chunks. Chunks are initially assigned to worker queues in
+	 * contiguous blocks (so that each worker tends to process the
+	 * same region of memory). Workers that run out of chunks steal
+	 * from the far end of other worker queues to balance the load
+	 * (e.g. for tail chunks or uneven NUMA memory access costs).
+	 *
+	 * The thread calling parallelFor() participates in processing
+	 * and returns only after all chunks have been completed.
+	 *
+	 * Example:
+	 * \snippet test_pool.cpp DoxyExample01
+	 */
+	class ThreadPool
+	{
+		struct Impl;
+		std::unique_ptr<Impl> thePimpl;
+
+	public:
+
+		//! Function invoked for each chunk of items: [beg, end)
+		using ChunkFunc = std::function<void(std::size_t, std::size_t)>;
+
+		/*! Start numThreads worker threads.
+		 *
+		 * If numThreads is zero, use std::thread::hardware_concurrency().
+		 *
+		 * If pinThreads is true, worker thread nn is bound to the
+		 * processor core (nn % numCores) where supported (Linux). It
+		 * is otherwise ignored.
+		 */
+		explicit
+		ThreadPool
+			( std::size_t const & numThreads = 0u
+			, bool const & pinThreads = false
+			);
+
+		//! Completes queued work then joins all worker threads.
+		~ThreadPool
+			();
+
+		ThreadPool(ThreadPool const &) = delete;
+		ThreadPool & operator=(ThreadPool const &) = delete;
+
+		//! Number of worker threads (not including calling thread).
+		std::size_t
+		size
+			() const;
+
+		/*! Invoke func(beg,end) for chunks that cover [0,numItems).
+		 *
+		 * Each chunk has chunkSize items (except perhaps the last).
+		 * A chunkSize of zero is treated as one. The func must be
+		 * safe to call concurrently for different chunks.
+		 *
+		 * If func throws (in any thread), chunks not yet started are
+		 * skipped, all chunks in progress are waited for, and then the
+		 * first exception is rethrown in the calling thread.
+		 */
+		void
+		parallelFor
+			( std::size_t const & numItems
+			, std::size_t const & chunkSize
+			, ChunkFunc const & func
+			);
+
+	}; // ThreadPool
+
+
+	/*! \brief Library owned pool (created on first use)
+	 *
+	 * Uses all hardware threads without pinning. Applications
+	 * that need specific settings may create their own ThreadPool.
+	 */
+	ThreadPool &
+	defaultPool
+		();
+
+} // [rigibra]
+
+
+#endif // Rigibra_pool_INCL_
@@ -0,0 +1,756 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_poseindex_INCL_
+#define Rigibra_poseindex_INCL_
+
+/*! \file
+\brief Contains PoseIndex for location/orientation proximity queries.
+
+Example:
+\snippet test_poseindex.cpp DoxyExample01
+
+*/
+
+
+#include "pool.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+
+namespace rigibra
+{
+
+	//! Pose found by a PoseIndex query.
+	struct PoseMatch
+	{
+		//! Identifier of pose (order in which it was added to index).
+		std::size_t theId{ 0u };
+
+		//! Distance between query and pose locations.
+		double theDistance{ sNullValue };
+
+		//! Magnitude of (physical) relative rotation angle in [0,pi].
+		double theAngle{ sNullValue };
+
+	}; // PoseMatch
+
+
+	/*! \brief Spatial index of poses for radius and nearest queries.
+	 *
+	 * Each pose is represented as a point in 7 dimensions: location
+	 * (3D) and the unit spinor (4D) on the hypersphere. A k-d tree over
+	 * these points partitions both location space and the spinor
+	 * hypersphere (SO(3)) such that queries require O(log n) effort
+	 * (for well distributed data) instead of a linear scan.
+	 *
+	 * Spinors are stored in canonical form (non-negative scalar). Since
+	 * spinors q and -q represent the same attitude, queries search both
+	 * hemispheres. The chord length between unit spinors (of the same
+	 * hemisphere) is related to the physical rotation angle, ang, by
+	 * \arg chord = |q1 - q2| = 2*sin(ang/4)
+	 *
+	 * For nearest() queries, proximity is measured as
+	 * \arg metric^2 = distance^2 + (2*angleScale*chord)^2
+	 *
+	 * which is approximately distance^2 + (angleScale*ang)^2 for small
+	 * angles. I.e. angleScale has units of length per radian.
+	 *
+	 * Poses may be bulk loaded (with parallel tree construction) and
+	 * inserted incrementally. Inserted poses are held in a pending
+	 * buffer of at most sMaxPending entries (scanned linearly). When
+	 * full, the buffer is merged with the (smaller) trees of similar
+	 * size into a new tree (i.e. a logarithmic method) such that the
+	 * index comprises O(log n) trees of decreasing size. Insertion is
+	 * O(log^2 n) amortized and queries search each tree. Note that an
+	 * individual insert() may rebuild (serially) a tree that includes
+	 * most of the index (O(n log n)) - ref also rebuild().
+	 *
+	 * Example:
+	 * \snippet test_poseindex.cpp DoxyExample01
+	 */
+	class PoseIndex
+	{
+	public:
+
+		//! Maximum number of entries in (unsplit) leaf nodes.
+		static constexpr std::size_t sLeafSize{ 8u };
+
+		//! Maximum number of pending entries (before merge into a tree).
+		static constexpr std::size_t sMaxPending{ 64u };
+
+	private:
+
+		//! Coordinates: location (0,1,2) and scaled spinor (3,4,5,6)
+		using Coords = std::array<double, 7u>;
+
+		//! Indexed pose
+		struct Entry
+		{
+			Coords theCoords;
+			std::size_t theId;
+		};
+
+		//! K-d tree of entries
+		struct Tree
+		{
+			//! Entries in k-d tree order (median of each range is its node)
+			std::vector<Entry> theEntries;
+
+			//! Split dimension for node at median position of each range
+			std::vector<std::uint8_t> theSplitDims;
+		};
+
+		//! Search bounds (and result collection) for radius queries
+		struct RadiusQuery
+		{
+			Coords theCoords; // query point (w/ spinor in one hemisphere)
+			double theSpinSign; // +1/-1 if query spinor is canonical/negated
+			// (coordinates include sign: half has nonnegative/positive dot)
+			double theMaxDist;
+			double theMaxSpin; // bound on scaled spinor coordinates
+			double theMaxChordSq; // bound on (unscaled) chord squared
+			std::vector<PoseMatch> * thePtMatches;
+		};
+
+		//! (metric squared, entry) candidates with largest metric on top.
+		using Heap = std::priority_queue<std::pair<double, Entry const *> >;
+
+		//! Scale from metric units to radians (ref class description).
+		double theAngleScale{ 1. };
+
+		//! Trees of (strictly) decreasing size
+		std::vector<Tree> theTrees;
+
+		//! Recently inserted entries (not yet in a tree)
+		std::vector<Entry> thePending;
+
+		//! Number of poses added (including null ones)
+		std::size_t theSize{ 0u };
+
+		//! Index coordinates for pose (spinor in canonical hemisphere)
+		inline
+		Coords
+		coordsFor
+			( Transform const & pose
+			) const
+		{
+			engabra::g3::Spinor const spin{ pose.theAtt.spinor() };
+			double const sgn{ (spin.theSca[0] < 0.) ? -1. : 1. };
+			double const scl{ 2. * theAngleScale * sgn };
+			return Coords
+				{ pose.theLoc[0], pose.theLoc[1], pose.theLoc[2]
+				, scl * spin.theSca[0]
+				, scl * spin.theBiv[0]
+				, scl * spin.theBiv[1]
+				, scl * spin.theBiv[2]
+				};
+		}
+
+		//! Squared location distance and (signed) spinor dot product
+		inline
+		static
+		std::pair<double, double>
+		distSqAndDot
+			( Coords const & coA
+			, Coords const & coB
+			)
+		{
+			double distSq{ 0. };
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				double const dif{ coA[kk] - coB[kk] };
+				distSq += dif * dif;
+			}
+			double dot{ 0. };
+			for (std::size_t kk{3u} ; kk < 7u ; ++kk)
+			{
+				dot += coA[kk] * coB[kk];
+			}
+			return { distSq, dot };
+		}
+
+		//! Physical angle from (unscaled) chord length squared
+		inline
+		static
+		double
+		angleFromChordSq
+			( double const & chordSq
+			)
+		{
+			double const halfChord{ .5 * std::sqrt(chordSq) };
+			return 4. * std::asin(std::min(1., halfChord));
+		}
+
+		//! Build k-d subtree over [beg,end) (serially)
+		inline
+		static
+		void
+		buildRange
+			( Tree * const & ptTree
+			, std::size_t const & beg
+			, std::size_t const & end
+			)
+		{
+			if (sLeafSize < (end - beg))
+			{
+				std::size_t const mid{ splitRange(ptTree, beg, end) };
+				buildRange(ptTree, beg, mid);
+				buildRange(ptTree, mid + 1u, end);
+			}
+		}
+
+		//! Partition [beg,end) about median in dimension of largest spread
+		inline
+		static
+		std::size_t
+		splitRange
+			( Tree * const & ptTree
+			, std::size_t const & beg
+			, std::size_t const & end
+			)
+		{
+			std::vector<Entry> & entries = ptTree->theEntries;
+			Coords mins{ entries[beg].theCoords };
+			Coords maxs{ entries[beg].theCoords };
+			for (std::size_t nn{beg + 1u} ; nn < end ; ++nn)
+			{
+				Coords const & co = entries[nn].theCoords;
+				for (std::size_t kk{0u} ; kk < 7u ; ++kk)
+				{
+					mins[kk] = std::min(mins[kk], co[kk]);
+					maxs[kk] = std::max(maxs[kk], co[kk]);
+				}
+			}
+			std::size_t dim{ 0u };
+			for (std::size_t kk{1u} ; kk < 7u ; ++kk)
+			{
+				if ((maxs[dim] - mins[dim]) < (maxs[kk] - mins[kk]))
+				{
+					dim = kk;
+				}
+			}
+			std::size_t const mid{ beg + (end - beg) / 2u };
+			std::nth_element
+				( entries.begin() + beg
+				, entries.begin() + mid
+				, entries.begin() + end
+				, [&dim] (Entry const & e1, Entry const & e2)
+					{ return e1.theCoords[dim] < e2.theCoords[dim]; }
+				);
+			ptTree->theSplitDims[mid] = static_cast<std::uint8_t>(dim);
+			return mid;
+		}
+
+		/*! Build tree from its entries (in any order).
+		 *
+		 * The upper tree levels are built serially and the resulting
+		 * subtrees are then built concurrently by threads of ptPool (if
+		 * it is not null).
+		 */
+		inline
+		static
+		void
+		buildTree
+			( Tree * const & ptTree
+			, ThreadPool * const & ptPool
+			)
+		{
+			std::size_t const numEntries{ ptTree->theEntries.size() };
+			ptTree->theSplitDims.assign(numEntries, std::uint8_t{ 0u });
+			std::size_t const numThreads{ ptPool ? (ptPool->size() + 1u) : 1u };
+			if (numThreads < 2u)
+			{
+				buildRange(ptTree, 0u, numEntries);
+				return;
+			}
+
+			// split serially until there are enough subtrees for threads
+			using Range = std::pair<std::size_t, std::size_t>;
+			std::vector<Range> ranges{ Range{ 0u, numEntries } };
+			while (ranges.size() < (4u * numThreads))
+			{
+				std::vector<Range> nextRanges;
+				for (Range const & range : ranges)
+				{
+					if (sLeafSize < (range.second - range.first))
+					{
+						std::size_t const mid
+							{ splitRange(ptTree, range.first, range.second) };
+						nextRanges.emplace_back(Range{ range.first, mid });
+						nextRanges.emplace_back(Range{ mid + 1u, range.second });
+					}
+				}
+				if (nextRanges.empty())
+				{
+					break;
+				}
+				ranges.swap(nextRanges);
+			}
+			ptPool->parallelFor
+				( ranges.size()
+				, 1u
+				, [&ptTree, &ranges]
+					(std::size_t const & beg, std::size_t const & end)
+					{
+						for (std::size_t nn{beg} ; nn < end ; ++nn)
+						{
+							buildRange
+								(ptTree, ranges[nn].first, ranges[nn].second);
+						}
+					}
+				);
+		}
+
+		//! Add entry to matches if it satisfies query
+		inline
+		static
+		void
+		radiusTest
+			( RadiusQuery const & query
+			, Entry const & entry
+			, double const & invScaleSq
+			)
+		{
+			std::pair<double, double> const dd
+				{ distSqAndDot(query.theCoords, entry.theCoords) };
+			double const & distSq = dd.first;
+			double const dot{ invScaleSq * dd.second };
+			// each hemisphere search accepts only its own (disjoint) half
+			bool const isHalf
+				{ (0. < query.theSpinSign) ? (0. <= dot) : (0. < dot) };
+			double const chordSq{ 2. - 2.*std::abs(dot) };
+			if ( isHalf
+			  && (distSq <= (query.theMaxDist * query.theMaxDist))
+			  && (chordSq <= query.theMaxChordSq)
+			   )
+			{
+				query.thePtMatches->emplace_back(PoseMatch
+					{ entry.theId, std::sqrt(distSq), angleFromChordSq(chordSq) });
+			}
+		}
+
+		//! Radius search over subtree [beg,end)
+		inline
+		static
+		void
+		radiusSearch
+			( RadiusQuery const & query
+			, Tree const & tree
+			, std::size_t const & beg
+			, std::size_t const & end
+			, double const & invScaleSq
+			)
+		{
+			std::vector<Entry> const & entries = tree.theEntries;
+			if (! (sLeafSize < (end - beg)))
+			{
+				for (std::size_t nn{beg} ; nn < end ; ++nn)
+				{
+					radiusTest(query, entries[nn], invScaleSq);
+				}
+				return;
+			}
+			std::size_t const mid{ beg + (end - beg) / 2u };
+			std::size_t const dim{ tree.theSplitDims[mid] };
+			radiusTest(query, entries[mid], invScaleSq);
+			double const dif
+				{ query.theCoords[dim] - entries[mid].theCoords[dim] };
+			double const bound
+				{ (dim < 3u) ? query.theMaxDist : query.theMaxSpin };
+			if (dif <= bound)
+			{
+				radiusSearch(query, tree, beg, mid, invScaleSq);
+			}
+			if (-bound <= dif)
+			{
+				radiusSearch(query, tree, mid + 1u, end, invScaleSq);
+			}
+		}
+
+		//! Metric squared (ref class description) if in query hemisphere
+		inline
+		static
+		double
+		metricSq
+			( Coords const & coQuery
+			, double const & spinSign
+			, Entry const & entry
+			)
+		{
+			double sumSq{ 0. };
+			double dot{ 0. };
+			for (std::size_t kk{0u} ; kk < 7u ; ++kk)
+			{
+				double const dif{ coQuery[kk] - entry.theCoords[kk] };
+				sumSq += dif * dif;
+			}
+			for (std::size_t kk{3u} ; kk < 7u ; ++kk)
+			{
+				dot += coQuery[kk] * entry.theCoords[kk];
+			}
+			bool const isHalf{ (0. < spinSign) ? (0. <= dot) : (0. < dot) };
+			return isHalf ? sumSq : -1.;
+		}
+
+		//! Retain entry in heap if among the numNear closest
+		inline
+		static
+		void
+		nearestTest
+			( Coords const & coQuery
+			, double const & spinSign
+			, Entry const & entry
+			, std::size_t const & numNear
+			, Heap * const & ptHeap
+			)
+		{
+			double const mSq{ metricSq(coQuery, spinSign, entry) };
+			if (! (mSq < 0.))
+			{
+				if (ptHeap->size() < numNear)
+				{
+					ptHeap->emplace(mSq, &entry);
+				}
+				else
+				if (mSq < ptHeap->top().first)
+				{
+					ptHeap->pop();
+					ptHeap->emplace(mSq, &entry);
+				}
+			}
+		}
+
+		//! Nearest neighbor search over subtree [beg,end)
+		inline
+		static
+		void
+		nearestSearch
+			( Coords const & coQuery
+			, double const & spinSign
+			, std::size_t const & numNear
+			, Tree const & tree
+			, std::size_t const & beg
+			, std::size_t const & end
+			, Heap * const & ptHeap
+			)
+		{
+			std::vector<Entry> const & entries = tree.theEntries;
+			if (! (sLeafSize < (end - beg)))
+			{
+				for (std::size_t nn{beg} ; nn < end ; ++nn)
+				{
+					nearestTest(coQuery, spinSign, entries[nn], numNear, ptHeap);
+				}
+				return;
+			}
+			std::size_t const mid{ beg + (end - beg) / 2u };
+			std::size_t const dim{ tree.theSplitDims[mid] };
+			nearestTest(coQuery, spinSign, entries[mid], numNear, ptHeap);
+			double const dif{ coQuery[dim] - entries[mid].theCoords[dim] };
+			// near side first, then far side only if it could contain closer
+			std::pair<std::size_t, std::size_t> const lo{ beg, mid };
+			std::pair<std::size_t, std::size_t> const hi{ mid + 1u, end };
+			std::pair<std::size_t, std::size_t> const & near
+				= (dif <= 0.) ? lo : hi;
+			std::pair<std::size_t, std::size_t> const & far
+				= (dif <= 0.) ? hi : lo;
+			nearestSearch
+				( coQuery, spinSign, numNear
+				, tree, near.first, near.second, ptHeap
+				);
+			if ( (ptHeap->size() < numNear)
+			  || ((dif * dif) < ptHeap->top().first)
+			   )
+			{
+				nearestSearch
+					( coQuery, spinSign, numNear
+					, tree, far.first, far.second, ptHeap
+					);
+			}
+		}
+
+		//! Match information for (valid) entry with id
+		inline
+		PoseMatch
+		matchFor
+			( Coords const & coQuery
+			, Entry const & entry
+			) const
+		{
+			std::pair<double, double> const dd
+				{ distSqAndDot(coQuery, entry.theCoords) };
+			double const spinScaleSq{ 4. * theAngleScale * theAngleScale };
+			double const chordSq{ 2. - 2.*std::abs(dd.second / spinScaleSq) };
+			return PoseMatch
+				{ entry.theId, std::sqrt(dd.first), angleFromChordSq(chordSq) };
+		}
+
+		//! Merge pending entries with trees not larger than result (serially)
+		inline
+		void
+		mergePending
+			()
+		{
+			Tree tree;
+			tree.theEntries.swap(thePending);
+			while (! theTrees.empty())
+			{
+				std::vector<Entry> const & entries = theTrees.back().theEntries;
+				if (tree.theEntries.size() < entries.size())
+				{
+					break;
+				}
+				tree.theEntries.insert
+					(tree.theEntries.end(), entries.cbegin(), entries.cend());
+				theTrees.pop_back();
+			}
+			buildTree(&tree, nullptr);
+			theTrees.emplace_back(std::move(tree));
+		}
+
+	public:
+
+		//! Empty index (positive angleScale: ref class description)
+		inline
+		explicit
+		PoseIndex
+			( double const & angleScale = 1.
+			)
+			: theAngleScale{ angleScale }
+		{ }
+
+		/*! Bulk load poses (ids 0,1,...) with tree built using pool.
+		 *
+		 * Null poses are assigned ids but are not indexed (they never
+		 * appear in query results).
+		 */
+		inline
+		explicit
+		PoseIndex
+			( ThreadPool & pool
+			, Transform const * const poses
+			, std::size_t const & numPoses
+			, double const & angleScale = 1.
+			)
+			: theAngleScale{ angleScale }
+		{
+			Tree tree;
+			tree.theEntries.reserve(numPoses);
+			for (std::size_t nn{0u} ; nn < numPoses ; ++nn)
+			{
+				if (isValid(poses[nn]))
+				{
+					tree.theEntries.emplace_back
+						(Entry{ coordsFor(poses[nn]), nn });
+				}
+			}
+			theSize = numPoses;
+			if (! tree.theEntries.empty())
+			{
+				buildTree(&tree, &pool);
+				theTrees.emplace_back(std::move(tree));
+			}
+		}
+
+		//! Number of poses added (including null ones)
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theSize;
+		}
+
+		/*! Add pose to index and return its id (amortized O(log^2 n)).
+		 *
+		 * If the pending buffer is full, it is merged (serially) with
+		 * the trees that are not larger than the merged result. This
+		 * occasionally rebuilds a tree with (nearly) all entries at
+		 * O(n log n) cost: e.g. a tree of m entries (from bulk load
+		 * or rebuild()) is merged after approximately m inserts.
+		 */
+		inline
+		std::size_t
+		insert
+			( Transform const & pose
+			)
+		{
+			std::size_t const id{ theSize++ };
+			if (isValid(pose))
+			{
+				thePending.emplace_back(Entry{ coordsFor(pose), id });
+				if (! (thePending.size() < sMaxPending))
+				{
+					mergePending();
+				}
+			}
+			return id;
+		}
+
+		//! Merge all entries into a single tree (multi-threaded if ptPool)
+		inline
+		void
+		rebuild
+			( ThreadPool * const & ptPool
+			)
+		{
+			if ((1u < theTrees.size()) || (! thePending.empty()))
+			{
+				Tree tree;
+				tree.theEntries.swap(thePending);
+				for (Tree const & each : theTrees)
+				{
+					tree.theEntries.insert
+						( tree.theEntries.end()
+						, each.theEntries.cbegin(), each.theEntries.cend()
+						);
+				}
+				theTrees.clear();
+				buildTree(&tree, ptPool);
+				theTrees.emplace_back(std::move(tree));
+			}
+		}
+
+		/*! Poses within maxDistance and maxAngle of query (sorted by id).
+		 *
+		 * Example:
+		 * \snippet test_poseindex.cpp DoxyExample01
+		 */
+		inline
+		std::vector<PoseMatch>
+		within
+			( Transform const & query
+			, double const & maxDistance
+			, double const & maxAngle
+			) const
+		{
+			std::vector<PoseMatch> matches;
+			if (! isValid(query))
+			{
+				return matches;
+			}
+			// chord (unscaled spinor) bound associated with maxAngle
+			double const useAngle{ std::min(maxAngle, engabra::g3::pi) };
+			double const maxChord{ 2. * std::sin(.25 * useAngle) };
+			double const spinScale{ 2. * theAngleScale };
+			double const invScaleSq{ 1. / (spinScale * spinScale) };
+			Coords const coQuery{ coordsFor(query) };
+			for (double const & spinSign : { 1., -1. })
+			{
+				RadiusQuery rq
+					{ coQuery
+					, spinSign
+					, maxDistance
+					, spinScale * maxChord
+					, maxChord * maxChord
+					, &matches
+					};
+				for (std::size_t kk{3u} ; kk < 7u ; ++kk)
+				{
+					rq.theCoords[kk] = spinSign * coQuery[kk];
+				}
+				for (Tree const & tree : theTrees)
+				{
+					radiusSearch
+						(rq, tree, 0u, tree.theEntries.size(), invScaleSq);
+				}
+				for (Entry const & entry : thePending)
+				{
+					radiusTest(rq, entry, invScaleSq);
+				}
+			}
+			std::sort
+				( matches.begin(), matches.end()
+				, [] (PoseMatch const & m1, PoseMatch const & m2)
+					{ return m1.theId < m2.theId; }
+				);
+			return matches;
+		}
+
+		/*! The numNear poses closest to query (sorted by increasing metric).
+		 *
+		 * Proximity metric includes both location and attitude (with
+		 * relative weighting by angleScale - ref class description).
+		 */
+		inline
+		std::vector<PoseMatch>
+		nearest
+			( Transform const & query
+			, std::size_t const & numNear
+			) const
+		{
+			std::vector<PoseMatch> matches;
+			if ((! isValid(query)) || (0u == numNear))
+			{
+				return matches;
+			}
+			Coords const coQuery{ coordsFor(query) };
+			Heap heap;
+			for (double const & spinSign : { 1., -1. })
+			{
+				Coords coSigned{ coQuery };
+				for (std::size_t kk{3u} ; kk < 7u ; ++kk)
+				{
+					coSigned[kk] = spinSign * coQuery[kk];
+				}
+				for (Tree const & tree : theTrees)
+				{
+					nearestSearch
+						( coSigned, spinSign, numNear
+						, tree, 0u, tree.theEntries.size(), &heap
+						);
+				}
+				for (Entry const & entry : thePending)
+				{
+					nearestTest(coSigned, spinSign, entry, numNear, &heap);
+				}
+			}
+
+			// heap top is farthest: fill result from the back
+			matches.resize(heap.size());
+			for (std::size_t nn{matches.size()} ; 0u < nn ; --nn)
+			{
+				matches[nn - 1u] = matchFor(coQuery, *(heap.top().second));
+				heap.pop();
+			}
+			return matches;
+		}
+
+	}; // PoseIndex
+
+} // [rigibra]
+
+
+#endif // Rigibra_poseindex_INCL_
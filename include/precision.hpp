@@ -0,0 +1,345 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_precision_INCL_
+#define Rigibra_precision_INCL_
+
+/*! \file
+\brief Contains reduced (or other) precision storage of rigibra types.
+
+Example:
+\snippet test_precision.cpp DoxyExample01
+
+*/
+
+
+#include "fast.hpp"
+#include "type.hpp"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+
+
+namespace rigibra
+{
+
+	/*! \brief Attitude stored with Real precision values.
+	 *
+	 * The rigibra types (Attitude, Transform, ...) are expressed with
+	 * engabra::g3 types which use double precision throughout. This
+	 * (and BasicTransform) provide compact storage with other (e.g.
+	 * float) precision. Values are converted to/from double precision
+	 * for general computation, and transformation of Real precision
+	 * point data (ref apply() below) is performed with a rotation
+	 * matrix evaluated in double precision and rounded to Real.
+	 */
+	template <typename Real>
+	struct BasicAttitude
+	{
+		//! SpinAngle bivector components (e23, e31, e12): default is null.
+		std::array<Real, 3u> theSpinAngle
+			{ std::numeric_limits<Real>::quiet_NaN()
+			, std::numeric_limits<Real>::quiet_NaN()
+			, std::numeric_limits<Real>::quiet_NaN()
+			};
+
+		//! Instance with values (rounded) from att.
+		inline
+		static
+		BasicAttitude
+		from
+			( Attitude const & att
+			)
+		{
+			engabra::g3::BiVector const & biv = att.spinAngle().theBiv;
+			return BasicAttitude
+				{ { static_cast<Real>(biv[0])
+				  , static_cast<Real>(biv[1])
+				  , static_cast<Real>(biv[2])
+				} };
+		}
+
+		//! Equivalent (double precision) Attitude.
+		inline
+		Attitude
+		attitude
+			() const
+		{
+			return Attitude(SpinAngle{ engabra::g3::BiVector
+				{ static_cast<double>(theSpinAngle[0])
+				, static_cast<double>(theSpinAngle[1])
+				, static_cast<double>(theSpinAngle[2])
+				} });
+		}
+
+		//! True if components are valid (same sense as Attitude::isValid()).
+		inline
+		bool
+		isValid
+			() const
+		{
+			using engabra::g3::isValid;
+			return
+				(  isValid(static_cast<double>(theSpinAngle[0]))
+				&& isValid(static_cast<double>(theSpinAngle[1]))
+				&& isValid(static_cast<double>(theSpinAngle[2]))
+				);
+		}
+
+	}; // BasicAttitude
+
+	/*! \brief Transform stored with Real precision values.
+	 *
+	 * E.g. TransformF uses 24 bytes (vs 48 bytes for Transform).
+	 *
+	 * Example:
+	 * \snippet test_precision.cpp DoxyExample01
+	 */
+	template <typename Real>
+	struct BasicTransform
+	{
+		//! Location components (e1, e2, e3): default is null.
+		std::array<Real, 3u> theLoc
+			{ std::numeric_limits<Real>::quiet_NaN()
+			, std::numeric_limits<Real>::quiet_NaN()
+			, std::numeric_limits<Real>::quiet_NaN()
+			};
+
+		//! Attitude (with Real precision components).
+		BasicAttitude<Real> theAtt;
+
+		//! Instance with values (rounded) from xfm.
+		inline
+		static
+		BasicTransform
+		from
+			( Transform const & xfm
+			)
+		{
+			return BasicTransform
+				{ { static_cast<Real>(xfm.theLoc[0])
+				  , static_cast<Real>(xfm.theLoc[1])
+				  , static_cast<Real>(xfm.theLoc[2])
+				  }
+				, BasicAttitude<Real>::from(xfm.theAtt)
+				};
+		}
+
+		//! Equivalent (double precision) Transform.
+		inline
+		Transform
+		transform
+			() const
+		{
+			return Transform
+				{ Location
+					{ static_cast<double>(theLoc[0])
+					, static_cast<double>(theLoc[1])
+					, static_cast<double>(theLoc[2])
+					}
+				, theAtt.attitude()
+				};
+		}
+
+		//! True if components are valid (same sense as Transform::isValid()).
+		inline
+		bool
+		isValid
+			() const
+		{
+			using engabra::g3::isValid;
+			return
+				(  isValid(static_cast<double>(theLoc[0]))
+				&& isValid(static_cast<double>(theLoc[1]))
+				&& isValid(static_cast<double>(theLoc[2]))
+				&& theAtt.isValid()
+				);
+		}
+
+	}; // BasicTransform
+
+	//! Single precision attitude storage
+	using AttitudeF = BasicAttitude<float>;
+
+	//! Single precision transform storage
+	using TransformF = BasicTransform<float>;
+
+	//! Conversion between precisions (e.g. TransformF to BasicTransform<double>)
+	template <typename ToReal, typename FromReal>
+	inline
+	BasicAttitude<ToReal>
+	precisionCast
+		( BasicAttitude<FromReal> const & att
+		)
+	{
+		return BasicAttitude<ToReal>
+			{ { static_cast<ToReal>(att.theSpinAngle[0])
+			  , static_cast<ToReal>(att.theSpinAngle[1])
+			  , static_cast<ToReal>(att.theSpinAngle[2])
+			} };
+	}
+
+	//! Conversion between precisions (e.g. TransformF to BasicTransform<double>)
+	template <typename ToReal, typename FromReal>
+	inline
+	BasicTransform<ToReal>
+	precisionCast
+		( BasicTransform<FromReal> const & xfm
+		)
+	{
+		return BasicTransform<ToReal>
+			{ { static_cast<ToReal>(xfm.theLoc[0])
+			  , static_cast<ToReal>(xfm.theLoc[1])
+			  , static_cast<ToReal>(xfm.theLoc[2])
+			  }
+			, precisionCast<ToReal>(xfm.theAtt)
+			};
+	}
+
+	//! True if instance is not null
+	template <typename Real>
+	inline
+	bool
+	isValid
+		( BasicTransform<Real> const & xfm
+		)
+	{
+		return xfm.isValid();
+	}
+
+	/*! Transform numPnts Real precision points (SoA layout).
+	 *
+	 * Same as func.hpp apply() for double precision data, but
+	 * with Real (e.g. float) input and output arrays. The rotation
+	 * matrix and location are evaluated in double precision then
+	 * rounded to Real for the (auto-vectorizable) loop. For float
+	 * data, this halves memory traffic and doubles the number of
+	 * values per vector register compared to double data.
+	 *
+	 * Example:
+	 * \snippet test_precision.cpp DoxyExample01
+	 */
+	template <typename Real>
+	inline
+	void
+	apply
+		( Transform const & xfm
+		, Real const * const xIn
+		, Real const * const yIn
+		, Real const * const zIn
+		, std::size_t const & numPnts
+		, Real * const xOut
+		, Real * const yOut
+		, Real * const zOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numPnts);
+		FastTransform const fastXfm(xfm);
+		std::array<double, 9u> const & mat = fastXfm.theAtt.matrix();
+		Real const m00{ static_cast<Real>(mat[0]) };
+		Real const m01{ static_cast<Real>(mat[1]) };
+		Real const m02{ static_cast<Real>(mat[2]) };
+		Real const m10{ static_cast<Real>(mat[3]) };
+		Real const m11{ static_cast<Real>(mat[4]) };
+		Real const m12{ static_cast<Real>(mat[5]) };
+		Real const m20{ static_cast<Real>(mat[6]) };
+		Real const m21{ static_cast<Real>(mat[7]) };
+		Real const m22{ static_cast<Real>(mat[8]) };
+		Real const t0{ static_cast<Real>(fastXfm.theLoc[0]) };
+		Real const t1{ static_cast<Real>(fastXfm.theLoc[1]) };
+		Real const t2{ static_cast<Real>(fastXfm.theLoc[2]) };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			Real const d0{ xIn[nn] - t0 };
+			Real const d1{ yIn[nn] - t1 };
+			Real const d2{ zIn[nn] - t2 };
+			xOut[nn] = m00*d0 + m01*d1 + m02*d2;
+			yOut[nn] = m10*d0 + m11*d1 + m12*d2;
+			zOut[nn] = m20*d0 + m21*d1 + m22*d2;
+		}
+	}
+
+	//! Transform Real precision SoA points with Real precision xfm.
+	template <typename Real>
+	inline
+	void
+	apply
+		( BasicTransform<Real> const & xfm
+		, Real const * const xIn
+		, Real const * const yIn
+		, Real const * const zIn
+		, std::size_t const & numPnts
+		, Real * const xOut
+		, Real * const yOut
+		, Real * const zOut
+		)
+	{
+		apply(xfm.transform(), xIn, yIn, zIn, numPnts, xOut, yOut, zOut);
+	}
+
+	//! Transform numPnts Real precision points (AoS layout).
+	template <typename Real>
+	inline
+	void
+	apply
+		( Transform const & xfm
+		, std::array<Real, 3u> const * const pntsIn
+		, std::size_t const & numPnts
+		, std::array<Real, 3u> * const pntsOut
+		)
+	{
+		Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numPnts);
+		FastTransform const fastXfm(xfm);
+		std::array<double, 9u> const & dMat = fastXfm.theAtt.matrix();
+		std::array<Real, 9u> mat;
+		for (std::size_t kk{0u} ; kk < 9u ; ++kk)
+		{
+			mat[kk] = static_cast<Real>(dMat[kk]);
+		}
+		std::array<Real, 3u> const loc
+			{ static_cast<Real>(fastXfm.theLoc[0])
+			, static_cast<Real>(fastXfm.theLoc[1])
+			, static_cast<Real>(fastXfm.theLoc[2])
+			};
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			std::array<Real, 3u> const & pnt = pntsIn[nn];
+			Real const d0{ pnt[0] - loc[0] };
+			Real const d1{ pnt[1] - loc[1] };
+			Real const d2{ pnt[2] - loc[2] };
+			pntsOut[nn] = std::array<Real, 3u>
+				{ mat[0]*d0 + mat[1]*d1 + mat[2]*d2
+				, mat[3]*d0 + mat[4]*d1 + mat[5]*d2
+				, mat[6]*d0 + mat[7]*d1 + mat[8]*d2
+				};
+		}
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_precision_INCL_
@@ -0,0 +1,367 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_ransac_INCL_
+#define Rigibra_ransac_INCL_
+
+/*! \file
+\brief Contains robust (RANSAC) Transform estimation from correspondences.
+
+Example:
+\snippet test_ransac.cpp DoxyExample01
+
+*/
+
+
+#include "fast.hpp"
+#include "fit.hpp"
+#include "pool.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace rigibra
+{
+
+	//! Control parameters for ransacTransform()
+	struct RansacOptions
+	{
+		//! Maximum distance, |into - xfm(from)|, for inlier pairs.
+		double theInlierDistance{ 1. };
+
+		//! Probability that at least one sample is outlier free.
+		double theConfidence{ .999 };
+
+		//! Upper limit on number of hypotheses (if adaptive count is large).
+		std::size_t theMaxHypotheses{ 100u * 1000u };
+
+		//! Hypotheses generated (concurrently) between adaptive updates.
+		std::size_t theRoundSize{ 64u };
+
+		//! Seed for (deterministic) sample selection.
+		std::uint64_t theSeed{ 0u };
+
+	}; // RansacOptions
+
+
+	//! Result of ransacTransform()
+	struct RansacResult
+	{
+		//! Transform fit to all inliers (null if no consensus found).
+		Transform theXfm{ null<Transform>() };
+
+		//! Indices of pairs consistent with theXfm (in increasing order).
+		std::vector<std::size_t> theInliers{};
+
+		//! Number of hypotheses generated (and scored).
+		std::size_t theNumHypotheses{ 0u };
+
+	}; // RansacResult
+
+
+namespace detail
+{
+	/*! True if |into - mat*(from - loc)| <= maxDist (w/ maxDistSq).
+	 *
+	 * Used for all inlier tests (scoring and selection) such that
+	 * pairs at the threshold are classified identically.
+	 */
+	inline
+	bool
+	isInlier
+		( std::array<double, 9u> const & mat
+		, engabra::g3::Vector const & loc
+		, engabra::g3::Vector const & from
+		, engabra::g3::Vector const & into
+		, double const & maxDistSq
+		)
+	{
+		double const x0{ from[0] - loc[0] };
+		double const x1{ from[1] - loc[1] };
+		double const x2{ from[2] - loc[2] };
+		double const d0{ into[0] - (mat[0]*x0 + mat[1]*x1 + mat[2]*x2) };
+		double const d1{ into[1] - (mat[3]*x0 + mat[4]*x1 + mat[5]*x2) };
+		double const d2{ into[2] - (mat[6]*x0 + mat[7]*x1 + mat[8]*x2) };
+		return ((d0*d0 + d1*d1 + d2*d2) <= maxDistSq);
+	}
+
+} // [detail]
+
+	/*! Number of pairs for which |intos[nn] - xfm(froms[nn])| <= maxDist.
+	 *
+	 * Scoring uses the precomputed rotation matrix (9 multiplies and
+	 * 6 adds per point) and no exponential evaluations. If the count
+	 * can no longer reach stopBelow (given the pairs remaining), scoring
+	 * stops early and the (partial) count is returned.
+	 */
+	inline
+	std::size_t
+	countInliers
+		( FastTransform const & xfm
+		, engabra::g3::Vector const * const froms
+		, engabra::g3::Vector const * const intos
+		, std::size_t const & numPairs
+		, double const & maxDist
+		, std::size_t const & stopBelow = 0u
+		)
+	{
+		std::array<double, 9u> const mat{ xfm.theAtt.matrix() };
+		engabra::g3::Vector const loc{ xfm.theLoc };
+		double const maxDistSq{ maxDist * maxDist };
+		constexpr std::size_t blockSize{ 1024u };
+		std::size_t count{ 0u };
+		for (std::size_t beg{0u} ; beg < numPairs ; beg += blockSize)
+		{
+			if ((count + (numPairs - beg)) < stopBelow)
+			{
+				break;
+			}
+			std::size_t const end{ std::min(numPairs, beg + blockSize) };
+			for (std::size_t nn{beg} ; nn < end ; ++nn)
+			{
+				bool const isIn
+					{ detail::isInlier(mat, loc, froms[nn], intos[nn], maxDistSq) };
+				count += isIn ? 1u : 0u;
+			}
+		}
+		return count;
+	}
+
+	/*! Pseudo-random index in [0,numItems) for sample slot of hypothesis.
+	 *
+	 * Stateless (splitmix64 hash) such that each hypothesis is
+	 * reproducible independent of which thread generates it.
+	 */
+	inline
+	std::size_t
+	ransacSampleIndex
+		( std::uint64_t const & seed
+		, std::uint64_t const & hypNdx
+		, std::uint64_t const & slot
+		, std::size_t const & numItems
+		)
+	{
+		std::uint64_t zz{ seed + 0x9e3779b97f4a7c15u * (4u*hypNdx + slot + 1u) };
+		zz = (zz ^ (zz >> 30u)) * 0xbf58476d1ce4e5b9u;
+		zz = (zz ^ (zz >> 27u)) * 0x94d049bb133111ebu;
+		zz = zz ^ (zz >> 31u);
+		return static_cast<std::size_t>(zz % numItems);
+	}
+
+	/*! Transform from minimal sample of three (distinct) correspondences.
+	 *
+	 * Null if the solution is not unique (e.g. collinear points - ref
+	 * FitAccumulator::spinorTransform()).
+	 */
+	inline
+	Transform
+	transformFrom3
+		( engabra::g3::Vector const * const froms
+		, engabra::g3::Vector const * const intos
+		, std::array<std::size_t, 3u> const & ndxs
+		)
+	{
+		FitAccumulator accum;
+		for (std::size_t const & ndx : ndxs)
+		{
+			accum.add(froms[ndx], intos[ndx]);
+		}
+		return accum.transform();
+	}
+
+	/*! Robust Transform estimation such that intos[nn] ~= xfm(froms[nn]).
+	 *
+	 * Random sample consensus (RANSAC) with:
+	 * \arg Minimal samples of three pairs solved in closed form
+	 *      (ref transformFrom3()).
+	 * \arg Hypotheses generated and scored concurrently by pool
+	 *      threads (in rounds of options.theRoundSize).
+	 * \arg Adaptive termination: after each round the number of
+	 *      hypotheses needed (for options.theConfidence) is updated
+	 *      from the best inlier fraction found so far.
+	 * \arg Scoring with precomputed rotation (ref countInliers()) that
+	 *      stops early for hypotheses that cannot beat the best.
+	 *
+	 * The result is refit (ref FitAccumulator) to all inliers of the
+	 * best hypothesis. Results are deterministic for a given seed
+	 * (independent of number of threads).
+	 *
+	 * Example:
+	 * \snippet test_ransac.cpp DoxyExample01
+	 */
+	inline
+	RansacResult
+	ransacTransform
+		( ThreadPool & pool
+		, engabra::g3::Vector const * const froms
+		, engabra::g3::Vector const * const intos
+		, std::size_t const & numPairs
+		, RansacOptions const & options = {}
+		)
+	{
+		RansacResult result;
+		if (numPairs < 3u)
+		{
+			return result;
+		}
+		double const & maxDist = options.theInlierDistance;
+		std::size_t const roundSize
+			{ std::max(std::size_t{ 1u }, options.theRoundSize) };
+		double const logFail
+			{ std::log(1. - std::min(options.theConfidence, 1. - 1.e-15)) };
+
+		std::size_t numNeeded{ options.theMaxHypotheses };
+		std::size_t bestCount{ 0u };
+		Transform bestXfm{ null<Transform>() };
+		std::vector<Transform> xfms(roundSize);
+		std::vector<std::size_t> counts(roundSize);
+		std::size_t numDone{ 0u };
+		while (numDone < numNeeded)
+		{
+			std::size_t const numHyps{ std::min(roundSize, numNeeded - numDone) };
+			std::size_t const stopBelow{ bestCount };
+			pool.parallelFor
+				( numHyps
+				, 1u
+				, [&] (std::size_t const & beg, std::size_t const & end)
+					{
+						for (std::size_t nn{beg} ; nn < end ; ++nn)
+						{
+							std::uint64_t const hypNdx{ numDone + nn };
+							std::array<std::size_t, 3u> ndxs;
+							for (std::uint64_t slot{0u} ; slot < 3u ; ++slot)
+							{
+								ndxs[slot] = ransacSampleIndex
+									(options.theSeed, hypNdx, slot, numPairs);
+							}
+							counts[nn] = 0u;
+							xfms[nn] = null<Transform>();
+							if ( (ndxs[0] == ndxs[1])
+							  || (ndxs[0] == ndxs[2])
+							  || (ndxs[1] == ndxs[2])
+							   )
+							{
+								continue;
+							}
+							Transform const xfm
+								{ transformFrom3(froms, intos, ndxs) };
+							if (isValid(xfm))
+							{
+								xfms[nn] = xfm;
+								counts[nn] = countInliers
+									( FastTransform(xfm), froms, intos, numPairs
+									, maxDist, stopBelow
+									);
+							}
+						}
+					}
+				);
+			numDone += numHyps;
+
+			// best in (hypothesis) order - same for any thread count
+			bool improved{ false };
+			for (std::size_t nn{0u} ; nn < numHyps ; ++nn)
+			{
+				if (bestCount < counts[nn])
+				{
+					bestCount = counts[nn];
+					bestXfm = xfms[nn];
+					improved = true;
+				}
+			}
+			if (improved)
+			{
+				double const inFrac
+					{ static_cast<double>(bestCount)
+					/ static_cast<double>(numPairs)
+					};
+				double const logGood{ std::log1p(-inFrac * inFrac * inFrac) };
+				double needed{ 0. };
+				if (logGood < 0.)
+				{
+					needed = std::ceil(logFail / logGood);
+				}
+				numNeeded = static_cast<std::size_t>(std::min
+					(needed, static_cast<double>(options.theMaxHypotheses)));
+			}
+		}
+		result.theNumHypotheses = numDone;
+		if (! isValid(bestXfm))
+		{
+			return result;
+		}
+
+		// refit to all inliers (keep hypothesis if refit is worse)
+		double const maxDistSq{ maxDist * maxDist };
+		FastTransform const fastBest(bestXfm);
+		std::array<double, 9u> const matBest{ fastBest.theAtt.matrix() };
+		FitAccumulator accum;
+		for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+		{
+			if (detail::isInlier
+				(matBest, fastBest.theLoc, froms[nn], intos[nn], maxDistSq))
+			{
+				accum.add(froms[nn], intos[nn]);
+			}
+		}
+		Transform const refitXfm{ accum.transform() };
+		Transform useXfm{ bestXfm };
+		if (isValid(refitXfm))
+		{
+			std::size_t const refitCount
+				{ countInliers
+					(FastTransform(refitXfm), froms, intos, numPairs, maxDist)
+				};
+			if (! (refitCount < bestCount))
+			{
+				useXfm = refitXfm;
+			}
+		}
+		FastTransform const fastUse(useXfm);
+		std::array<double, 9u> const matUse{ fastUse.theAtt.matrix() };
+		for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+		{
+			if (detail::isInlier
+				(matUse, fastUse.theLoc, froms[nn], intos[nn], maxDistSq))
+			{
+				result.theInliers.emplace_back(nn);
+			}
+		}
+		result.theXfm = useXfm;
+		return result;
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_ransac_INCL_
@@ -0,0 +1,128 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_simd_INCL_
+#define Rigibra_simd_INCL_
+
+/*! \file
+\brief Contains explicit SIMD kernels for batch transformation of points.
+
+Example:
+\snippet test_simd.cpp DoxyExample01
+
+*/
+
+
+#include "type.hpp"
+
+#include <cstddef>
+#include <string>
+
+
+namespace rigibra
+{
+
+/*! \brief Explicit vector instruction implementations of batch operations.
+ *
+ * Kernels are compiled for several x86 instruction set extensions
+ * within a single library build. The implementation used by default
+ * is selected at run time (once) from CPU feature detection so that
+ * the same binary runs on older and newer processors.
+ *
+ * On non-x86 platforms (or with compilers that do not support
+ * function target attributes) only the Isa::Scalar kernel exists.
+ */
+namespace simd
+{
+	//! Instruction set used by a kernel
+	enum class Isa
+	{
+		  Scalar //!< Portable C++ (compiler may still auto-vectorize)
+		, SSE2 //!< 2 points per instruction
+		, AVX2 //!< 4 points per instruction (with FMA)
+		, AVX512 //!< 8 points per instruction (AVX-512F)
+	};
+
+	//! Name of instruction set (e.g. for reporting)
+	std::string
+	nameFor
+		( Isa const & isa
+		);
+
+	//! True if isa is compiled into library and supported by this CPU
+	bool
+	isSupported
+		( Isa const & isa
+		);
+
+	//! Most capable instruction set supported (used by dispatch).
+	Isa
+	bestIsa
+		();
+
+	/*! Transform SoA points using the kernel for specified isa.
+	 *
+	 * Arguments are the same as for rigibra::apply() SoA overload
+	 * (in func.hpp). If isa is not supported, the Isa::Scalar kernel
+	 * is used.
+	 */
+	void
+	apply
+		( Isa const & isa
+		, Transform const & xfm
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		);
+
+	//! Transform SoA points using kernel for bestIsa().
+	inline
+	void
+	apply
+		( Transform const & xfm
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		static Isa const isa{ bestIsa() };
+		apply(isa, xfm, xIn, yIn, zIn, numPnts, xOut, yOut, zOut);
+	}
+
+} // [simd]
+
+} // [rigibra]
+
+
+#endif // Rigibra_simd_INCL_
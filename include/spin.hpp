@@ -0,0 +1,137 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_spin_INCL_
+#define Rigibra_spin_INCL_
+
+/*! \file
+\brief Contains closed-form exponential and logarithm for unit spinors.
+
+Example:
+\snippet test_spin.cpp DoxyExample01
+
+*/
+
+
+#include <Engabra>
+
+#include <cmath>
+
+
+namespace rigibra
+{
+
+	/*! \brief Magnitude below which small-angle series are used.
+	 *
+	 * At this size, the first omitted series terms are of order
+	 * 1.e-24 (relative) and therefore well below double precision.
+	 */
+	constexpr double sSpinSmallMag{ 1.e-4 };
+
+	/*! Unit spinor from spin angle bivector (i.e. exp(spinBiv)).
+	 *
+	 * Specialized version of engabra::g3::exp() for pure bivector
+	 * argument: requires one sqrt and one sin/cos evaluation. For
+	 * small angles, a series expansion is used instead.
+	 *
+	 * Null (NaN) input values produce null output.
+	 */
+	inline
+	engabra::g3::Spinor
+	spinExp
+		( engabra::g3::BiVector const & spinBiv
+		)
+	{
+		double const & b0 = spinBiv[0];
+		double const & b1 = spinBiv[1];
+		double const & b2 = spinBiv[2];
+		double const magSq{ b0*b0 + b1*b1 + b2*b2 };
+		double cosMag;
+		double sincMag;
+		if (magSq < (sSpinSmallMag * sSpinSmallMag))
+		{
+			cosMag = 1. - magSq * (1./2. - magSq * (1./24.));
+			sincMag = 1. - magSq * (1./6. - magSq * (1./120.));
+		}
+		else
+		{
+			double const mag{ std::sqrt(magSq) };
+			cosMag = std::cos(mag);
+			sincMag = std::sin(mag) / mag;
+		}
+		return engabra::g3::Spinor
+			{ cosMag, sincMag * b0, sincMag * b1, sincMag * b2 };
+	}
+
+	/*! Spin angle bivector from spinor (i.e. bivector part of log(spin)).
+	 *
+	 * Specialized version of engabra::g3::logG2() returning only the
+	 * bivector (angle) part: requires one sqrt and one atan2. The
+	 * spinor need not be unit magnitude (only its direction is used).
+	 * The returned angle magnitude is in the range [0, pi].
+	 *
+	 * For a spinor with zero bivector part and negative scalar part
+	 * (physical rotation of a full turn), the plane is undefined and
+	 * a zero bivector is returned.
+	 *
+	 * Null (NaN) input values produce null output.
+	 */
+	inline
+	engabra::g3::BiVector
+	spinLog
+		( engabra::g3::Spinor const & spin
+		)
+	{
+		double const & ww = spin.theSca[0];
+		double const & b0 = spin.theBiv[0];
+		double const & b1 = spin.theBiv[1];
+		double const & b2 = spin.theBiv[2];
+		double const magSq{ b0*b0 + b1*b1 + b2*b2 };
+		double const mag{ std::sqrt(magSq) };
+		double scale;
+		if ((0. < ww) && (mag < (sSpinSmallMag * ww)))
+		{
+			// atan(mag/ww)/mag series in ratio (mag/ww)
+			double const ratioSq{ magSq / (ww * ww) };
+			scale = (1. - ratioSq * (1./3. - ratioSq * (1./5.))) / ww;
+		}
+		else
+		if (0. == mag)
+		{
+			// zero bivector, but keep null scalar (e.g. {NaN,0,0,0}) null
+			scale = std::isnan(ww) ? ww : 0.;
+		}
+		else
+		{
+			scale = std::atan2(mag, ww) / mag;
+		}
+		return engabra::g3::BiVector{ scale * b0, scale * b1, scale * b2 };
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_spin_INCL_
@@ -0,0 +1,133 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_stream_INCL_
+#define Rigibra_stream_INCL_
+
+/*! \file
+\brief Contains chunked (streaming) transformation of point data.
+
+Example:
+\snippet test_stream.cpp DoxyExample01
+
+*/
+
+
+#include "pool.hpp"
+#include "type.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <ostream>
+
+
+namespace rigibra
+{
+
+	/*! \brief Default number of points in each chunk of a stream.
+	 *
+	 * Each point uses 24 bytes such that the three chunk buffers in
+	 * use by transformStream() require approximately 4.7MB.
+	 */
+	constexpr std::size_t sStreamChunkSize{ 64u * 1024u };
+
+	/*! \brief Function providing Transform for a chunk of points.
+	 *
+	 * Arguments are the chunk index and the (stream) index of the
+	 * first point in the chunk. E.g. a function may return a pose
+	 * from a Trajectory for the time associated with the chunk.
+	 */
+	using ChunkTransformFunc = std::function
+		<Transform(std::size_t const & chunkNdx, std::size_t const & pntNdx)>;
+
+	/*! Transform binary point data from istrm into ostrm (in chunks).
+	 *
+	 * Point data are binary (native byte order) double values
+	 * (x,y,z) with 24 bytes per point. Points are read in chunks of
+	 * chunkSize points and each chunk is transformed by the Transform
+	 * returned from xfmForChunk.
+	 *
+	 * Reading, transformation and writing are overlapped: while a
+	 * chunk is transformed, the next chunk is read and the previous
+	 * chunk is written (each as a task run by pool threads). The
+	 * xfmForChunk function is called only from the calling thread.
+	 * Memory use is bounded by three chunk buffers regardless of
+	 * stream size.
+	 *
+	 * Returns the number of points transformed and successfully
+	 * written (a chunk with a failed write is not counted). A
+	 * trailing partial point record in istrm is ignored. Write
+	 * errors are also indicated by the state of ostrm.
+	 *
+	 * Example:
+	 * \snippet test_stream.cpp DoxyExample01
+	 */
+	std::size_t
+	transformStream
+		( ThreadPool & pool
+		, std::istream & istrm
+		, std::ostream & ostrm
+		, ChunkTransformFunc const & xfmForChunk
+		, std::size_t const & chunkSize = sStreamChunkSize
+		);
+
+	//! Transform points from istrm into ostrm (using defaultPool()).
+	inline
+	std::size_t
+	transformStream
+		( std::istream & istrm
+		, std::ostream & ostrm
+		, ChunkTransformFunc const & xfmForChunk
+		, std::size_t const & chunkSize = sStreamChunkSize
+		)
+	{
+		return transformStream
+			(defaultPool(), istrm, ostrm, xfmForChunk, chunkSize);
+	}
+
+	//! Transform all points from istrm into ostrm with the same xfm.
+	inline
+	std::size_t
+	transformStream
+		( std::istream & istrm
+		, std::ostream & ostrm
+		, Transform const & xfm
+		, std::size_t const & chunkSize = sStreamChunkSize
+		)
+	{
+		return transformStream
+			( istrm
+			, ostrm
+			, [&xfm] (std::size_t const &, std::size_t const &) { return xfm; }
+			, chunkSize
+			);
+	}
+
+} // [rigibra]
+
+
+#endif // Rigibra_stream_INCL_
@@ -0,0 +1,442 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+#ifndef Rigibra_trajectory_INCL_
+#define Rigibra_trajectory_INCL_
+
+/*! \file
+\brief Contains Trajectory for time-dependent (interpolated) transforms.
+
+Example:
+\snippet test_trajectory.cpp DoxyExample01
+
+*/
+
+
+#include "spin.hpp"
+#include "type.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+namespace rigibra
+{
+
+	/*! \brief Time-ordered Transform samples with interpolated lookup.
+	 *
+	 * Transforms between sample times are interpolated along the
+	 * geodesic: linearly for location and by spherical linear
+	 * interpolation (slerp) for attitude. I.e. for fraction f
+	 * between sample (nn) and sample (nn+1)
+	 * \arg loc(f) = (1-f)*loc[nn] + f*loc[nn+1]
+	 * \arg spin(f) = spin[nn] * exp(f * log(reverse(spin[nn])*spin[nn+1]))
+	 *
+	 * The spinor for each sample and the logarithm for each interval
+	 * are evaluated when samples are inserted. Each lookup therefore
+	 * requires a single exponential (plus a logarithm if a Transform,
+	 * rather than SpinorTransform, is returned).
+	 *
+	 * Lookups locate the bracketing interval starting from a Cursor
+	 * (the interval used by the previous lookup). For monotone time
+	 * sequences (e.g. lidar returns or image rows) this is O(1) per
+	 * query. Otherwise, binary search provides O(log(size())).
+	 *
+	 * Times outside of [timeBeg(), timeEnd()] produce null results.
+	 *
+	 * Example:
+	 * \snippet test_trajectory.cpp DoxyExample01
+	 */
+	class Trajectory
+	{
+	public:
+
+		//! Index of interval from most recent lookup (for next lookup).
+		struct Cursor
+		{
+			//! Index of first sample in bracketing interval.
+			std::size_t theNdx{ 0u };
+		};
+
+	private:
+
+		//! Sample data with values precomputed for interpolation.
+		struct Knot
+		{
+			//! Transform as inserted
+			Transform theXfm;
+
+			//! Spinor for theXfm attitude
+			engabra::g3::Spinor theSpin;
+
+			//! Logarithm of (shortest) spinor ratio to the next knot.
+			engabra::g3::BiVector theLogDelta;
+		};
+
+		//! Sample times (contiguous for fast search).
+		std::vector<double> theTimes{};
+
+		//! Sample data (same order as theTimes).
+		std::vector<Knot> theKnots{};
+
+		//! Update theLogDelta for interval starting with knot at ndx.
+		inline
+		void
+		updateDelta
+			( std::size_t const & ndx
+			)
+		{
+			using namespace engabra::g3;
+			if ((ndx + 1u) < theKnots.size())
+			{
+				Spinor delta
+					{ reverse(theKnots[ndx].theSpin) * theKnots[ndx+1u].theSpin };
+				// use shorter path (-delta represents same attitude)
+				if (delta.theSca[0] < 0.)
+				{
+					delta = (-1.) * delta;
+				}
+				Rigibra_INSTRUMENT_SCOPE(SpinLog);
+				theKnots[ndx].theLogDelta = spinLog(delta);
+			}
+			else
+			if (ndx < theKnots.size())
+			{
+				theKnots[ndx].theLogDelta = zero<BiVector>();
+			}
+		}
+
+		/*! Index of sample at start of interval containing time.
+		 *
+		 * Returns theKnots.size() if time is not within the range
+		 * of samples (or is NaN). Updates cursor with result.
+		 */
+		inline
+		std::size_t
+		intervalFor
+			( double const & time
+			, Cursor * const & ptCursor
+			) const
+		{
+			std::size_t const numKnots{ theKnots.size() };
+			if (! ((1u < numKnots)
+				&& (theTimes.front() <= time) && (time <= theTimes.back())))
+			{
+				// single sample - only valid at exactly its time
+				if ((1u == numKnots) && (theTimes.front() == time))
+				{
+					return 0u;
+				}
+				return numKnots;
+			}
+
+			std::size_t const lastNdx{ numKnots - 2u };
+			std::size_t ndx{ std::min(ptCursor->theNdx, lastNdx) };
+			if (time < theTimes[ndx])
+			{
+				// earlier than cursor: search before it
+				std::vector<double>::const_iterator const itEnd
+					{ theTimes.cbegin() + ndx };
+				ndx = static_cast<std::size_t>
+					(std::upper_bound(theTimes.cbegin(), itEnd, time)
+					- theTimes.cbegin()) - 1u;
+			}
+			else
+			if (theTimes[ndx+1u] < time)
+			{
+				// later than cursor: check next interval, then search
+				++ndx;
+				if (theTimes[ndx+1u] < time)
+				{
+					std::vector<double>::const_iterator const itBeg
+						{ theTimes.cbegin() + ndx + 1u };
+					ndx = static_cast<std::size_t>
+						(std::upper_bound(itBeg, theTimes.cend(), time)
+						- theTimes.cbegin()) - 1u;
+				}
+			}
+			ndx = std::min(ndx, lastNdx);
+			ptCursor->theNdx = ndx;
+			return ndx;
+		}
+
+		/*! Interpolation within interval starting at sample ndx.
+		 *
+		 * Requires (ndx+1) < size() unless time is at sample ndx.
+		 */
+		inline
+		SpinorTransform
+		interpolated
+			( std::size_t const & ndx
+			, double const & time
+			) const
+		{
+			using namespace engabra::g3;
+			Knot const & knot0 = theKnots[ndx];
+			if (time == theTimes[ndx])
+			{
+				return SpinorTransform
+					{ knot0.theXfm.theLoc, SpinorAttitude(knot0.theSpin) };
+			}
+			Knot const & knot1 = theKnots[ndx + 1u];
+			double const frac
+				{ (time - theTimes[ndx])
+				/ (theTimes[ndx + 1u] - theTimes[ndx])
+				};
+			Location const loc
+				{ (1. - frac) * knot0.theXfm.theLoc
+				+ frac * knot1.theXfm.theLoc
+				};
+			Rigibra_INSTRUMENT_SCOPE(SpinExp);
+			Spinor const spin
+				{ knot0.theSpin * spinExp(frac * knot0.theLogDelta) };
+			return SpinorTransform{ loc, SpinorAttitude(spin) };
+		}
+
+	public:
+
+		//! Construct an empty trajectory (add samples with insert()).
+		Trajectory
+			() = default;
+
+		/*! Insert (or replace) sample at time.
+		 *
+		 * Samples may be inserted in any order, but appending in time
+		 * order is most efficient. A sample at an existing time
+		 * replaces the existing sample. Returns false (and makes no
+		 * change) if time or xfm is not valid.
+		 */
+		inline
+		bool
+		insert
+			( double const & time
+			, Transform const & xfm
+			)
+		{
+			if (! (engabra::g3::isValid(time) && rigibra::isValid(xfm)))
+			{
+				return false;
+			}
+
+			Knot const knot
+				{ xfm
+				, xfm.theAtt.spinor()
+				, engabra::g3::zero<engabra::g3::BiVector>()
+				};
+			std::vector<double>::iterator const itTime
+				{ std::lower_bound(theTimes.begin(), theTimes.end(), time) };
+			std::size_t const ndx
+				{ static_cast<std::size_t>(itTime - theTimes.begin()) };
+			if ((theTimes.end() != itTime) && (time == *itTime))
+			{
+				theKnots[ndx] = knot;
+			}
+			else
+			{
+				theTimes.insert(itTime, time);
+				theKnots.insert(theKnots.begin() + ndx, knot);
+			}
+
+			// update intervals ending and starting with the new sample
+			if (0u < ndx)
+			{
+				updateDelta(ndx - 1u);
+			}
+			updateDelta(ndx);
+			return true;
+		}
+
+		//! Number of samples
+		inline
+		std::size_t
+		size
+			() const
+		{
+			return theKnots.size();
+		}
+
+		//! True if no samples have been inserted.
+		inline
+		bool
+		empty
+			() const
+		{
+			return theKnots.empty();
+		}
+
+		//! Time of first sample (NaN if empty)
+		inline
+		double
+		timeBeg
+			() const
+		{
+			double time{ engabra::g3::null<double>() };
+			if (! theTimes.empty())
+			{
+				time = theTimes.front();
+			}
+			return time;
+		}
+
+		//! Time of last sample (NaN if empty)
+		inline
+		double
+		timeEnd
+			() const
+		{
+			double time{ engabra::g3::null<double>() };
+			if (! theTimes.empty())
+			{
+				time = theTimes.back();
+			}
+			return time;
+		}
+
+		//! Time of sample ndx (no bounds checking)
+		inline
+		double const &
+		time
+			( std::size_t const & ndx
+			) const
+		{
+			return theTimes[ndx];
+		}
+
+		//! Transform of sample ndx (no bounds checking)
+		inline
+		Transform const &
+		sample
+			( std::size_t const & ndx
+			) const
+		{
+			return theKnots[ndx].theXfm;
+		}
+
+		/*! Interpolated transform (as SpinorTransform) at time.
+		 *
+		 * Requires a single exponential evaluation (or none if time
+		 * is exactly at a sample). Updates cursor for the next call.
+		 */
+		inline
+		SpinorTransform
+		spinorTransformAt
+			( double const & time
+			, Cursor * const & ptCursor
+			) const
+		{
+			SpinorTransform xfm{ null<SpinorTransform>() };
+			std::size_t const ndx{ intervalFor(time, ptCursor) };
+			if (ndx < theKnots.size())
+			{
+				xfm = interpolated(ndx, time);
+			}
+			return xfm;
+		}
+
+		/*! Interpolated transform at time (ref spinorTransformAt()).
+		 *
+		 * Sample values are returned exactly if time is exactly at
+		 * a sample time.
+		 */
+		inline
+		Transform
+		at
+			( double const & time
+			, Cursor * const & ptCursor
+			) const
+		{
+			Transform xfm{ null<Transform>() };
+			std::size_t const ndx{ intervalFor(time, ptCursor) };
+			if (ndx < theKnots.size())
+			{
+				if (time == theTimes[ndx])
+				{
+					xfm = theKnots[ndx].theXfm;
+				}
+				else
+				if (time == theTimes[ndx + 1u])
+				{
+					xfm = theKnots[ndx + 1u].theXfm;
+				}
+				else
+				{
+					xfm = interpolated(ndx, time).transform();
+				}
+			}
+			return xfm;
+		}
+
+		//! Interpolated transform at time (binary search lookup).
+		inline
+		Transform
+		at
+			( double const & time
+			) const
+		{
+			Cursor cursor{};
+			return at(time, &cursor);
+		}
+
+		/*! Interpolated transforms for each of numTimes times.
+		 *
+		 * Times may be in any order but lookup is fastest if they
+		 * are monotone (e.g. nondecreasing).
+		 */
+		inline
+		void
+		at
+			( double const * const times
+			, std::size_t const & numTimes
+			, Transform * const xfmsOut
+			) const
+		{
+			Cursor cursor{};
+			for (std::size_t nn{0u} ; nn < numTimes ; ++nn)
+			{
+				xfmsOut[nn] = at(times[nn], &cursor);
+			}
+		}
+
+		//! Interpolated transform for each time in times.
+		inline
+		std::vector<Transform>
+		at
+			( std::vector<double> const & times
+			) const
+		{
+			std::vector<Transform> xfms(times.size());
+			at(times.data(), times.size(), xfms.data());
+			return xfms;
+		}
+
+	}; // Trajectory
+
+
+} // [rigibra]
+
+
+#endif // Rigibra_trajectory_INCL_
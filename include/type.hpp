@@ -34,8 +34,12 @@ Example:
 
 */
 
+#include "instrument.hpp"
+#include "spin.hpp"
+
 #include <Engabra>
 
+#include <cmath>
 #include <limits>
 
 
@@ -44,6 +48,34 @@ namespace rigibra
 
 	using Location = engabra::g3::Vector;
 
+	//! Null (not-a-number) value available for constant expressions.
+	constexpr double sNullValue{ std::numeric_limits<double>::quiet_NaN() };
+
+	//! True if value is finite (not NaN nor infinite) - constexpr form.
+	constexpr
+	bool
+	isFinite
+		( double const & value
+		)
+	{
+		// difference is NaN for NaN or for +/- infinity
+		return ((value - value) == 0.);
+	}
+
+	/*! True if value is not NaN - constexpr form of engabra::g3::isValid().
+	 *
+	 * Note that infinite values are valid (not null) in this sense.
+	 */
+	constexpr
+	bool
+	isNotNaN
+		( double const & value
+		)
+	{
+		// NaN is the only value that does not compare equal to itself
+		return (value == value);
+	}
+
 	/*! \brief Physically meaningful 3D angle (size and plane of rotation).
 	 *
 	 * This class exists to provide type safety and mitigate confusion
@@ -62,8 +94,7 @@ namespace rigibra
 	struct PhysAngle
 	{
 		//! Size and direction of physical rotation angle (default to null).
-		engabra::g3::BiVector theBiv
-			{engabra::g3::null<engabra::g3::BiVector>()};
+		engabra::g3::BiVector theBiv{ sNullValue, sNullValue, sNullValue };
 
 	}; // PhysAngle
 
@@ -86,8 +117,7 @@ namespace rigibra
 	struct SpinAngle
 	{
 		//! 1/2 size and direction of physical rotation angle (default to null).
-		engabra::g3::BiVector theBiv
-			{engabra::g3::null<engabra::g3::BiVector>()};
+		engabra::g3::BiVector theBiv{ sNullValue, sNullValue, sNullValue };
 
 		//! SpinAngle extracted from spinor (i.e. logarithm of the spinor).
 		inline
@@ -97,7 +127,8 @@ namespace rigibra
 			( engabra::g3::Spinor const & spin
 			)
 		{
-			return SpinAngle{ engabra::g3::logG2(spin).theBiv };
+			Rigibra_INSTRUMENT_SCOPE(SpinLog);
+			return SpinAngle{ spinLog(spin) };
 		}
 
 	}; // PhysAngle
@@ -132,29 +163,35 @@ namespace rigibra
 		 * to resolve ambiquities associated with cases in which the
 		 * plane of rotation is fundamentally undefined.
 		 */
-		SpinAngle theSpinAngle{ engabra::g3::null<engabra::g3::BiVector>() };
+		SpinAngle theSpinAngle{};
 
 	public:
 
 		//! Construct a null instance
-		inline
+		constexpr
 		explicit
 		Attitude
 			()
-			: theSpinAngle{ engabra::g3::null<engabra::g3::BiVector>() }
+			: theSpinAngle{}
 		{ }
 
 		//! Construct attitude of body matching this physical angle.
-		inline
+		constexpr
 		explicit
 		Attitude
 			( PhysAngle const & physAngle
 			)
-			: theSpinAngle{ .5 * physAngle.theBiv }
+			: theSpinAngle
+				{ engabra::g3::BiVector
+					{ .5 * physAngle.theBiv[0]
+					, .5 * physAngle.theBiv[1]
+					, .5 * physAngle.theBiv[2]
+					}
+				}
 		{ }
 
 		//! Construct attitude of body matching TWICE this.
-		inline
+		constexpr
 		explicit
 		Attitude
 			( SpinAngle const & spinAngle
@@ -192,11 +229,12 @@ namespace rigibra
 		spinor
 			() const
 		{
-			return engabra::g3::exp(theSpinAngle.theBiv);
+			Rigibra_INSTRUMENT_SCOPE(SpinExp);
+			return spinExp(theSpinAngle.theBiv);
 		}
 
 		//! Spinor angle associated with the Attitude (half of physAngle());
-		inline
+		constexpr
 		SpinAngle const &
 		spinAngle
 			() const
@@ -205,12 +243,14 @@ namespace rigibra
 		}
 
 		//! Physical angle associated with the Attitude (twice spinAngle()).
-		inline
+		constexpr
 		PhysAngle
 		physAngle
 			() const
 		{
-			return PhysAngle{ 2. * theSpinAngle.theBiv };
+			engabra::g3::BiVector const & spinBiv = theSpinAngle.theBiv;
+			return PhysAngle{ engabra::g3::BiVector
+				{ 2. * spinBiv[0], 2. * spinBiv[1], 2. * spinBiv[2] } };
 		}
 
 		//! Expressed of vector in range(into) frame equiv to vecFrom in domain.
@@ -221,9 +261,9 @@ namespace rigibra
 			) const
 		{
 			using namespace engabra::g3;
-			// Note: this can be optimized - e.g. Create a FastAttitude
-			// class that constructs spinors (and/or grid matrices) for
-			// subsequent use in transforming large quantities of data
+			// Note: this evaluates the spinor on every call. For use
+			// in transforming large quantities of data, construct a
+			// FastAttitude (fast.hpp) once and use it instead.
 			Spinor const spin{ spinor() };
 			return (spin * vecFrom * reverse(spin)).theVec;
 		}
@@ -262,12 +302,11 @@ namespace rigibra
 	{
 		/*! \brief Location of body expressed in reference system.
 		 */
-		engabra::g3::Vector theLoc{ engabra::g3::null<engabra::g3::Vector>() };
+		engabra::g3::Vector theLoc{ sNullValue, sNullValue, sNullValue };
 
 		/*! \brief Attitude of body with respect to reference frame.
 		 */
-		Attitude theAtt
-			{ PhysAngle{ engabra::g3::null<engabra::g3::BiVector>() } };
+		Attitude theAtt{};
 
 		//! True if this instance is not null
 		inline
@@ -295,6 +334,235 @@ namespace rigibra
 	}; // Transform
 
 
+	/*! \brief Attitude represented by (and stored as) its spinor.
+	 *
+	 * Alternative to Attitude for use cases dominated by composition
+	 * (e.g. long kinematic chains). Composition of SpinorAttitude
+	 * instances is a spinor product (16 multiplies) with no
+	 * exponential or logarithm evaluation. The angle is extracted
+	 * (via logarithm) only when spinAngle() or physAngle() is called.
+	 *
+	 * Composition does not renormalize the spinor. Roundoff may
+	 * therefore accumulate a (small) departure from unit magnitude
+	 * over very long chains. Member functions here are insensitive
+	 * to spinor magnitude, and normalized() is available if needed.
+	 *
+	 * Conventions are the same as for Attitude, i.e.
+	 * \arg y = spinor() * x * reverse(spinor())
+	 *
+	 * Example:
+	 * \snippet test_type.cpp DoxyExampleSpinor
+	 */
+	class SpinorAttitude
+	{
+		//! Spinor passive convention body wrt reference (ref Attitude).
+		engabra::g3::Spinor theSpin
+			{ sNullValue, sNullValue, sNullValue, sNullValue };
+
+	public:
+
+		//! Construct a null instance
+		constexpr
+		explicit
+		SpinorAttitude
+			()
+			: theSpin{ sNullValue, sNullValue, sNullValue, sNullValue }
+		{ }
+
+		//! Construct directly from spinor (assumed unit magnitude).
+		constexpr
+		explicit
+		SpinorAttitude
+			( engabra::g3::Spinor const & spin
+			)
+			: theSpin{ spin }
+		{ }
+
+		//! Construct to represent same attitude as att.
+		inline
+		explicit
+		SpinorAttitude
+			( Attitude const & att
+			)
+			: theSpin{ att.spinor() }
+		{ }
+
+		//! True if this instance is not null
+		constexpr
+		bool
+		isValid
+			() const
+		{
+			return
+				(  isNotNaN(theSpin.theSca[0])
+				&& isNotNaN(theSpin.theBiv[0])
+				&& isNotNaN(theSpin.theBiv[1])
+				&& isNotNaN(theSpin.theBiv[2])
+				);
+		}
+
+		//! Spinor representation of attitude (as stored).
+		constexpr
+		engabra::g3::Spinor const &
+		spinor
+			() const
+		{
+			return theSpin;
+		}
+
+		//! Spinor angle (evaluates logarithm of spinor).
+		inline
+		SpinAngle
+		spinAngle
+			() const
+		{
+			return SpinAngle::from(theSpin);
+		}
+
+		//! Physical angle (twice spinAngle()).
+		inline
+		PhysAngle
+		physAngle
+			() const
+		{
+			return PhysAngle{ 2. * spinAngle().theBiv };
+		}
+
+		//! Equivalent Attitude (evaluates logarithm of spinor).
+		inline
+		Attitude
+		attitude
+			() const
+		{
+			return Attitude(theSpin);
+		}
+
+		//! Instance with spinor rescaled to unit magnitude.
+		inline
+		SpinorAttitude
+		normalized
+			() const
+		{
+			double const & ww = theSpin.theSca[0];
+			engabra::g3::BiVector const & bb = theSpin.theBiv;
+			double const magSq
+				{ ww*ww + bb[0]*bb[0] + bb[1]*bb[1] + bb[2]*bb[2] };
+			double const scl{ 1. / std::sqrt(magSq) };
+			return SpinorAttitude
+				(engabra::g3::Spinor{ scl*ww, scl*bb[0], scl*bb[1], scl*bb[2] });
+		}
+
+		/*! Expressed of vector in range(into) frame equiv to vecFrom in domain.
+		 *
+		 * Evaluates the sandwich product, spin*vecFrom*reverse(spin),
+		 * in expanded (rotation matrix) form, divided by the squared
+		 * spinor magnitude.
+		 */
+		constexpr
+		engabra::g3::Vector
+		operator()
+			( engabra::g3::Vector const & vecFrom
+			) const
+		{
+			double const ww{ theSpin.theSca[0] };
+			double const b0{ theSpin.theBiv[0] };
+			double const b1{ theSpin.theBiv[1] };
+			double const b2{ theSpin.theBiv[2] };
+			double const b00{ b0 * b0 };
+			double const b11{ b1 * b1 };
+			double const b22{ b2 * b2 };
+			double const magSq{ ww*ww + b00 + b11 + b22 };
+			double const w0{ ww * b0 };
+			double const w1{ ww * b1 };
+			double const w2{ ww * b2 };
+			double const b01{ b0 * b1 };
+			double const b02{ b0 * b2 };
+			double const b12{ b1 * b2 };
+			double const & x0 = vecFrom[0];
+			double const & x1 = vecFrom[1];
+			double const & x2 = vecFrom[2];
+			double const scl{ 1. / magSq };
+			return engabra::g3::Vector
+				{ scl * ( (magSq - 2.*(b11 + b22)) * x0
+						+ 2.*(b01 + w2) * x1
+						+ 2.*(b02 - w1) * x2 )
+				, scl * ( 2.*(b01 - w2) * x0
+						+ (magSq - 2.*(b00 + b22)) * x1
+						+ 2.*(b12 + w0) * x2 )
+				, scl * ( 2.*(b02 + w1) * x0
+						+ 2.*(b12 - w0) * x1
+						+ (magSq - 2.*(b00 + b11)) * x2 )
+				};
+		}
+
+	}; // SpinorAttitude
+
+
+	/*! \brief Rigid body transform with attitude stored as spinor.
+	 *
+	 * Same conventions and interpretation as Transform but with
+	 * SpinorAttitude such that composition (ref func.hpp) requires
+	 * no exponential or logarithm evaluations.
+	 */
+	struct SpinorTransform
+	{
+		//! Location of body expressed in reference system.
+		engabra::g3::Vector theLoc{ sNullValue, sNullValue, sNullValue };
+
+		//! Attitude of body with respect to reference frame.
+		SpinorAttitude theAtt{};
+
+		//! SpinorTransform representing same transformation as xfm.
+		inline
+		static
+		SpinorTransform
+		from
+			( Transform const & xfm
+			)
+		{
+			return SpinorTransform{ xfm.theLoc, SpinorAttitude(xfm.theAtt) };
+		}
+
+		//! True if this instance is not null
+		constexpr
+		bool
+		isValid
+			() const
+		{
+			return
+				(  isNotNaN(theLoc[0])
+				&& isNotNaN(theLoc[1])
+				&& isNotNaN(theLoc[2])
+				&& theAtt.isValid()
+				);
+		}
+
+		//! Equivalent Transform (evaluates logarithm of spinor).
+		inline
+		Transform
+		transform
+			() const
+		{
+			return Transform{ theLoc, theAtt.attitude() };
+		}
+
+		//! Expressed of vector in range(into) frame equiv to vecFrom in domain.
+		constexpr
+		engabra::g3::Vector
+		operator()
+			( engabra::g3::Vector const & vecFrom
+			) const
+		{
+			return theAtt(engabra::g3::Vector
+				{ vecFrom[0] - theLoc[0]
+				, vecFrom[1] - theLoc[1]
+				, vecFrom[2] - theLoc[2]
+				});
+		}
+
+	}; // SpinorTransform
+
+
 //
 // == constant types
 //
@@ -304,39 +572,84 @@ namespace rigibra
 	 * E.g. for
 	 * \arg PhysAngle
 	 * \arg SpinAngle
+	 *
+	 * Specializations for rigibra types may be used in constant
+	 * expressions (e.g. as constexpr values).
 	 */
 	template <typename Type>
 	inline
 	Type
-	identity
+	constexpr identity
 		()
 	{
 		// as implemented here, zero parameter values provide identity
 		return engabra::g3::zero<Type>();
 	}
 
+	//! Specialization for PhysAngle
+	template <>
+	inline
+	PhysAngle
+	constexpr identity
+		()
+	{
+		// as implemented here, zero parameter values provide identity
+		return PhysAngle{ engabra::g3::BiVector{ 0., 0., 0. } };
+	}
+
+	//! Specialization for SpinAngle
+	template <>
+	inline
+	SpinAngle
+	constexpr identity
+		()
+	{
+		// as implemented here, zero parameter values provide identity
+		return SpinAngle{ engabra::g3::BiVector{ 0., 0., 0. } };
+	}
+
 	//! Specialization for Attitude
 	template <>
 	inline
 	Attitude
-	identity
+	constexpr identity
 		()
 	{
 		// as implemented here, zero parameter values provide identity
-		using namespace engabra::g3;
-		return Attitude{ SpinAngle{ zero<BiVector>() } };
+		return Attitude{ identity<SpinAngle>() };
 	}
 
 	//! Specialization for Transform
 	template <>
 	inline
 	Transform
-	identity
+	constexpr identity
 		()
 	{
 		// as implemented here, zero parameter values provide identity
-		using namespace engabra::g3;
-		return Transform{ zero<Vector>(), identity<Attitude>() };
+		return Transform
+			{ engabra::g3::Vector{ 0., 0., 0. }, identity<Attitude>() };
+	}
+
+	//! Specialization for SpinorAttitude
+	template <>
+	inline
+	SpinorAttitude
+	constexpr identity
+		()
+	{
+		return SpinorAttitude(engabra::g3::Spinor{ 1., 0., 0., 0. });
+	}
+
+	//! Specialization for SpinorTransform
+	template <>
+	inline
+	SpinorTransform
+	constexpr identity
+		()
+	{
+		return SpinorTransform
+			{ engabra::g3::Vector{ 0., 0., 0. }, identity<SpinorAttitude>() };
 	}
 
 	//! In general forward null object requests to Engabra
@@ -349,15 +662,34 @@ namespace rigibra
 		return engabra::g3::null<Type>();
 	}
 
+	//! Provide explicit implementation for null<PhysAngle>
+	template <>
+	inline
+	PhysAngle
+	constexpr null
+		()
+	{
+		return PhysAngle{};
+	}
+
+	//! Provide explicit implementation for null<SpinAngle>
+	template <>
+	inline
+	SpinAngle
+	constexpr null
+		()
+	{
+		return SpinAngle{};
+	}
+
 	//! Provide explicit implementation for null<Attitude>
 	template <>
 	inline
 	Attitude
-	null
+	constexpr null
 		()
 	{
-		using namespace engabra::g3;
-		return Attitude(PhysAngle{ null<BiVector>() });
+		return Attitude{};
 	}
 
 
@@ -365,10 +697,30 @@ namespace rigibra
 	template <>
 	inline
 	Transform
-	null
+	constexpr null
 		()
 	{
-		return Transform{ null<Location>(), null<Attitude>() };
+		return Transform{};
+	}
+
+	//! Provide explicit implementation for null<SpinorAttitude>
+	template <>
+	inline
+	SpinorAttitude
+	constexpr null
+		()
+	{
+		return SpinorAttitude{};
+	}
+
+	//! Provide explicit implementation for null<SpinorTransform>
+	template <>
+	inline
+	SpinorTransform
+	constexpr null
+		()
+	{
+		return SpinorTransform{};
 	}
 
 //
@@ -395,6 +747,26 @@ namespace rigibra
 		return xform.isValid();
 	}
 
+	//! Provide explicit implementation for isValid<SpinorAttitude>
+	constexpr
+	bool
+	isValid
+		( SpinorAttitude const & att
+		)
+	{
+		return att.isValid();
+	}
+
+	//! Provide explicit implementation for isValid<SpinorTransform>
+	constexpr
+	bool
+	isValid
+		( SpinorTransform const & xform
+		)
+	{
+		return xform.isValid();
+	}
+
 //
 // Comparison
 //
@@ -453,6 +825,37 @@ namespace rigibra
 			);
 	}
 
+	/*! True if spinor values are same within tolerance.
+	 *
+	 * Note: spinors s and -s represent the same attitude but are
+	 * NOT considered nearly equal here (component comparison).
+	 */
+	inline
+	bool
+	nearlyEquals
+		( SpinorAttitude const & attA
+		, SpinorAttitude const & attB
+		, double const & tol = std::numeric_limits<double>::epsilon()
+		)
+	{
+		return engabra::g3::nearlyEquals(attA.spinor(), attB.spinor(), tol);
+	}
+
+	//! True if member data values are same within tolerance
+	inline
+	bool
+	nearlyEquals
+		( SpinorTransform const & xfmA
+		, SpinorTransform const & xfmB
+		, double const & tol = std::numeric_limits<double>::epsilon()
+		)
+	{
+		return
+			(  engabra::g3::nearlyEquals(xfmA.theLoc, xfmB.theLoc, tol)
+			&& nearlyEquals(xfmA.theAtt, xfmB.theAtt, tol)
+			);
+	}
+
 
 
 } // [rigibra]
@@ -517,6 +920,34 @@ namespace
 		return ostrm;
 	}
 
+	//! Overload for putting SpinorAttitude spinor contents to stream.
+	inline
+	std::ostream &
+	operator<<
+		( std::ostream & ostrm
+		, rigibra::SpinorAttitude const & att
+		)
+	{
+		using namespace engabra::g3;
+		ostrm << "spinor: " << att.spinor();
+		return ostrm;
+	}
+
+	//! Overload for putting SpinorTransform contents to stream.
+	inline
+	std::ostream &
+	operator<<
+		( std::ostream & ostrm
+		, rigibra::SpinorTransform const & xfm
+		)
+	{
+		ostrm
+			<< " loc: " << xfm.theLoc
+			<< " att: " << xfm.theAtt
+			;
+		return ostrm;
+	}
+
 } // [anon]
 
 #endif // Rigibra_type_INCL_
@@ -0,0 +1,117 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+/*! \file
+\brief Implementation code for rigibra::instrument collection
+*/
+
+
+#include "instrument.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+
+namespace rigibra
+{
+namespace instrument
+{
+
+namespace
+{
+	//! Global collection of per-thread counters
+	struct Registry
+	{
+		std::mutex theMutex;
+		std::vector<ThreadCounters const *> theLives; // guarded by theMutex
+		Snapshot theRetired; // guarded by theMutex
+	};
+
+	//! Registry instance (never destroyed: outlives all thread_locals)
+	inline
+	Registry &
+	registry
+		()
+	{
+		static Registry * const sPtRegistry{ new Registry };
+		return *sPtRegistry;
+	}
+
+	//! Accumulate values from snap into sum
+	inline
+	void
+	accumulate
+		( Snapshot * const & ptSum
+		, Snapshot const & snap
+		)
+	{
+		for (std::size_t nn{0u} ; nn < sNumOps ; ++nn)
+		{
+			ptSum->theCounts[nn] += snap.theCounts[nn];
+			ptSum->theNanos[nn] += snap.theNanos[nn];
+		}
+	}
+
+} // [anon]
+
+
+ThreadCounters :: ThreadCounters
+	()
+{
+	Registry & reg = registry();
+	std::lock_guard<std::mutex> lock(reg.theMutex);
+	reg.theLives.emplace_back(this);
+}
+
+ThreadCounters :: ~ThreadCounters
+	()
+{
+	Registry & reg = registry();
+	std::lock_guard<std::mutex> lock(reg.theMutex);
+	accumulate(&reg.theRetired, snapshot());
+	reg.theLives.erase
+		( std::remove(reg.theLives.begin(), reg.theLives.end(), this)
+		, reg.theLives.end()
+		);
+}
+
+Snapshot
+snapshot
+	()
+{
+	Registry & reg = registry();
+	std::lock_guard<std::mutex> lock(reg.theMutex);
+	Snapshot sum{ reg.theRetired };
+	for (ThreadCounters const * const & ptCounters : reg.theLives)
+	{
+		accumulate(&sum, ptCounters->snapshot());
+	}
+	return sum;
+}
+
+} // [instrument]
+} // [rigibra]
+
@@ -0,0 +1,295 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/*! \file
+\brief Implementation code for rigibra::binio
+*/
+
+
+#include "io.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#	define Rigibra_IO_MMAP
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+
+namespace rigibra
+{
+namespace binio
+{
+
+namespace
+{
+	//! Magic string at start of each file (including null terminator)
+	constexpr char sMagic[8]{ 'R', 'i', 'g', 'i', 'b', 'r', 'a', '\0' };
+
+	//! Number of records converted per write operation
+	constexpr std::size_t sWriteBlockSize{ 4u * 1024u };
+
+	//! Header for numRecs of type Record (checksum to be set later)
+	template <typename Record>
+	inline
+	FileHeader
+	headerFor
+		( RecordKind const & kind
+		, std::size_t const & numRecs
+		)
+	{
+		FileHeader header{};
+		std::copy(sMagic, sMagic + sizeof(sMagic), header.theMagic);
+		header.theEndianMark = sEndianMark;
+		header.theVersion = sFormatVersion;
+		header.theRecordKind = kind;
+		header.theRecordSize = static_cast<std::uint32_t>(sizeof(Record));
+		header.theNumRecords = static_cast<std::uint64_t>(numRecs);
+		header.theChecksum = 0u;
+		return header;
+	}
+
+	//! Write header and records (converted in blocks with recordFor()).
+	template <typename Record, typename Item>
+	inline
+	bool
+	writeRecords
+		( std::string const & path
+		, RecordKind const & kind
+		, Item const * const items
+		, std::size_t const & numItems
+		)
+	{
+		std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+		FileHeader header{ headerFor<Record>(kind, numItems) };
+		ofs.write(reinterpret_cast<char const *>(&header), sizeof(header));
+
+		std::vector<Record> recs;
+		recs.reserve(std::min(numItems, sWriteBlockSize));
+		std::uint64_t sum{ checksumFor(nullptr, 0u) };
+		for (std::size_t beg{0u} ; ofs && (beg < numItems)
+			; beg += sWriteBlockSize)
+		{
+			std::size_t const end{ std::min(beg + sWriteBlockSize, numItems) };
+			recs.clear();
+			for (std::size_t nn{beg} ; nn < end ; ++nn)
+			{
+				recs.emplace_back(recordFor(items[nn]));
+			}
+			std::size_t const numBytes{ recs.size() * sizeof(Record) };
+			sum = checksumFor(recs.data(), numBytes, sum);
+			ofs.write
+				( reinterpret_cast<char const *>(recs.data())
+				, static_cast<std::streamsize>(numBytes)
+				);
+		}
+
+		// update header with checksum
+		header.theChecksum = sum;
+		ofs.seekp(0);
+		ofs.write(reinterpret_cast<char const *>(&header), sizeof(header));
+		ofs.close();
+		return (! ofs.fail());
+	}
+
+	//! True if header is consistent with this build and with file size.
+	inline
+	bool
+	isConsistent
+		( FileHeader const & header
+		, std::size_t const & fileSize
+		)
+	{
+		bool okay
+			{  std::equal(sMagic, sMagic + sizeof(sMagic), header.theMagic)
+			&& (sEndianMark == header.theEndianMark)
+			&& (sFormatVersion == header.theVersion)
+			};
+		if (okay)
+		{
+			std::size_t expSize{ 0u };
+			switch (header.theRecordKind)
+			{
+				case RecordKind::Transform:
+					expSize = sizeof(TransformRecord);
+					break;
+				case RecordKind::Attitude:
+					expSize = sizeof(AttitudeRecord);
+					break;
+				default:
+					break;
+			}
+			std::uint64_t const numRecBytes{ fileSize - sizeof(FileHeader) };
+			okay
+				=  (0u < expSize)
+				&& (expSize == header.theRecordSize)
+				&& (numRecBytes / expSize == header.theNumRecords)
+				&& (0u == (numRecBytes % expSize))
+				;
+		}
+		return okay;
+	}
+
+} // [anon]
+
+
+bool
+writeBinary
+	( std::string const & path
+	, Transform const * const xfms
+	, std::size_t const & numXfms
+	)
+{
+	return writeRecords<TransformRecord>
+		(path, RecordKind::Transform, xfms, numXfms);
+}
+
+bool
+writeBinary
+	( std::string const & path
+	, Attitude const * const atts
+	, std::size_t const & numAtts
+	)
+{
+	return writeRecords<AttitudeRecord>
+		(path, RecordKind::Attitude, atts, numAtts);
+}
+
+
+void
+MappedFile :: close
+	()
+{
+#if defined(Rigibra_IO_MMAP)
+	if (theData)
+	{
+		::munmap(theData, theNumBytes);
+	}
+#endif
+	theData = nullptr;
+	theNumBytes = 0u;
+	theIsValid = false;
+}
+
+MappedFile :: MappedFile
+	( std::string const & path
+	, bool const & verifyChecksum
+	)
+{
+#if defined(Rigibra_IO_MMAP)
+	int const fd{ ::open(path.c_str(), O_RDONLY) };
+	if (! (fd < 0))
+	{
+		struct stat info{};
+		if ((0 == ::fstat(fd, &info))
+			&& (sizeof(FileHeader) <= static_cast<std::size_t>(info.st_size)))
+		{
+			std::size_t const numBytes{ static_cast<std::size_t>(info.st_size) };
+			void * const data
+				{ ::mmap(nullptr, numBytes, PROT_READ, MAP_SHARED, fd, 0) };
+			if (MAP_FAILED != data)
+			{
+				theData = data;
+				theNumBytes = numBytes;
+			}
+		}
+		// mapping remains valid after file is closed
+		::close(fd);
+	}
+#else
+	(void)path;
+#endif
+
+	if (theData)
+	{
+		FileHeader const & header = *static_cast<FileHeader const *>(theData);
+		theIsValid = isConsistent(header, theNumBytes);
+		if (theIsValid && verifyChecksum)
+		{
+			theIsValid = hasValidChecksum();
+		}
+	}
+}
+
+bool
+MappedFile :: hasValidChecksum
+	() const
+{
+	bool okay{ false };
+	if (theIsValid) // mapped and header consistent
+	{
+		std::uint64_t const sum
+			{ checksumFor
+				( static_cast<char const *>(theData) + sizeof(FileHeader)
+				, theNumBytes - sizeof(FileHeader)
+				)
+			};
+		okay = (sum == header()->theChecksum);
+	}
+	return okay;
+}
+
+MappedFile :: MappedFile
+	( MappedFile && orig
+	) noexcept
+	: theData{ orig.theData }
+	, theNumBytes{ orig.theNumBytes }
+	, theIsValid{ orig.theIsValid }
+{
+	orig.theData = nullptr;
+	orig.theNumBytes = 0u;
+	orig.theIsValid = false;
+}
+
+MappedFile &
+MappedFile :: operator=
+	( MappedFile && orig
+	) noexcept
+{
+	if (this != &orig)
+	{
+		close();
+		std::swap(theData, orig.theData);
+		std::swap(theNumBytes, orig.theNumBytes);
+		std::swap(theIsValid, orig.theIsValid);
+	}
+	return *this;
+}
+
+MappedFile :: ~MappedFile
+	()
+{
+	close();
+}
+
+
+} // [binio]
+} // [rigibra]
+
@@ -0,0 +1,368 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/*! \file
+\brief Implementation code for rigibra::ThreadPool
+*/
+
+
+#include "pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#	include <pthread.h>
+#	include <sched.h>
+#endif
+
+
+namespace rigibra
+{
+
+namespace
+{
+	//! Tracks completion of all chunks from one parallelFor() call
+	struct Job
+	{
+		ThreadPool::ChunkFunc const * theFunc{ nullptr };
+		std::size_t theRemaining{ 0u }; // guarded by theMutex
+		std::exception_ptr theError{}; // first thrown, guarded by theMutex
+		std::atomic<bool> theFailed{ false }; // skip chunks after failure
+		std::mutex theMutex;
+		std::condition_variable theDoneCV;
+	};
+
+	//! Range of items to process for a job
+	struct Task
+	{
+		std::size_t theBeg{ 0u };
+		std::size_t theEnd{ 0u };
+		Job * theJob{ nullptr };
+	};
+
+	//! Mutex protected double ended queue (owner front, thieves back)
+	struct TaskQueue
+	{
+		std::mutex theMutex;
+		std::deque<Task> theTasks;
+	};
+
+	/*! Process task and signal job completion if this was the last one
+	 *
+	 * An exception thrown by the chunk function is captured (the first
+	 * one is kept for rethrow by parallelFor()) and the remaining
+	 * chunks of the job are skipped. The task is always counted as
+	 * done such that the job is never abandoned while still queued.
+	 */
+	inline
+	void
+	runTask
+		( Task const & task
+		)
+	{
+		Job & job = *(task.theJob);
+		std::exception_ptr error{};
+		if (! job.theFailed.load())
+		{
+			try
+			{
+				(*job.theFunc)(task.theBeg, task.theEnd);
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+				job.theFailed.store(true);
+			}
+		}
+		// decrement under lock so job is not destroyed while in use here
+		std::lock_guard<std::mutex> lock(job.theMutex);
+		if (error && (! job.theError))
+		{
+			job.theError = error;
+		}
+		if (0u == --job.theRemaining)
+		{
+			job.theDoneCV.notify_all();
+		}
+	}
+
+	//! Bind thread to a processor core (where supported).
+	inline
+	void
+	pinToCore
+		( std::thread & thread
+		, std::size_t const & coreNdx
+		)
+	{
+#if defined(__linux__)
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(static_cast<int>(coreNdx), &cpuSet);
+		pthread_setaffinity_np
+			(thread.native_handle(), sizeof(cpu_set_t), &cpuSet);
+#else
+		(void)thread;
+		(void)coreNdx;
+#endif
+	}
+
+} // [anon]
+
+
+//! Implementation details for ThreadPool
+struct ThreadPool::Impl
+{
+	std::vector<std::unique_ptr<TaskQueue> > theQueues;
+	std::vector<std::thread> theThreads;
+
+	std::mutex theWakeMutex;
+	std::condition_variable theWakeCV;
+	std::atomic<std::size_t> thePending{ 0u };
+	bool theStop{ false };
+
+	//! Take task from front of queue qNdx
+	inline
+	bool
+	popFront
+		( std::size_t const & qNdx
+		, Task * const & ptTask
+		)
+	{
+		bool got{ false };
+		TaskQueue & queue = *(theQueues[qNdx]);
+		std::lock_guard<std::mutex> lock(queue.theMutex);
+		if (! queue.theTasks.empty())
+		{
+			*ptTask = queue.theTasks.front();
+			queue.theTasks.pop_front();
+			thePending.fetch_sub(1u);
+			got = true;
+		}
+		return got;
+	}
+
+	//! Take task from back of queue qNdx
+	inline
+	bool
+	popBack
+		( std::size_t const & qNdx
+		, Task * const & ptTask
+		)
+	{
+		bool got{ false };
+		TaskQueue & queue = *(theQueues[qNdx]);
+		std::lock_guard<std::mutex> lock(queue.theMutex);
+		if (! queue.theTasks.empty())
+		{
+			*ptTask = queue.theTasks.back();
+			queue.theTasks.pop_back();
+			thePending.fetch_sub(1u);
+			got = true;
+		}
+		return got;
+	}
+
+	//! Get task from own queue, else steal from others
+	inline
+	bool
+	findTask
+		( std::size_t const & ownNdx
+		, Task * const & ptTask
+		)
+	{
+		bool got{ false };
+		std::size_t const numQ{ theQueues.size() };
+		if (ownNdx < numQ)
+		{
+			got = popFront(ownNdx, ptTask);
+		}
+		for (std::size_t nn{1u} ; (! got) && (nn <= numQ) ; ++nn)
+		{
+			std::size_t const qNdx{ (ownNdx + nn) % numQ };
+			got = popBack(qNdx, ptTask);
+		}
+		return got;
+	}
+
+	//! Main loop for worker thread
+	inline
+	void
+	workerLoop
+		( std::size_t const & ownNdx
+		)
+	{
+		Task task;
+		while (true)
+		{
+			if (findTask(ownNdx, &task))
+			{
+				runTask(task);
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(theWakeMutex);
+			theWakeCV.wait
+				( lock
+				, [this] () { return (theStop || (0u < thePending.load())); }
+				);
+			if (theStop && (0u == thePending.load()))
+			{
+				break;
+			}
+		}
+	}
+};
+
+
+ThreadPool :: ThreadPool
+	( std::size_t const & numThreads
+	, bool const & pinThreads
+	)
+	: thePimpl{ std::make_unique<Impl>() }
+{
+	std::size_t const numCores
+		{ std::max(1u, std::thread::hardware_concurrency()) };
+	std::size_t const numUse{ (0u < numThreads) ? numThreads : numCores };
+	thePimpl->theQueues.reserve(numUse);
+	for (std::size_t nn{0u} ; nn < numUse ; ++nn)
+	{
+		thePimpl->theQueues.emplace_back(std::make_unique<TaskQueue>());
+	}
+	thePimpl->theThreads.reserve(numUse);
+	for (std::size_t nn{0u} ; nn < numUse ; ++nn)
+	{
+		Impl * const ptImpl{ thePimpl.get() };
+		thePimpl->theThreads.emplace_back
+			( [ptImpl, nn] () { ptImpl->workerLoop(nn); }
+			);
+		if (pinThreads)
+		{
+			pinToCore(thePimpl->theThreads.back(), nn % numCores);
+		}
+	}
+}
+
+ThreadPool :: ~ThreadPool
+	()
+{
+	{
+		std::lock_guard<std::mutex> lock(thePimpl->theWakeMutex);
+		thePimpl->theStop = true;
+	}
+	thePimpl->theWakeCV.notify_all();
+	for (std::thread & thread : thePimpl->theThreads)
+	{
+		thread.join();
+	}
+}
+
+std::size_t
+ThreadPool :: size
+	() const
+{
+	return thePimpl->theThreads.size();
+}
+
+void
+ThreadPool :: parallelFor
+	( std::size_t const & numItems
+	, std::size_t const & chunkSize
+	, ChunkFunc const & func
+	)
+{
+	std::size_t const useSize{ std::max(std::size_t{ 1u }, chunkSize) };
+	std::size_t const numChunks{ (numItems + useSize - 1u) / useSize };
+	if (0u == numChunks)
+	{
+		return;
+	}
+
+	Job job;
+	job.theFunc = &func;
+	job.theRemaining = numChunks;
+
+	// count before queuing so that pending never underflows
+	{
+		std::lock_guard<std::mutex> lock(thePimpl->theWakeMutex);
+		thePimpl->thePending.fetch_add(numChunks);
+	}
+
+	// assign contiguous blocks of chunks to each worker queue
+	std::size_t const numQ{ thePimpl->theQueues.size() };
+	std::size_t const perQ{ (numChunks + numQ - 1u) / numQ };
+	for (std::size_t qNdx{0u} ; qNdx < numQ ; ++qNdx)
+	{
+		std::size_t const cBeg{ std::min(numChunks, qNdx * perQ) };
+		std::size_t const cEnd{ std::min(numChunks, cBeg + perQ) };
+		TaskQueue & queue = *(thePimpl->theQueues[qNdx]);
+		std::lock_guard<std::mutex> lock(queue.theMutex);
+		for (std::size_t cNdx{cBeg} ; cNdx < cEnd ; ++cNdx)
+		{
+			std::size_t const iBeg{ cNdx * useSize };
+			std::size_t const iEnd{ std::min(numItems, iBeg + useSize) };
+			queue.theTasks.emplace_back(Task{ iBeg, iEnd, &job });
+		}
+	}
+	thePimpl->theWakeCV.notify_all();
+
+	// calling thread helps (stealing from any queue) until none remain
+	Task task;
+	while (thePimpl->findTask(numQ, &task))
+	{
+		runTask(task);
+	}
+
+	// wait for chunks still in progress on worker threads
+	std::unique_lock<std::mutex> lock(job.theMutex);
+	job.theDoneCV.wait
+		( lock
+		, [&job] () { return (0u == job.theRemaining); }
+		);
+
+	// all tasks are done (job no longer referenced): report any failure
+	if (job.theError)
+	{
+		std::exception_ptr const error{ job.theError };
+		lock.unlock();
+		std::rethrow_exception(error);
+	}
+}
+
+ThreadPool &
+defaultPool
+	()
+{
+	static ThreadPool pool{};
+	return pool;
+}
+
+
+} // [rigibra]
+
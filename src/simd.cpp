@@ -0,0 +1,389 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/*! \file
+\brief Implementation code for rigibra::simd
+*/
+
+
+#include "simd.hpp"
+
+#include "fast.hpp"
+
+#include <array>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#	define Rigibra_SIMD_X86
+#	include <immintrin.h>
+#endif
+
+
+namespace rigibra
+{
+namespace simd
+{
+
+namespace
+{
+	/*! \brief Transformation expressed as y = mat*x + off
+	 *
+	 * Folding the translation into an offset (off = -mat*loc)
+	 * leaves 9 multiply-adds per point in the kernels.
+	 */
+	struct Affine
+	{
+		std::array<double, 9u> theMat;
+		std::array<double, 3u> theOff;
+
+		inline
+		explicit
+		Affine
+			( Transform const & xfm
+			)
+		{
+			FastTransform const fastXfm(xfm);
+			theMat = fastXfm.theAtt.matrix();
+			engabra::g3::Vector const off{ -fastXfm.theAtt(fastXfm.theLoc) };
+			theOff = { off[0], off[1], off[2] };
+		}
+	};
+
+	//! Scalar kernel for elements [beg,end)
+	inline
+	void
+	kernelScalar
+		( Affine const & aff
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & beg
+		, std::size_t const & end
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		std::array<double, 9u> const & mm = aff.theMat;
+		std::array<double, 3u> const & oo = aff.theOff;
+		for (std::size_t nn{beg} ; nn < end ; ++nn)
+		{
+			double const x0{ xIn[nn] };
+			double const x1{ yIn[nn] };
+			double const x2{ zIn[nn] };
+			xOut[nn] = mm[0]*x0 + mm[1]*x1 + mm[2]*x2 + oo[0];
+			yOut[nn] = mm[3]*x0 + mm[4]*x1 + mm[5]*x2 + oo[1];
+			zOut[nn] = mm[6]*x0 + mm[7]*x1 + mm[8]*x2 + oo[2];
+		}
+	}
+
+#if defined(Rigibra_SIMD_X86)
+
+	//! SSE2 kernel: 2 points per instruction
+	__attribute__((target("sse2")))
+	void
+	kernelSSE2
+		( Affine const & aff
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		std::array<double, 9u> const & mm = aff.theMat;
+		std::array<double, 3u> const & oo = aff.theOff;
+		__m128d const m00{ _mm_set1_pd(mm[0]) };
+		__m128d const m01{ _mm_set1_pd(mm[1]) };
+		__m128d const m02{ _mm_set1_pd(mm[2]) };
+		__m128d const m10{ _mm_set1_pd(mm[3]) };
+		__m128d const m11{ _mm_set1_pd(mm[4]) };
+		__m128d const m12{ _mm_set1_pd(mm[5]) };
+		__m128d const m20{ _mm_set1_pd(mm[6]) };
+		__m128d const m21{ _mm_set1_pd(mm[7]) };
+		__m128d const m22{ _mm_set1_pd(mm[8]) };
+		__m128d const o0{ _mm_set1_pd(oo[0]) };
+		__m128d const o1{ _mm_set1_pd(oo[1]) };
+		__m128d const o2{ _mm_set1_pd(oo[2]) };
+		constexpr std::size_t width{ 2u };
+		std::size_t const numFull{ numPnts - (numPnts % width) };
+		for (std::size_t nn{0u} ; nn < numFull ; nn += width)
+		{
+			__m128d const x0{ _mm_loadu_pd(xIn + nn) };
+			__m128d const x1{ _mm_loadu_pd(yIn + nn) };
+			__m128d const x2{ _mm_loadu_pd(zIn + nn) };
+			__m128d const y0
+				{ _mm_add_pd
+					( _mm_add_pd(_mm_mul_pd(m00, x0), _mm_mul_pd(m01, x1))
+					, _mm_add_pd(_mm_mul_pd(m02, x2), o0)
+					)
+				};
+			__m128d const y1
+				{ _mm_add_pd
+					( _mm_add_pd(_mm_mul_pd(m10, x0), _mm_mul_pd(m11, x1))
+					, _mm_add_pd(_mm_mul_pd(m12, x2), o1)
+					)
+				};
+			__m128d const y2
+				{ _mm_add_pd
+					( _mm_add_pd(_mm_mul_pd(m20, x0), _mm_mul_pd(m21, x1))
+					, _mm_add_pd(_mm_mul_pd(m22, x2), o2)
+					)
+				};
+			_mm_storeu_pd(xOut + nn, y0);
+			_mm_storeu_pd(yOut + nn, y1);
+			_mm_storeu_pd(zOut + nn, y2);
+		}
+		kernelScalar
+			(aff, xIn, yIn, zIn, numFull, numPnts, xOut, yOut, zOut);
+	}
+
+	//! AVX2 kernel: 4 points per instruction
+	__attribute__((target("avx2,fma")))
+	void
+	kernelAVX2
+		( Affine const & aff
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		std::array<double, 9u> const & mm = aff.theMat;
+		std::array<double, 3u> const & oo = aff.theOff;
+		__m256d const m00{ _mm256_set1_pd(mm[0]) };
+		__m256d const m01{ _mm256_set1_pd(mm[1]) };
+		__m256d const m02{ _mm256_set1_pd(mm[2]) };
+		__m256d const m10{ _mm256_set1_pd(mm[3]) };
+		__m256d const m11{ _mm256_set1_pd(mm[4]) };
+		__m256d const m12{ _mm256_set1_pd(mm[5]) };
+		__m256d const m20{ _mm256_set1_pd(mm[6]) };
+		__m256d const m21{ _mm256_set1_pd(mm[7]) };
+		__m256d const m22{ _mm256_set1_pd(mm[8]) };
+		__m256d const o0{ _mm256_set1_pd(oo[0]) };
+		__m256d const o1{ _mm256_set1_pd(oo[1]) };
+		__m256d const o2{ _mm256_set1_pd(oo[2]) };
+		constexpr std::size_t width{ 4u };
+		std::size_t const numFull{ numPnts - (numPnts % width) };
+		for (std::size_t nn{0u} ; nn < numFull ; nn += width)
+		{
+			__m256d const x0{ _mm256_loadu_pd(xIn + nn) };
+			__m256d const x1{ _mm256_loadu_pd(yIn + nn) };
+			__m256d const x2{ _mm256_loadu_pd(zIn + nn) };
+			__m256d const y0
+				{ _mm256_fmadd_pd(m02, x2
+				, _mm256_fmadd_pd(m01, x1
+				, _mm256_fmadd_pd(m00, x0, o0)))
+				};
+			__m256d const y1
+				{ _mm256_fmadd_pd(m12, x2
+				, _mm256_fmadd_pd(m11, x1
+				, _mm256_fmadd_pd(m10, x0, o1)))
+				};
+			__m256d const y2
+				{ _mm256_fmadd_pd(m22, x2
+				, _mm256_fmadd_pd(m21, x1
+				, _mm256_fmadd_pd(m20, x0, o2)))
+				};
+			_mm256_storeu_pd(xOut + nn, y0);
+			_mm256_storeu_pd(yOut + nn, y1);
+			_mm256_storeu_pd(zOut + nn, y2);
+		}
+		kernelScalar
+			(aff, xIn, yIn, zIn, numFull, numPnts, xOut, yOut, zOut);
+	}
+
+	//! AVX-512 kernel: 8 points per instruction
+	__attribute__((target("avx512f")))
+	void
+	kernelAVX512
+		( Affine const & aff
+		, double const * const xIn
+		, double const * const yIn
+		, double const * const zIn
+		, std::size_t const & numPnts
+		, double * const xOut
+		, double * const yOut
+		, double * const zOut
+		)
+	{
+		std::array<double, 9u> const & mm = aff.theMat;
+		std::array<double, 3u> const & oo = aff.theOff;
+		__m512d const m00{ _mm512_set1_pd(mm[0]) };
+		__m512d const m01{ _mm512_set1_pd(mm[1]) };
+		__m512d const m02{ _mm512_set1_pd(mm[2]) };
+		__m512d const m10{ _mm512_set1_pd(mm[3]) };
+		__m512d const m11{ _mm512_set1_pd(mm[4]) };
+		__m512d const m12{ _mm512_set1_pd(mm[5]) };
+		__m512d const m20{ _mm512_set1_pd(mm[6]) };
+		__m512d const m21{ _mm512_set1_pd(mm[7]) };
+		__m512d const m22{ _mm512_set1_pd(mm[8]) };
+		__m512d const o0{ _mm512_set1_pd(oo[0]) };
+		__m512d const o1{ _mm512_set1_pd(oo[1]) };
+		__m512d const o2{ _mm512_set1_pd(oo[2]) };
+		constexpr std::size_t width{ 8u };
+		std::size_t const numFull{ numPnts - (numPnts % width) };
+		for (std::size_t nn{0u} ; nn < numFull ; nn += width)
+		{
+			__m512d const x0{ _mm512_loadu_pd(xIn + nn) };
+			__m512d const x1{ _mm512_loadu_pd(yIn + nn) };
+			__m512d const x2{ _mm512_loadu_pd(zIn + nn) };
+			__m512d const y0
+				{ _mm512_fmadd_pd(m02, x2
+				, _mm512_fmadd_pd(m01, x1
+				, _mm512_fmadd_pd(m00, x0, o0)))
+				};
+			__m512d const y1
+				{ _mm512_fmadd_pd(m12, x2
+				, _mm512_fmadd_pd(m11, x1
+				, _mm512_fmadd_pd(m10, x0, o1)))
+				};
+			__m512d const y2
+				{ _mm512_fmadd_pd(m22, x2
+				, _mm512_fmadd_pd(m21, x1
+				, _mm512_fmadd_pd(m20, x0, o2)))
+				};
+			_mm512_storeu_pd(xOut + nn, y0);
+			_mm512_storeu_pd(yOut + nn, y1);
+			_mm512_storeu_pd(zOut + nn, y2);
+		}
+		kernelScalar
+			(aff, xIn, yIn, zIn, numFull, numPnts, xOut, yOut, zOut);
+	}
+
+#endif // Rigibra_SIMD_X86
+
+} // [anon]
+
+
+std::string
+nameFor
+	( Isa const & isa
+	)
+{
+	std::string name("Unknown");
+	switch (isa)
+	{
+		case Isa::Scalar: name = "Scalar"; break;
+		case Isa::SSE2: name = "SSE2"; break;
+		case Isa::AVX2: name = "AVX2"; break;
+		case Isa::AVX512: name = "AVX512"; break;
+	}
+	return name;
+}
+
+bool
+isSupported
+	( Isa const & isa
+	)
+{
+	bool okay{ false };
+	switch (isa)
+	{
+		case Isa::Scalar:
+			okay = true;
+			break;
+#if defined(Rigibra_SIMD_X86)
+		case Isa::SSE2:
+			__builtin_cpu_init();
+			okay = __builtin_cpu_supports("sse2");
+			break;
+		case Isa::AVX2:
+			__builtin_cpu_init();
+			okay =
+				(  __builtin_cpu_supports("avx2")
+				&& __builtin_cpu_supports("fma")
+				);
+			break;
+		case Isa::AVX512:
+			__builtin_cpu_init();
+			okay = __builtin_cpu_supports("avx512f");
+			break;
+#else
+		default:
+			break;
+#endif
+	}
+	return okay;
+}
+
+Isa
+bestIsa
+	()
+{
+	Isa isa{ Isa::Scalar };
+	for (Isa const & tryIsa : { Isa::SSE2, Isa::AVX2, Isa::AVX512 })
+	{
+		if (isSupported(tryIsa))
+		{
+			isa = tryIsa;
+		}
+	}
+	return isa;
+}
+
+void
+apply
+	( Isa const & isa
+	, Transform const & xfm
+	, double const * const xIn
+	, double const * const yIn
+	, double const * const zIn
+	, std::size_t const & numPnts
+	, double * const xOut
+	, double * const yOut
+	, double * const zOut
+	)
+{
+	Rigibra_INSTRUMENT_SCOPE_N(BatchElement, numPnts);
+	Affine const aff(xfm);
+	Isa const useIsa{ isSupported(isa) ? isa : Isa::Scalar };
+	switch (useIsa)
+	{
+#if defined(Rigibra_SIMD_X86)
+		case Isa::SSE2:
+			kernelSSE2(aff, xIn, yIn, zIn, numPnts, xOut, yOut, zOut);
+			break;
+		case Isa::AVX2:
+			kernelAVX2(aff, xIn, yIn, zIn, numPnts, xOut, yOut, zOut);
+			break;
+		case Isa::AVX512:
+			kernelAVX512(aff, xIn, yIn, zIn, numPnts, xOut, yOut, zOut);
+			break;
+#endif
+		default:
+			kernelScalar
+				(aff, xIn, yIn, zIn, 0u, numPnts, xOut, yOut, zOut);
+			break;
+	}
+}
+
+
+} // [simd]
+} // [rigibra]
+
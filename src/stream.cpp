@@ -0,0 +1,189 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/*! \file
+\brief Implementation code for rigibra::transformStream
+*/
+
+
+#include "stream.hpp"
+
+#include "func.hpp"
+
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+
+namespace rigibra
+{
+
+namespace
+{
+	using engabra::g3::Vector;
+
+	// Points are read and written directly as Vector arrays
+	static_assert
+		( (3u * sizeof(double)) == sizeof(Vector)
+		, "Vector must be 3 contiguous doubles"
+		);
+	static_assert
+		( std::is_trivially_copyable<Vector>::value
+		, "Vector must be trivially copyable"
+		);
+
+	//! Read up to maxPnts points from istrm. Return number read.
+	inline
+	std::size_t
+	readPoints
+		( std::istream & istrm
+		, Vector * const pnts
+		, std::size_t const & maxPnts
+		)
+	{
+		istrm.read
+			( reinterpret_cast<char *>(pnts)
+			, static_cast<std::streamsize>(maxPnts * sizeof(Vector))
+			);
+		std::size_t const numBytes{ static_cast<std::size_t>(istrm.gcount()) };
+		return (numBytes / sizeof(Vector));
+	}
+
+	//! Write numPnts points to ostrm.
+	inline
+	void
+	writePoints
+		( std::ostream & ostrm
+		, Vector const * const pnts
+		, std::size_t const & numPnts
+		)
+	{
+		ostrm.write
+			( reinterpret_cast<char const *>(pnts)
+			, static_cast<std::streamsize>(numPnts * sizeof(Vector))
+			);
+	}
+
+} // [anon]
+
+
+std::size_t
+transformStream
+	( ThreadPool & pool
+	, std::istream & istrm
+	, std::ostream & ostrm
+	, ChunkTransformFunc const & xfmForChunk
+	, std::size_t const & chunkSize
+	)
+{
+	std::size_t const useSize{ std::max(chunkSize, std::size_t{1u}) };
+
+	// Ring of buffers: chunk k uses buffer (k%3). During pipeline step
+	// s, chunk s is read, chunk s-1 is transformed and chunk s-2 is
+	// written (concurrently, by pool threads).
+	std::array<std::vector<Vector>, 3u> buffers;
+	for (std::vector<Vector> & buffer : buffers)
+	{
+		buffer.resize(useSize);
+	}
+	std::array<std::size_t, 3u> counts{}; // points in each buffer
+	std::array<Transform, 3u> xfms{}; // transform for each buffer
+
+	std::size_t numRead{ 0u };
+	std::size_t numDone{ 0u };
+	bool inputDone{ false };
+	for (std::size_t step{0u} ; ; ++step)
+	{
+		std::size_t const readNdx{ step % 3u };
+		std::size_t const xfmNdx{ (step + 2u) % 3u }; // step - 1
+		std::size_t const writeNdx{ (step + 1u) % 3u }; // step - 2
+		bool const doRead{ ! inputDone };
+		bool const doXfm{ (1u <= step) && (0u < counts[xfmNdx]) };
+		bool const doWrite{ (2u <= step) && (0u < counts[writeNdx]) };
+		if (! (doRead || doXfm || doWrite))
+		{
+			break;
+		}
+		if (doXfm)
+		{
+			// evaluated in this thread (function need not be thread safe)
+			std::size_t const pntNdx{ numRead - counts[xfmNdx] };
+			xfms[xfmNdx] = xfmForChunk(step - 1u, pntNdx);
+		}
+
+		std::size_t numGot{ 0u };
+		pool.parallelFor
+			( 3u
+			, 1u
+			, [&] (std::size_t const & beg, std::size_t const & end)
+				{
+					for (std::size_t stage{beg} ; stage < end ; ++stage)
+					{
+						if ((0u == stage) && doRead)
+						{
+							numGot = readPoints
+								(istrm, buffers[readNdx].data(), useSize);
+						}
+						else
+						if ((1u == stage) && doXfm)
+						{
+							Vector * const pnts{ buffers[xfmNdx].data() };
+							apply(xfms[xfmNdx], pnts, counts[xfmNdx], pnts);
+						}
+						else
+						if ((2u == stage) && doWrite)
+						{
+							writePoints
+								( ostrm, buffers[writeNdx].data()
+								, counts[writeNdx]
+								);
+						}
+					}
+				}
+			);
+
+		// stream states are only accessed between pipeline steps
+		if (doWrite)
+		{
+			if (! ostrm)
+			{
+				break;
+			}
+			numDone += counts[writeNdx];
+		}
+		counts[writeNdx] = 0u; // buffer is next used for reading
+		counts[readNdx] = numGot;
+		numRead += numGot;
+		if (doRead && (numGot < useSize))
+		{
+			// partial chunk indicates end of input
+			inputDone = true;
+		}
+	}
+	return numDone;
+}
+
+} // [rigibra]
+
@@ -0,0 +1,233 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::TransformBlock
+*/
+
+
+#include "block.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Transforms with a variety of parameter values
+	inline
+	std::vector<rigibra::Transform>
+	sampleTransforms
+		( std::size_t const & numXfms
+		, double const & offset
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+		std::vector<Transform> xfms;
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) + offset };
+			xfms.emplace_back
+				( Transform
+					{ Location{ dn, 1. - .5*dn, std::cos(dn) }
+					, Attitude(PhysAngle{ BiVector
+						{ std::sin(.3*dn), .2*std::cos(dn), .1*dn } })
+					}
+				);
+		}
+		return xfms;
+	}
+
+	//! Examples for documentation
+	void
+	testBlock
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		constexpr std::size_t numXfms{ 1001u };
+		std::vector<rigibra::Transform> const camWrtRefs
+			{ sampleTransforms(numXfms, 0.) };
+		std::vector<rigibra::Transform> const deltas
+			{ sampleTransforms(numXfms, .5) };
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// camera poses (e.g. in bundle adjustment) stored as SoA
+		TransformBlock const poses(camWrtRefs);
+		TransformBlock const updates(deltas);
+
+		// element-wise operations
+		TransformBlock const newPoses{ updates * poses };
+		TransformBlock const invPoses{ inverse(poses) };
+
+		// broadcast composition with a single transform
+		Transform const xRefWrtWorld
+			{ Location{ 100., 200., 0. }, Attitude(PhysAngle{ .5*e12 }) };
+		TransformBlock const posesWrtWorld{ poses * xRefWrtWorld };
+
+		// [DoxyExample01]
+
+		double const tol{ 1.e-12 };
+		SpinorTransform const sRefWrtWorld{ SpinorTransform::from(xRefWrtWorld) };
+		std::size_t errCount{ 0u };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			SpinorTransform const pose{ SpinorTransform::from(camWrtRefs[nn]) };
+			SpinorTransform const delta{ SpinorTransform::from(deltas[nn]) };
+			Transform const expNew{ (delta * pose).transform() };
+			Transform const expInv{ inverse(pose).transform() };
+			Transform const expWrtWorld{ (pose * sRefWrtWorld).transform() };
+			Transform const expLeft{ (sRefWrtWorld * pose).transform() };
+			if ( (! nearlyEquals(newPoses.transform(nn), expNew, tol))
+			  || (! nearlyEquals(invPoses.transform(nn), expInv, tol))
+			  || (! nearlyEquals(posesWrtWorld.transform(nn), expWrtWorld, tol))
+			   )
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of block operation test\n";
+					oss << "    nn: " << nn << '\n';
+					oss << "expNew: " << expNew << '\n';
+					oss << "gotNew: " << newPoses.transform(nn) << '\n';
+					oss << "expInv: " << expInv << '\n';
+					oss << "gotInv: " << invPoses.transform(nn) << '\n';
+				}
+			}
+			if (! (0u == nn % 97u))
+			{
+				continue;
+			}
+			TransformBlock const gotLeft{ sRefWrtWorld * poses };
+			if (! nearlyEquals(gotLeft.transform(nn), expLeft, tol))
+			{
+				oss << "Failure of left broadcast test\n";
+			}
+		}
+
+		// round trip through inverse
+		TransformBlock const ident{ invPoses * poses };
+		if (! nearlyEquals(ident.transform(7u), identity<Transform>(), tol))
+		{
+			oss << "Failure of inverse composition test\n";
+			oss << "got: " << ident.transform(7u) << '\n';
+		}
+	}
+
+	//! Check validity mask, alignment and size handling
+	void
+	testMask
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+
+		std::vector<Transform> xfms{ sampleTransforms(17u, 0.) };
+		xfms[3u] = rigibra::null<Transform>();
+		xfms[11u].theLoc[2] = std::numeric_limits<double>::infinity();
+		TransformBlock const block(xfms);
+
+		// null elements propagate through operations
+		TransformBlock const inv{ inverse(block) };
+		std::vector<std::uint8_t> const mask{ validMask(inv) };
+		if ( (0u != mask[3u])
+		  || (1u != mask[4u])
+		   )
+		{
+			oss << "Failure of valid mask test\n";
+		}
+
+		// mask agrees with isValid() (infinite location is not null)
+		for (TransformBlock const * const ptBlock : { &block, &inv })
+		{
+			std::vector<std::uint8_t> const gotMask{ validMask(*ptBlock) };
+			std::size_t errCount{ 0u };
+			for (std::size_t nn{0u} ; nn < ptBlock->size() ; ++nn)
+			{
+				bool const expValid{ isValid(ptBlock->spinorTransform(nn)) };
+				if (! ((1u == gotMask[nn]) == expValid))
+				{
+					++errCount;
+				}
+			}
+			if (0u != errCount)
+			{
+				oss << "Failure of valid mask isValid() test\n";
+				oss << "errCount: " << errCount << '\n';
+			}
+		}
+		if (! ((1u == validMask(block)[11u]) && (0u == validMask(block)[3u])))
+		{
+			oss << "Failure of valid mask infinity test\n";
+		}
+
+		std::uintptr_t const addr
+			{ reinterpret_cast<std::uintptr_t>(block.spinB1()) };
+		if (! (0u == (addr % sBlockAlignment)))
+		{
+			oss << "Failure of alignment test\n";
+		}
+
+		TransformBlock const bad{ block * TransformBlock(3u) };
+		if (! (0u == bad.size()))
+		{
+			oss << "Failure of size mismatch test\n";
+		}
+	}
+
+}
+
+//! Check behavior of TransformBlock
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testBlock(oss);
+	testMask(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
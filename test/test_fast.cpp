@@ -0,0 +1,181 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::FastAttitude,FastTransform
+*/
+
+
+#include "fast.hpp"
+#include "func.hpp"
+
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testFastXfm
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		std::vector<Vector> const pntsInRef
+			{ Vector{ 1., 2., 3. }
+			, Vector{ -7., 5., .5 }
+			, Vector{ .25, -.125, 11. }
+			};
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// A general transformation
+		Location const loc{ 2., -5., 3. };
+		PhysAngle const angle{ BiVector{ .7, -1.1, .3 } };
+		Transform const xfm{ loc, Attitude(angle) };
+
+		// Precompute spinor/matrix data once
+		FastTransform const fastXfm(xfm);
+
+		// then apply to many points (9 multiplies, 9 adds per point)
+		std::vector<Vector> pntsInBody;
+		pntsInBody.reserve(pntsInRef.size());
+		for (Vector const & pntInRef : pntsInRef)
+		{
+			pntsInBody.emplace_back(fastXfm(pntInRef));
+		}
+
+		// [DoxyExample01]
+
+		double const tol{ 32. * std::numeric_limits<double>::epsilon() };
+		for (std::size_t nn{0u} ; nn < pntsInRef.size() ; ++nn)
+		{
+			Vector const expPnt{ xfm(pntsInRef[nn]) };
+			Vector const & gotPnt = pntsInBody[nn];
+			if (! nearlyEquals(gotPnt, expPnt, tol))
+			{
+				Vector const difPnt{ gotPnt - expPnt };
+				oss << "Failure of fastXfm point test\n";
+				oss << "exp: " << expPnt << '\n';
+				oss << "got: " << gotPnt << '\n';
+				oss << "dif: " << io::enote(difPnt, 5u) << '\n';
+			}
+		}
+
+		// inverse also has a fast equivalent
+		FastTransform const fastInv(inverse(xfm));
+		for (std::size_t nn{0u} ; nn < pntsInRef.size() ; ++nn)
+		{
+			Vector const & expPnt = pntsInRef[nn];
+			Vector const gotPnt{ fastInv(pntsInBody[nn]) };
+			if (! nearlyEquals(gotPnt, expPnt, tol))
+			{
+				oss << "Failure of fastXfm inverse test\n";
+				oss << "exp: " << expPnt << '\n';
+				oss << "got: " << gotPnt << '\n';
+			}
+		}
+	}
+
+	//! Check that FastAttitude matches Attitude across many angles
+	void
+	testFastAtt
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		Vector const vecX{ .3, -.7, 1.9 };
+		double const tol{ 16. * std::numeric_limits<double>::epsilon() };
+		std::size_t errCount{ 0u };
+		// include angles larger than a half turn
+		for (double mag{ 0. } ; mag < (2.*turnFull) ; mag += .375)
+		{
+			for (BiVector const & dir : { e12, e23, e31, direction(e12-e23+e31) })
+			{
+				Attitude const att(PhysAngle{ mag * dir });
+				FastAttitude const fastAtt(att);
+
+				Vector const expVecY{ att(vecX) };
+				Vector const gotVecY{ fastAtt(vecX) };
+				if (! nearlyEquals(gotVecY, expVecY, tol))
+				{
+					if (0u == errCount++)
+					{
+						oss << "Failure of fastAtt vector test\n";
+						oss << "mag: " << mag << " dir: " << dir << '\n';
+						oss << "exp: " << expVecY << '\n';
+						oss << "got: " << gotVecY << '\n';
+					}
+				}
+			}
+		}
+
+		// null attitude should produce a null fast attitude
+		FastAttitude const fastNull(rigibra::null<Attitude>());
+		if (fastNull.isValid())
+		{
+			oss << "Failure of fastNull validity test\n";
+		}
+		FastTransform const fastNullXfm(rigibra::null<Transform>());
+		if (fastNullXfm.isValid())
+		{
+			oss << "Failure of fastNullXfm validity test\n";
+		}
+	}
+
+}
+
+//! Check behavior of FastAttitude and FastTransform
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testFastXfm(oss);
+	testFastAtt(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
@@ -0,0 +1,328 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::FitAccumulator
+*/
+
+
+#include "fit.hpp"
+#include "func.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Points distributed (irregularly) around center
+	std::vector<engabra::g3::Vector>
+	samplePoints
+		( std::size_t const & numPnts
+		, engabra::g3::Vector const & center
+		)
+	{
+		std::vector<engabra::g3::Vector> pnts;
+		pnts.reserve(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			pnts.emplace_back(engabra::g3::Vector
+				{ center[0] + 3.*std::sin(.7*dn)
+				, center[1] + 2.*std::cos(1.3*dn + .5)
+				, center[2] + std::sin(2.9*dn + .2)
+				});
+		}
+		return pnts;
+	}
+
+	//! Transformation of each point (plus optional pseudo-random noise)
+	std::vector<engabra::g3::Vector>
+	transformed
+		( rigibra::Transform const & xfm
+		, std::vector<engabra::g3::Vector> const & froms
+		, double const & noiseMag = 0.
+		)
+	{
+		std::vector<engabra::g3::Vector> intos;
+		intos.reserve(froms.size());
+		for (std::size_t nn{0u} ; nn < froms.size() ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			engabra::g3::Vector const noise
+				{ noiseMag * std::sin(11.3*dn)
+				, noiseMag * std::cos(7.1*dn)
+				, noiseMag * std::sin(5.7*dn + 1.)
+				};
+			intos.emplace_back(engabra::g3::operator+(xfm(froms[nn]), noise));
+		}
+		return intos;
+	}
+
+	//! True if transforms are (nearly) the same
+	bool
+	sameXfm
+		( rigibra::Transform const & xfmA
+		, rigibra::Transform const & xfmB
+		, double const & tol
+		)
+	{
+		using namespace engabra::g3;
+		Vector const pnt{ 1.5, -.5, 2. };
+		return
+			(  nearlyEquals(xfmA.theLoc, xfmB.theLoc, tol)
+			&& nearlyEquals(xfmA.theAtt(pnt), xfmB.theAtt(pnt), tol)
+			);
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+		Transform const expXfm
+			{ Location{ 1., -2., 3. }, Attitude(PhysAngle{ .3, -1.2, 2.1 }) };
+		std::vector<Vector> const froms
+			{ samplePoints(100u, Vector{ 10., 20., 30. }) };
+		std::vector<Vector> const intos{ transformed(expXfm, froms) };
+
+		// [DoxyExample01]
+
+		// correspondences may be added individually or in bulk
+		FitAccumulator accum;
+		accum.add(froms[0], intos[0]);
+		accum.add(froms.data() + 1u, intos.data() + 1u, froms.size() - 1u);
+
+		// accumulators (e.g. from other threads) may be combined
+		FitAccumulator const other;
+		accum.merge(other);
+
+		// solution cost is independent of number of correspondences
+		Transform const gotXfm{ accum.transform() }; // y = xfm(x)
+		double const sumSq{ accum.residualSumSquared() }; // near zero here
+
+		// [DoxyExample01]
+
+		double const tol{ 1.e-13 };
+		if (! sameXfm(gotXfm, expXfm, tol))
+		{
+			oss << "Failure of fit test\n";
+			oss << "exp: " << expXfm << '\n';
+			oss << "got: " << gotXfm << '\n';
+		}
+		// difference of moments: precision relative to point spread
+		if (! (std::abs(sumSq) < 1.e-9))
+		{
+			oss << "Failure of exact fit residual test\n";
+			oss << "sumSq: " << sumSq << '\n';
+		}
+	}
+
+	//! Check streaming, batch, merged, weighted and pool accumulation
+	void
+	testAccumulation
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+		Transform const xfm
+			{ Location{ -4., 5., .5 }, Attitude(PhysAngle{ 2.9, .1, -.4 }) };
+		std::size_t const numPnts{ 5000u };
+		std::vector<Vector> const froms
+			{ samplePoints(numPnts, Vector{ -1., 2., 0. }) };
+		std::vector<Vector> intos{ transformed(xfm, froms, .01) };
+
+		FitAccumulator single;
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			single.add(froms[nn], intos[nn]);
+		}
+		FitAccumulator const batch
+			{ fitAccumulatorFor(froms.data(), intos.data(), numPnts) };
+		FitAccumulator merged
+			{ fitAccumulatorFor(froms.data(), intos.data(), 1234u) };
+		merged.merge(fitAccumulatorFor
+			(froms.data() + 1234u, intos.data() + 1234u, numPnts - 1234u));
+		ThreadPool pool(3u);
+		FitAccumulator const pooled
+			{ fitAccumulatorFor
+				(pool, froms.data(), intos.data(), numPnts, nullptr, 512u)
+			};
+
+		double const tol{ 1.e-12 };
+		Transform const expXfm{ single.transform() };
+		if (! ( sameXfm(batch.transform(), expXfm, tol)
+			 && sameXfm(merged.transform(), expXfm, tol)
+			 && sameXfm(pooled.transform(), expXfm, tol)
+			 && (numPnts == pooled.size())
+			  ))
+		{
+			oss << "Failure of accumulation consistency test\n";
+			oss << "single: " << expXfm << '\n';
+			oss << "batch: " << batch.transform() << '\n';
+			oss << "merged: " << merged.transform() << '\n';
+			oss << "pooled: " << pooled.transform() << '\n';
+		}
+
+		// noise is small: solution near true transform
+		if (! sameXfm(expXfm, xfm, 1.e-3))
+		{
+			oss << "Failure of noisy fit test\n";
+			oss << "exp: " << xfm << '\n';
+			oss << "got: " << expXfm << '\n';
+		}
+
+		// residual from moments agrees with explicit evaluation
+		double expSumSq{ 0. };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			Vector const dif{ intos[nn] - expXfm(froms[nn]) };
+			expSumSq += magnitude(dif) * magnitude(dif);
+		}
+		double const gotSumSq{ pooled.residualSumSquared() };
+		if (! nearlyEquals(gotSumSq, expSumSq, 1.e-9))
+		{
+			oss << "Failure of residual sum test\n";
+			oss << "exp: " << expSumSq << '\n';
+			oss << "got: " << gotSumSq << '\n';
+		}
+
+		// zero weight and null (outlier) pairs are ignored
+		std::vector<double> weights(numPnts, 1.);
+		intos[17u] = Vector{ 100., 100., 100. };
+		weights[17u] = 0.;
+		intos[18u] = engabra::g3::null<Vector>();
+		FitAccumulator const weighted
+			{ fitAccumulatorFor
+				(froms.data(), intos.data(), numPnts, weights.data())
+			};
+		FitAccumulator streamed;
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			streamed.add(froms[nn], intos[nn], weights[nn]);
+		}
+		if (! ( ((numPnts - 2u) == weighted.size())
+			 && ((numPnts - 2u) == streamed.size())
+			 && sameXfm(weighted.transform(), streamed.transform(), tol)
+			 && sameXfm(weighted.transform(), xfm, 1.e-3)
+			  ))
+		{
+			oss << "Failure of weighted fit test\n";
+			oss << "size: " << weighted.size() << '\n';
+			oss << "weighted: " << weighted.transform() << '\n';
+			oss << "streamed: " << streamed.transform() << '\n';
+		}
+	}
+
+	//! Check precision with large coordinate offsets and degenerate cases
+	void
+	testConditioning
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+
+		// e.g. map coordinates with large offsets in both frames
+		Transform const xfm
+			{ Location{ 5.e5, 4.e6, 100. }
+			, Attitude(PhysAngle{ -.2, .4, 1.3 })
+			};
+		std::vector<Vector> const froms
+			{ samplePoints(10000u, Vector{ 5.e5 + 30., 4.e6 - 20., 110. }) };
+		std::vector<Vector> const intos{ transformed(xfm, froms) };
+		FitAccumulator streamed;
+		for (std::size_t nn{0u} ; nn < froms.size() ; ++nn)
+		{
+			streamed.add(froms[nn], intos[nn]);
+		}
+		Transform const gotXfm{ streamed.transform() };
+		if (! ( nearlyEquals(gotXfm.theLoc, xfm.theLoc, 1.e-14)
+			 && sameXfm(gotXfm, xfm, 1.e-10)
+			  ))
+		{
+			oss << "Failure of large offset fit test\n";
+			oss << "exp: " << xfm << '\n';
+			oss << "got: " << gotXfm << '\n';
+		}
+
+		// too few points
+		FitAccumulator few;
+		few.add(froms[0], intos[0]);
+		few.add(froms[1], intos[1]);
+		// collinear points
+		FitAccumulator line;
+		for (std::size_t nn{0u} ; nn < 10u ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			Vector const pnt{ dn, 2.*dn, -dn };
+			line.add(pnt, xfm(pnt));
+		}
+		FitAccumulator const empty;
+		if (! ( (! rigibra::isValid(few.transform()))
+			 && (! rigibra::isValid(line.transform()))
+			 && (! rigibra::isValid(empty.transform()))
+			 && (! rigibra::isValid(empty.spinorTransform()))
+			  ))
+		{
+			oss << "Failure of degenerate fit test\n";
+			oss << "few: " << few.transform() << '\n';
+			oss << "line: " << line.transform() << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of Transform fitting functions
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testAccumulation(oss);
+	testConditioning(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
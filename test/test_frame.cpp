@@ -0,0 +1,248 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::FrameTree
+*/
+
+
+#include "frame.hpp"
+
+#include <iostream>
+#include <sstream>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testTree
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+		using FrameId = FrameTree::FrameId;
+
+		// vehicle body in world, sensors on a mount on the body
+		FrameTree tree;
+		Transform const xBodyWrtWorld
+			{ Location{ 100., 200., 5. }, Attitude(PhysAngle{ .3 * e12 }) };
+		Transform const xMountWrtBody
+			{ Location{ 1., 0., -.5 }, Attitude(PhysAngle{ .1 * e23 }) };
+		Transform const xCamWrtMount
+			{ Location{ .2, .1, 0. }, Attitude(PhysAngle{ -.2 * e31 }) };
+		Transform const xLidarWrtBody
+			{ Location{ -1., .5, .7 }, Attitude(PhysAngle{ .4 * e12 }) };
+
+		FrameId const body{ tree.addFrame(tree.rootId(), xBodyWrtWorld) };
+		FrameId const mount{ tree.addFrame(body, xMountWrtBody) };
+		FrameId const cam{ tree.addFrame(mount, xCamWrtMount) };
+		FrameId const lidar{ tree.addFrame(body, xLidarWrtBody) };
+
+		// Transform of camera wrt world (cached)
+		Transform const xCamWrtWorld{ tree.world(cam) };
+
+		// Transform of camera wrt lidar (through body, the common ancestor)
+		Transform const xCamWrtLidar{ tree.relative(lidar, cam) };
+
+		// Vehicle motion invalidates world transforms of subtree only
+		Transform const xBodyWrtWorld2
+			{ Location{ 101., 199., 5. }, Attitude(PhysAngle{ .35 * e12 }) };
+		tree.setLocal(body, xBodyWrtWorld2);
+
+		// [DoxyExample01]
+
+		double const tol{ 1.e-12 };
+
+		// compare with explicit compositions
+		Transform const expCamWrtWorld
+			{ xCamWrtMount * xMountWrtBody * xBodyWrtWorld };
+		if (! nearlyEquals(xCamWrtWorld, expCamWrtWorld, tol))
+		{
+			oss << "Failure of world test\n";
+			oss << "exp: " << expCamWrtWorld << '\n';
+			oss << "got: " << xCamWrtWorld << '\n';
+		}
+
+		Transform const expCamWrtLidar
+			{ xCamWrtMount * xMountWrtBody * inverse(xLidarWrtBody) };
+		if (! nearlyEquals(xCamWrtLidar, expCamWrtLidar, tol))
+		{
+			oss << "Failure of relative test\n";
+			oss << "exp: " << expCamWrtLidar << '\n';
+			oss << "got: " << xCamWrtLidar << '\n';
+		}
+
+		// after update: world changes, relative within vehicle does not
+		Transform const expCamWrtWorld2
+			{ xCamWrtMount * xMountWrtBody * xBodyWrtWorld2 };
+		Transform const gotCamWrtWorld2{ tree.world(cam) };
+		if (! nearlyEquals(gotCamWrtWorld2, expCamWrtWorld2, tol))
+		{
+			oss << "Failure of world after update test\n";
+			oss << "exp: " << expCamWrtWorld2 << '\n';
+			oss << "got: " << gotCamWrtWorld2 << '\n';
+		}
+		Transform const gotCamWrtLidar2{ tree.relative(lidar, cam) };
+		if (! nearlyEquals(gotCamWrtLidar2, expCamWrtLidar, tol))
+		{
+			oss << "Failure of relative after update test\n";
+			oss << "exp: " << expCamWrtLidar << '\n';
+			oss << "got: " << gotCamWrtLidar2 << '\n';
+		}
+
+		// changing mount must update cached relative transform
+		Transform const xMountWrtBody3
+			{ Location{ 1.1, 0., -.5 }, Attitude(PhysAngle{ .15 * e23 }) };
+		tree.setLocal(mount, xMountWrtBody3);
+		Transform const expCamWrtLidar3
+			{ xCamWrtMount * xMountWrtBody3 * inverse(xLidarWrtBody) };
+		Transform const gotCamWrtLidar3{ tree.relative(lidar, cam) };
+		if (! nearlyEquals(gotCamWrtLidar3, expCamWrtLidar3, tol))
+		{
+			oss << "Failure of relative after mount update test\n";
+			oss << "exp: " << expCamWrtLidar3 << '\n';
+			oss << "got: " << gotCamWrtLidar3 << '\n';
+		}
+
+		// world of lidar is unaffected by mount change
+		Transform const expLidarWrtWorld{ xLidarWrtBody * xBodyWrtWorld2 };
+		if (! nearlyEquals(tree.world(lidar), expLidarWrtWorld, tol))
+		{
+			oss << "Failure of sibling world test\n";
+			oss << "exp: " << expLidarWrtWorld << '\n';
+			oss << "got: " << tree.world(lidar) << '\n';
+		}
+
+		// relative between frame and root is world transform
+		if (! nearlyEquals(tree.relative(tree.rootId(), cam), tree.world(cam), tol))
+		{
+			oss << "Failure of relative to root test\n";
+		}
+	}
+
+	//! Check handling of invalid arguments
+	void
+	testInvalid
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		FrameTree tree;
+		FrameTree::FrameId const badId{ tree.addFrame(17u, identity<Transform>()) };
+		if (! (FrameTree::sNullId == badId))
+		{
+			oss << "Failure of invalid parent test\n";
+		}
+		if (isValid(tree.world(17u)) || isValid(tree.relative(0u, 17u)))
+		{
+			oss << "Failure of invalid query test\n";
+		}
+		if (tree.setLocal(tree.rootId(), identity<Transform>()))
+		{
+			oss << "Failure of root setLocal test\n";
+		}
+		if (! (1u == tree.size()))
+		{
+			oss << "Failure of size test\n";
+		}
+	}
+
+
+	//! Check that relative() cache size remains bounded
+	void
+	testCacheBound
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using engabra::g3::e12;
+		FrameTree tree;
+		constexpr std::size_t numFrames{ 80u };
+		Transform const xfm
+			{ Location{ 1., 0., 0. }, Attitude(SpinAngle{ .1 * e12 }) };
+		for (std::size_t nn{0u} ; nn < numFrames ; ++nn)
+		{
+			tree.addFrame(nn, xfm); // chain of frames
+		}
+
+		// query more pairs than can be cached
+		std::size_t errCount{ 0u };
+		for (std::size_t idA{0u} ; idA < tree.size() ; ++idA)
+		{
+			for (std::size_t idB{0u} ; idB < tree.size() ; ++idB)
+			{
+				Transform const got{ tree.relative(idA, idB) };
+				Transform const exp
+					{ tree.world(idB) * inverse(tree.world(idA)) };
+				if (! nearlyEquals(got, exp, 1.e-12))
+				{
+					++errCount;
+				}
+			}
+		}
+		if (! ( (0u == errCount)
+			 && (tree.numCachedRelatives() <= FrameTree::sMaxRelatives)
+			 && (0u < tree.numCachedRelatives())
+			  ))
+		{
+			oss << "Failure of relative cache bound test\n";
+			oss << "errCount: " << errCount << '\n';
+			oss << "numCached: " << tree.numCachedRelatives() << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of FrameTree
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testTree(oss);
+	testInvalid(oss);
+	testCacheBound(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
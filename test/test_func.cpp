@@ -30,9 +30,11 @@
 
 #include "func.hpp"
 
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 
 namespace
@@ -250,6 +252,385 @@ namespace
 		}
 
 	}
+
+	//! Check SpinorTransform composition matches Transform composition
+	void
+	testSpinorCompose
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		// a kinematic chain of transforms
+		std::vector<Transform> xfms;
+		for (std::size_t nn{0u} ; nn < 25u ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			Location const loc{ .5*dn, 1. - .25*dn, std::sin(dn) };
+			PhysAngle const angle{ BiVector{ std::cos(dn), .3, -.2*dn } };
+			xfms.emplace_back(Transform{ loc, Attitude(angle) });
+		}
+
+		Transform expXfm{ identity<Transform>() };
+		SpinorTransform gotSpinXfm{ identity<SpinorTransform>() };
+		for (Transform const & xfm : xfms)
+		{
+			expXfm = xfm * expXfm;
+			gotSpinXfm = SpinorTransform::from(xfm) * gotSpinXfm;
+		}
+		Transform const gotXfm{ gotSpinXfm.transform() };
+
+		double const tol{ 1.e-12 };
+		Vector const pnt{ -2., 3., 5. };
+		if ( (! nearlyEquals(gotXfm, expXfm, tol))
+		  || (! nearlyEquals(gotSpinXfm(pnt), expXfm(pnt), tol))
+		   )
+		{
+			oss << "Failure of SpinorTransform chain test\n";
+			oss << "exp: " << expXfm << '\n';
+			oss << "got: " << gotXfm << '\n';
+		}
+
+		// inverse
+		SpinorTransform const gotInv{ inverse(gotSpinXfm) };
+		Transform const expInv{ inverse(expXfm) };
+		if (! nearlyEquals(gotInv.transform(), expInv, tol))
+		{
+			oss << "Failure of SpinorTransform inverse test\n";
+			oss << "exp: " << expInv << '\n';
+			oss << "got: " << gotInv << '\n';
+		}
+		SpinorTransform const gotIdent{ gotInv * gotSpinXfm };
+		if (! nearlyEquals(gotIdent(pnt), pnt, tol))
+		{
+			oss << "Failure of SpinorTransform inverse identity test\n";
+			oss << "exp: " << pnt << '\n';
+			oss << "got: " << gotIdent(pnt) << '\n';
+		}
+
+		// null propagation
+		SpinorTransform const gotNull
+			{ rigibra::null<SpinorTransform>() * gotSpinXfm };
+		if (isValid(gotNull))
+		{
+			oss << "Failure of SpinorTransform null composition test\n";
+			oss << "got: " << gotNull << '\n';
+		}
+	}
+
+	//! Check batch transformation of AoS and SoA data
+	void
+	testBatch
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		// [DoxyExampleBatch]
+
+		using namespace rigibra;
+
+		Location const loc{ 1.5, -2.5, 4. };
+		PhysAngle const angle{ BiVector{ -.4, .9, 1.3 } };
+		Transform const xfm{ loc, Attitude(angle) };
+
+		// Array of structures (e.g. std::vector<Vector>)
+		std::vector<Vector> const pntsIn
+			{ Vector{ 1., 2., 3. }
+			, Vector{ -3., 5., 7. }
+			, Vector{ 11., -13., 17. }
+			, Vector{ -.5, .25, -.125 }
+			, Vector{ 0., 0., 0. }
+			};
+		std::vector<Vector> const pntsOut{ apply(xfm, pntsIn) };
+
+		// Structure of arrays (e.g. separate coordinate buffers)
+		std::size_t const numPnts{ pntsIn.size() };
+		std::vector<double> xs(numPnts), ys(numPnts), zs(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			xs[nn] = pntsIn[nn][0];
+			ys[nn] = pntsIn[nn][1];
+			zs[nn] = pntsIn[nn][2];
+		}
+		// transform in-place
+		apply
+			( xfm
+			, xs.data(), ys.data(), zs.data(), numPnts
+			, xs.data(), ys.data(), zs.data()
+			);
+
+		// [DoxyExampleBatch]
+
+		double const tol{ 64. * std::numeric_limits<double>::epsilon() };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			Vector const expPnt{ xfm(pntsIn[nn]) };
+			Vector const gotAoS{ pntsOut[nn] };
+			Vector const gotSoA{ xs[nn], ys[nn], zs[nn] };
+			if ( (! nearlyEquals(gotAoS, expPnt, tol))
+			  || (! nearlyEquals(gotSoA, expPnt, tol))
+			   )
+			{
+				oss << "Failure of batch apply test\n";
+				oss << "   exp: " << expPnt << '\n';
+				oss << "gotAoS: " << gotAoS << '\n';
+				oss << "gotSoA: " << gotSoA << '\n';
+			}
+		}
+	}
+
+	//! Check rotation-only batch operations
+	void
+	testRotate
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		// [DoxyExampleRotate]
+
+		using namespace rigibra;
+
+		Transform const xfm
+			{ Location{ 1.5, -2.5, 4. }
+			, Attitude(PhysAngle{ BiVector{ -.4, .9, 1.3 } })
+			};
+
+		// surface normals (directions) are rotated but not translated
+		std::vector<Vector> const nrmsIn
+			{ Vector{ 1., 0., 0. }
+			, direction(Vector{ 1., -2., 3. })
+			, direction(Vector{ -.5, .25, -.125 })
+			};
+		std::vector<Vector> const nrmsOut{ rotate(xfm.theAtt, nrmsIn) };
+
+		// plane orientations, angular rates, etc. are bivectors
+		std::vector<BiVector> const bivsIn
+			{ BiVector{ 1., 0., 0. }
+			, BiVector{ .3, -.7, 1.9 }
+			};
+		std::vector<BiVector> const bivsOut{ rotate(xfm.theAtt, bivsIn) };
+
+		// [DoxyExampleRotate]
+
+		double const tol{ 64. * std::numeric_limits<double>::epsilon() };
+		Spinor const spin{ xfm.theAtt.spinor() };
+		for (std::size_t nn{0u} ; nn < nrmsIn.size() ; ++nn)
+		{
+			Vector const expNrm{ xfm.theAtt(nrmsIn[nn]) };
+			Vector const & gotNrm = nrmsOut[nn];
+
+			// SoA in-place
+			double xx{ nrmsIn[nn][0] }, yy{ nrmsIn[nn][1] }, zz{ nrmsIn[nn][2] };
+			rotate(xfm.theAtt, &xx, &yy, &zz, 1u, &xx, &yy, &zz);
+			Vector const gotSoA{ xx, yy, zz };
+
+			if ( (! nearlyEquals(gotNrm, expNrm, tol))
+			  || (! nearlyEquals(gotSoA, expNrm, tol))
+			   )
+			{
+				oss << "Failure of rotate vector test\n";
+				oss << "   exp: " << expNrm << '\n';
+				oss << "gotAoS: " << gotNrm << '\n';
+				oss << "gotSoA: " << gotSoA << '\n';
+			}
+		}
+		for (std::size_t nn{0u} ; nn < bivsIn.size() ; ++nn)
+		{
+			// full sandwich product: spin * biv * reverse(spin)
+			Spinor const bivSpin{ 0., bivsIn[nn][0], bivsIn[nn][1], bivsIn[nn][2] };
+			Spinor const expSpin{ (spin * bivSpin) * reverse(spin) };
+			BiVector const & expBiv = expSpin.theBiv;
+			BiVector const & gotBiv = bivsOut[nn];
+			if (! nearlyEquals(gotBiv, expBiv, tol))
+			{
+				oss << "Failure of rotate bivector test\n";
+				oss << "exp: " << expBiv << '\n';
+				oss << "got: " << gotBiv << '\n';
+			}
+		}
+	}
+
+	//! Check unchecked (NaN propagating) composition
+	void
+	testUnchecked
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		Transform const xfmA
+			{ Location{ 1.5, -2.5, 4. }
+			, Attitude(PhysAngle{ BiVector{ -.4, .9, 1.3 } })
+			};
+		Transform const xfmB
+			{ Location{ -.7, 3., .25 }
+			, Attitude(PhysAngle{ BiVector{ 1.1, .2, -.6 } })
+			};
+
+		// valid inputs - same result as checked composition
+		double const tol{ 64. * std::numeric_limits<double>::epsilon() };
+		Transform const expXfm{ xfmB * xfmA };
+		Transform const gotXfm{ composeUnchecked(xfmB, xfmA) };
+		if (! nearlyEquals(gotXfm, expXfm, tol))
+		{
+			oss << "Failure of composeUnchecked(Transform) test\n";
+			oss << "exp: " << expXfm << '\n';
+			oss << "got: " << gotXfm << '\n';
+		}
+		SpinorTransform const spinA{ SpinorTransform::from(xfmA) };
+		SpinorTransform const spinB{ SpinorTransform::from(xfmB) };
+		SpinorTransform const expSpin{ spinB * spinA };
+		SpinorTransform const gotSpin{ composeUnchecked(spinB, spinA) };
+		if (! nearlyEquals(gotSpin.transform(), expSpin.transform(), tol))
+		{
+			oss << "Failure of composeUnchecked(SpinorTransform) test\n";
+		}
+
+		// null inputs (in any component) must produce invalid results
+		double const nan{ std::numeric_limits<double>::quiet_NaN() };
+		Transform xfmNullLoc{ xfmA };
+		xfmNullLoc.theLoc[1] = nan;
+		Transform xfmNullAtt{ xfmA };
+		xfmNullAtt.theAtt = Attitude(SpinAngle{ BiVector{ .1, nan, .2 } });
+		std::vector<Transform> const nullXfms
+			{ rigibra::null<Transform>(), xfmNullLoc, xfmNullAtt };
+		std::size_t errCount{ 0u };
+		for (Transform const & nullXfm : nullXfms)
+		{
+			SpinorTransform const nullSpin
+				{ nullXfm.theLoc, SpinorAttitude(nullXfm.theAtt.spinor()) };
+			bool const okNull
+				{  (! isValid(composeUnchecked(nullXfm, xfmA)))
+				&& (! isValid(composeUnchecked(xfmB, nullXfm)))
+				&& (! isValid(composeUnchecked(nullSpin, spinA)))
+				&& (! isValid(composeUnchecked(spinB, nullSpin)))
+				};
+			// branch free batch apply also propagates null
+			Vector const pnt{ 1., 2., 3. };
+			Vector pntOut{};
+			apply(nullXfm, &pnt, 1u, &pntOut);
+			bool const okApply{ ! isValid(pntOut) };
+			if (! (okNull && okApply))
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of unchecked null propagation test\n";
+					oss << "nullXfm: " << nullXfm << '\n';
+					oss << "okNull: " << okNull << '\n';
+					oss << "okApply: " << okApply << '\n';
+				}
+			}
+		}
+
+		// batch (pairwise) form
+		std::vector<SpinorTransform> const xBwAs
+			{ spinB, rigibra::null<SpinorTransform>(), spinA };
+		std::vector<SpinorTransform> const xAwXs{ spinA, spinA, spinB };
+		std::vector<SpinorTransform> xBwXs(xBwAs.size());
+		composeUnchecked
+			(xBwAs.data(), xAwXs.data(), xBwAs.size(), xBwXs.data());
+		if (! ( isValid(xBwXs[0])
+			 && (! isValid(xBwXs[1]))
+			 && nearlyEquals
+				(xBwXs[2].transform(), (spinA * spinB).transform(), tol)
+			  ))
+		{
+			oss << "Failure of batch composeUnchecked test\n";
+		}
+	}
+
+	//! Check compile time evaluation
+	void
+	testConstexpr
+		( std::ostream & oss
+		)
+	{
+		// [DoxyExampleConstexpr]
+
+		using namespace rigibra;
+
+		// identity, null and inverse of identity are constant expressions
+		constexpr Transform xIdent{ identity<Transform>() };
+		constexpr Transform xIdentInv{ inverse(xIdent) };
+		constexpr Transform xNull{ null<Transform>() };
+		static_assert(0. == xIdentInv.theLoc[0], "constexpr inverse");
+
+		// fixed sensor mounting (e.g. calibration values)
+		constexpr double sq{ 0.70710678118654752440 }; // sqrt(1/2)
+		constexpr SpinorTransform xImuWrtBody
+			{ Location{ .5, 0., -.25 }
+			, SpinorAttitude(engabra::g3::Spinor{ sq, 0., 0., sq })
+			};
+		constexpr SpinorTransform xCamWrtImu
+			{ Location{ 0., .1, 0. }
+			, SpinorAttitude(engabra::g3::Spinor{ sq, sq, 0., 0. })
+			};
+
+		// composition (and inversion) evaluated at compile time
+		constexpr SpinorTransform xCamWrtBody{ xCamWrtImu * xImuWrtBody };
+		constexpr SpinorTransform xBodyWrtCam{ inverse(xCamWrtBody) };
+
+		// [DoxyExampleConstexpr]
+
+		static_assert(xCamWrtBody.isValid(), "constexpr composition");
+		static_assert(! isFinite(xNull.theLoc[0]), "constexpr null");
+
+		// only null (NaN) values are invalid
+		constexpr double inf{ std::numeric_limits<double>::infinity() };
+		constexpr SpinorTransform xInf
+			{ Location{ inf, -inf, 0. }, identity<SpinorAttitude>() };
+		static_assert(xInf.isValid(), "constexpr isValid infinity");
+		static_assert(! null<SpinorTransform>().isValid(), "constexpr null");
+
+		// compare with run time evaluation
+		Transform const expCamWrtBody
+			{ xCamWrtImu.transform() * xImuWrtBody.transform() };
+		Transform const gotCamWrtBody{ xCamWrtBody.transform() };
+		if (! nearlyEquals(gotCamWrtBody, expCamWrtBody))
+		{
+			oss << "Failure of constexpr composition test\n";
+			oss << "exp: " << expCamWrtBody << '\n';
+			oss << "got: " << gotCamWrtBody << '\n';
+		}
+		Transform const expBodyWrtCam{ inverse(expCamWrtBody) };
+		Transform const gotBodyWrtCam{ xBodyWrtCam.transform() };
+		if (! nearlyEquals(gotBodyWrtCam, expBodyWrtCam))
+		{
+			oss << "Failure of constexpr inverse test\n";
+			oss << "exp: " << expBodyWrtCam << '\n';
+			oss << "got: " << gotBodyWrtCam << '\n';
+		}
+		if (isValid(xNull) || (! nearlyEquals(xIdentInv, xIdent)))
+		{
+			oss << "Failure of constexpr null/identity test\n";
+		}
+
+		// zero attitude (constexpr) path same as general evaluation
+		using engabra::g3::e12;
+		Transform const xShift
+			{ Location{ .5, -1.25, 3. }, identity<Attitude>() };
+		Location const expShiftLoc{ -xShift.theAtt(xShift.theLoc) };
+		Transform const gotShift{ inverse(xShift) };
+		bool const sameShift
+			{  (expShiftLoc[0] == gotShift.theLoc[0])
+			&& (expShiftLoc[1] == gotShift.theLoc[1])
+			&& (expShiftLoc[2] == gotShift.theLoc[2])
+			};
+		// and continuous with (general) near zero attitude path
+		Transform const xNear
+			{ xShift.theLoc, Attitude(SpinAngle{ 1.e-300 * e12 }) };
+		if (! (sameShift && nearlyEquals(inverse(xNear), gotShift)))
+		{
+			oss << "Failure of zero attitude inverse test\n";
+			oss << "exp: " << expShiftLoc << '\n';
+			oss << "got: " << gotShift.theLoc << '\n';
+		}
+	}
+
 }
 
 //! Check behavior of func
@@ -263,6 +644,11 @@ main
 	testIdentInverses(oss);
 	testInverse(oss);
 	testComposite(oss);
+	testSpinorCompose(oss);
+	testBatch(oss);
+	testRotate(oss);
+	testUnchecked(oss);
+	testConstexpr(oss);
 
 	if (oss.str().empty()) // Only pass if no errors were encountered
 	{
@@ -0,0 +1,298 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::instrument
+*/
+
+
+#include "instrument.hpp"
+#include "block.hpp"
+#include "func.hpp"
+#include "matrix.hpp"
+#include "precision.hpp"
+#include "simd.hpp"
+#include "trajectory.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using rigibra::Attitude;
+		using rigibra::Location;
+		using rigibra::PhysAngle;
+		using rigibra::Transform;
+		Transform const xfmA
+			{ Location{ 1., 2., 3. }
+			, Attitude(PhysAngle{ BiVector{ .1, -.2, .3 } })
+			};
+		Transform const xfmB
+			{ Location{ -.5, .25, 7. }
+			, Attitude(PhysAngle{ BiVector{ -.7, .4, 1.1 } })
+			};
+		std::vector<Vector> const pnts(100u, Vector{ 1., 2., 3. });
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// record activity before some code of interest
+		instrument::Snapshot const snapBeg{ instrument::snapshot() };
+
+		Transform const xfmAB{ xfmA * xfmB };
+		Transform const xfmInv{ inverse(xfmAB) };
+		std::vector<Vector> const pntsOut{ apply(xfmInv, pnts) };
+
+		// activity (all threads) attributable to code of interest
+		instrument::Snapshot const snapEnd{ instrument::snapshot() };
+		instrument::Snapshot const delta{ snapEnd - snapBeg };
+
+		// e.g. report values
+		std::ostringstream rpt;
+		rpt << delta;
+
+		// [DoxyExample01]
+
+		using instrument::Op;
+		std::uint64_t const expCompose{ instrument::isEnabled() ? 1u : 0u };
+		std::uint64_t const expInverse{ instrument::isEnabled() ? 1u : 0u };
+		std::uint64_t const expElems
+			{ instrument::isEnabled() ? pnts.size() : 0u };
+		if (! (expCompose == delta.count(Op::Compose)))
+		{
+			oss << "Failure of Compose count test\n";
+			oss << "exp: " << expCompose << '\n';
+			oss << "got: " << delta.count(Op::Compose) << '\n';
+		}
+		if (! (expInverse == delta.count(Op::Inverse)))
+		{
+			oss << "Failure of Inverse count test\n";
+			oss << "exp: " << expInverse << '\n';
+			oss << "got: " << delta.count(Op::Inverse) << '\n';
+		}
+		if (! (expElems == delta.count(Op::BatchElement)))
+		{
+			oss << "Failure of BatchElement count test\n";
+			oss << "exp: " << expElems << '\n';
+			oss << "got: " << delta.count(Op::BatchElement) << '\n';
+		}
+
+		// composition evaluates (at least) two spinors and one log
+		bool const okSpin
+			{ instrument::isEnabled()
+				? (  (2u <= delta.count(Op::SpinExp))
+				  && (1u <= delta.count(Op::SpinLog))
+				  )
+				: (  (0u == delta.count(Op::SpinExp))
+				  && (0u == delta.count(Op::SpinLog))
+				  )
+			};
+		if (! okSpin)
+		{
+			oss << "Failure of SpinExp/SpinLog count test\n";
+			oss << delta;
+		}
+
+		if (rpt.str().empty())
+		{
+			oss << "Failure of snapshot report test\n";
+		}
+		if (! isValid(pntsOut.back()))
+		{
+			oss << "Failure of valid batch output test\n";
+		}
+
+		// constexpr functions remain usable in constant expressions
+		constexpr Transform xIdentInv{ inverse(identity<Transform>()) };
+		static_assert(0. == xIdentInv.theLoc[0], "constexpr instrumented");
+	}
+
+	//! Check instrumentation of other batch and interpolation functions
+	void
+	testHooks
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+		using instrument::Op;
+
+		Transform const xfm
+			{ Location{ 1., 2., 3. }
+			, Attitude(PhysAngle{ BiVector{ .1, -.2, .3 } })
+			};
+		constexpr std::size_t numPnts{ 10u };
+		std::vector<double> const xyzIn(numPnts, 1.);
+		std::vector<double> xyzOut(numPnts);
+		std::vector<float> const xyzInF(numPnts, 1.f);
+		std::vector<float> xyzOutF(numPnts);
+		std::vector<Vector> const pnts(numPnts, Vector{ 1., 2., 3. });
+		std::vector<Vector> pntsOut(numPnts);
+		TransformBlock const block(std::vector<Transform>(numPnts, xfm));
+
+		instrument::Snapshot const snapBeg{ instrument::threadSnapshot() };
+		simd::apply
+			( xfm
+			, xyzIn.data(), xyzIn.data(), xyzIn.data(), numPnts
+			, xyzOut.data(), xyzOut.data(), xyzOut.data()
+			);
+		rigibra::apply
+			( xfm
+			, xyzInF.data(), xyzInF.data(), xyzInF.data(), numPnts
+			, xyzOutF.data(), xyzOutF.data(), xyzOutF.data()
+			);
+		rigibra::apply
+			(affineMatrix(xfm), pnts.data(), numPnts, pntsOut.data());
+		TransformBlock const blockInv{ inverse(block) };
+		instrument::Snapshot const snapMid{ instrument::threadSnapshot() };
+
+		Trajectory traj;
+		traj.insert(0., identity<Transform>());
+		traj.insert(1., xfm);
+		instrument::Snapshot const snapTraj{ instrument::threadSnapshot() };
+		Transform const xfmMid{ traj.at(.5) };
+		instrument::Snapshot const snapEnd{ instrument::threadSnapshot() };
+
+		instrument::Snapshot const deltaBatch{ snapMid - snapBeg };
+		std::uint64_t const expElems
+			{ instrument::isEnabled() ? (4u * numPnts) : 0u };
+		if (! (expElems == deltaBatch.count(Op::BatchElement)))
+		{
+			oss << "Failure of batch hook count test\n";
+			oss << "exp: " << expElems << '\n';
+			oss << "got: " << deltaBatch.count(Op::BatchElement) << '\n';
+		}
+
+		std::uint64_t const expSpin{ instrument::isEnabled() ? 1u : 0u };
+		instrument::Snapshot const deltaInsert{ snapTraj - snapMid };
+		instrument::Snapshot const deltaAt{ snapEnd - snapTraj };
+		if ( (! (expSpin <= deltaInsert.count(Op::SpinLog)))
+		  || (! (expSpin <= deltaAt.count(Op::SpinExp)))
+		  || (! isValid(xfmMid))
+		  || (! (numPnts == blockInv.size()))
+		   )
+		{
+			oss << "Failure of trajectory hook count test\n";
+			oss << "SpinLog: " << deltaInsert.count(Op::SpinLog) << '\n';
+			oss << "SpinExp: " << deltaAt.count(Op::SpinExp) << '\n';
+		}
+	}
+
+	//! Check collection of counts from other threads
+	void
+	testThreads
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		using instrument::Op;
+
+		Transform const xfm
+			{ Location{ 1., 2., 3. }
+			, Attitude(PhysAngle{ BiVector{ .1, -.2, .3 } })
+			};
+
+		constexpr std::size_t numThreads{ 3u };
+		constexpr std::size_t numPerThread{ 5u };
+		instrument::Snapshot const snapBeg{ instrument::snapshot() };
+		instrument::Snapshot const thisBeg{ instrument::threadSnapshot() };
+		std::vector<std::thread> threads;
+		for (std::size_t nt{0u} ; nt < numThreads ; ++nt)
+		{
+			threads.emplace_back
+				( [&xfm] ()
+					{
+						Transform sum{ xfm };
+						for (std::size_t nn{0u} ; nn < numPerThread ; ++nn)
+						{
+							sum = sum * xfm;
+						}
+					}
+				);
+		}
+		for (std::thread & thread : threads)
+		{
+			thread.join();
+		}
+		instrument::Snapshot const delta
+			{ instrument::snapshot() - snapBeg };
+		instrument::Snapshot const thisDelta
+			{ instrument::threadSnapshot() - thisBeg };
+
+		std::uint64_t const expCompose
+			{ instrument::isEnabled() ? (numThreads * numPerThread) : 0u };
+		if (! (expCompose == delta.count(Op::Compose)))
+		{
+			oss << "Failure of multi-thread Compose count test\n";
+			oss << "exp: " << expCompose << '\n';
+			oss << "got: " << delta.count(Op::Compose) << '\n';
+		}
+		if (! (0u == thisDelta.count(Op::Compose)))
+		{
+			oss << "Failure of calling thread Compose count test\n";
+			oss << "got: " << thisDelta.count(Op::Compose) << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of operation instrumentation
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testHooks(oss);
+	testThreads(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
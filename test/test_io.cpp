@@ -0,0 +1,222 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::binio
+*/
+
+
+#include "io.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testRoundTrip
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using rigibra::Transform;
+		using rigibra::Location;
+		using rigibra::Attitude;
+		using rigibra::PhysAngle;
+
+		std::vector<Transform> xfms;
+		for (std::size_t nn{0u} ; nn < 1000u ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			xfms.emplace_back
+				( Transform
+					{ Location{ dn, -2.*dn, .5 }
+					, Attitude(PhysAngle{ .001*dn*e12 + .5*e23 })
+					}
+				);
+		}
+		std::string const path{ "test_io_xfms.bin" };
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// store transforms in binary file
+		bool const okayWrite{ binio::writeBinary(path, xfms.data(), xfms.size()) };
+
+		// map file into memory and access records in place
+		binio::MappedFile const mapped(path);
+		binio::TransformRecord const * const recs{ mapped.transformRecords() };
+		std::size_t const numRecs{ mapped.size() };
+
+		// convert (individual) records to Transforms
+		Transform const xfm5{ binio::transformFrom(recs[5u]) };
+
+		// [DoxyExample01]
+
+		if (! ( okayWrite
+			 && mapped.isValid()
+			 && mapped.hasValidChecksum()
+			 && (xfms.size() == numRecs)
+			  ))
+		{
+			oss << "Failure of write/map test\n";
+			return;
+		}
+
+		std::size_t errCount{ 0u };
+		for (std::size_t nn{0u} ; nn < numRecs ; ++nn)
+		{
+			Transform const got{ binio::transformFrom(recs[nn]) };
+			if (! nearlyEquals(got, xfms[nn]))
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of record round trip test\n";
+					oss << "exp: " << xfms[nn] << '\n';
+					oss << "got: " << got << '\n';
+				}
+			}
+		}
+		if (! nearlyEquals(xfm5, xfms[5u]))
+		{
+			oss << "Failure of example record test\n";
+		}
+
+		// wrong kind of record is not available
+		if (mapped.attitudeRecords())
+		{
+			oss << "Failure of record kind test\n";
+		}
+
+		std::remove(path.c_str());
+	}
+
+	//! Check Attitude files and rejection of inconsistent files
+	void
+	testInvalid
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+
+		std::vector<Attitude> atts
+			{ Attitude(PhysAngle{ .1*e12 })
+			, Attitude(PhysAngle{ .2*e23 })
+			, Attitude(PhysAngle{ .3*e31 })
+			};
+		std::string const path{ "test_io_atts.bin" };
+		binio::writeBinary(path, atts.data(), atts.size());
+		{
+			binio::MappedFile const mapped(path);
+			if ( (! mapped.isValid())
+			  || (! (3u == mapped.size()))
+			  || mapped.transformRecords()
+			  || (! nearlyEquals
+					(binio::attitudeFrom(mapped.attitudeRecords()[2]), atts[2]))
+			   )
+			{
+				oss << "Failure of attitude file test\n";
+			}
+		}
+
+		// modify a record value
+		{
+			std::fstream fs(path, std::ios::binary | std::ios::in | std::ios::out);
+			fs.seekp(sizeof(binio::FileHeader) + 3u);
+			fs.put('\x55');
+		}
+		binio::MappedFile const corrupt(path, true);
+		binio::MappedFile const unverified(path);
+		if ( corrupt.isValid()
+		  || (! unverified.isValid())
+		  || unverified.hasValidChecksum()
+		   )
+		{
+			oss << "Failure of checksum test\n";
+		}
+
+		// truncated file
+		{
+			std::ofstream ofs(path, std::ios::binary | std::ios::app);
+			ofs.put('\0');
+		}
+		binio::MappedFile const badSize(path, false);
+		if (badSize.isValid() || (0u != badSize.size()))
+		{
+			oss << "Failure of file size test\n";
+		}
+
+		binio::MappedFile const missing("test_io_missing_file.bin");
+		if (missing.isValid() || missing.header())
+		{
+			oss << "Failure of missing file test\n";
+		}
+
+		// empty arrays are valid
+		binio::writeBinary(path, atts.data(), 0u);
+		binio::MappedFile const empty(path);
+		if ((! empty.isValid()) || (0u != empty.size()))
+		{
+			oss << "Failure of empty file test\n";
+		}
+
+		std::remove(path.c_str());
+	}
+
+}
+
+//! Check behavior of binary file I/O
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testRoundTrip(oss);
+	testInvalid(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
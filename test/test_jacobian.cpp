@@ -0,0 +1,391 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra analytic Jacobians
+*/
+
+
+#include "jacobian.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Stored parameters: (loc, spinAngle)
+	using Params = std::array<double, 6u>;
+
+	//! Parameters of transform
+	Params
+	paramsOf
+		( rigibra::Transform const & xfm
+		)
+	{
+		engabra::g3::BiVector const & biv = xfm.theAtt.spinAngle().theBiv;
+		return Params
+			{ xfm.theLoc[0], xfm.theLoc[1], xfm.theLoc[2]
+			, biv[0], biv[1], biv[2]
+			};
+	}
+
+	//! Transform with parameters
+	rigibra::Transform
+	transformFrom
+		( Params const & prms
+		)
+	{
+		using namespace rigibra;
+		return Transform
+			{ Location{ prms[0], prms[1], prms[2] }
+			, Attitude(SpinAngle{ engabra::g3::BiVector
+				{ prms[3], prms[4], prms[5] } })
+			};
+	}
+
+	//! Parameters with component ndx changed by delta
+	Params
+	perturbed
+		( Params const & prms
+		, std::size_t const & ndx
+		, double const & delta
+		)
+	{
+		Params pert{ prms };
+		pert[ndx] += delta;
+		return pert;
+	}
+
+	//! Largest absolute difference
+	template <typename Array>
+	double
+	maxDiff
+		( Array const & arrA
+		, Array const & arrB
+		)
+	{
+		double diff{ 0. };
+		for (std::size_t kk{0u} ; kk < arrA.size() ; ++kk)
+		{
+			diff = std::max(diff, std::abs(arrA[kk] - arrB[kk]));
+		}
+		return diff;
+	}
+
+	//! Transforms with a variety of attitude magnitudes
+	std::vector<rigibra::Transform>
+	sampleTransforms
+		()
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		return std::vector<Transform>
+			{ Transform
+				{ Location{ 1., -2., 3. }
+				, Attitude(PhysAngle{ .3, -1.2, 2.1 })
+				}
+			// small angles (series evaluation)
+			, Transform
+				{ Location{ -.5, .2, 7. }
+				, Attitude(PhysAngle{ .01, .02, -.015 })
+				}
+			, Transform
+				{ Location{ 4., 5., -6. }
+				, Attitude(PhysAngle{ 1.e-9, 0., 2.e-9 })
+				}
+			, Transform
+				{ Location{ .1, -.1, .2 }
+				, Attitude(PhysAngle{ -2.5, .4, .7 })
+				}
+			, Transform{ Location{ 0., 3., 1. }, identity<Attitude>() }
+			};
+	}
+
+	//! Step for central differences
+	constexpr double sStep{ 1.e-6 };
+
+	//! Tolerance for analytic vs central difference comparisons
+	constexpr double sTol{ 1.e-7 };
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+		Transform const xfm
+			{ Location{ 1., -2., 3. }, Attitude(PhysAngle{ .3, -1.2, 2.1 }) };
+		std::vector<Vector> const pnts
+			{ Vector{ 1., 2., 3. }, Vector{ -4., 5., .5 } };
+
+		// d(xfm(pnt)) / d(loc, spinAngle) : row-major 3x6 per point
+		std::vector<double> jacs(18u * pnts.size());
+		std::vector<Vector> ys(pnts.size()); // optional: xfm(pnts)
+		jacobianApply(xfm, pnts.data(), pnts.size(), jacs.data(), ys.data());
+
+		// Jacobians (w.r.t. all inputs) of composition and of inverse
+		Transform const xAwX
+			{ Location{ .5, .4, .3 }, Attitude(PhysAngle{ 1., .5, -.2 }) };
+		Jacobian6x12 const jacComp{ jacobianCompose(xfm, xAwX) };
+		Jacobian6x6 const jacInv{ jacobianInverse(xfm) };
+
+		// [DoxyExample01]
+
+		// apply: compare with central differences
+		Params const prms{ paramsOf(xfm) };
+		for (std::size_t nn{0u} ; nn < pnts.size() ; ++nn)
+		{
+			Jacobian3x6 expJac{};
+			for (std::size_t col{0u} ; col < 6u ; ++col)
+			{
+				Vector const yPos
+					{ transformFrom(perturbed(prms, col, sStep))(pnts[nn]) };
+				Vector const yNeg
+					{ transformFrom(perturbed(prms, col, -sStep))(pnts[nn]) };
+				for (std::size_t row{0u} ; row < 3u ; ++row)
+				{
+					expJac[6u*row + col] = (yPos[row] - yNeg[row]) / (2.*sStep);
+				}
+			}
+			Jacobian3x6 gotJac{};
+			std::copy
+				( jacs.cbegin() + 18u*nn, jacs.cbegin() + 18u*(nn + 1u)
+				, gotJac.begin()
+				);
+			if (! ( (maxDiff(expJac, gotJac) < sTol)
+				 && nearlyEquals(ys[nn], xfm(pnts[nn]), 1.e-14)
+				 && (maxDiff(jacobianApply(xfm, pnts[nn]), gotJac) == 0.)
+				  ))
+			{
+				oss << "Failure of jacobianApply example test\n";
+				oss << "maxDiff: " << maxDiff(expJac, gotJac) << '\n';
+			}
+		}
+
+		if (! ( std::all_of(jacComp.cbegin(), jacComp.cend()
+					, [] (double const & val) { return std::isfinite(val); })
+			 && std::all_of(jacInv.cbegin(), jacInv.cend()
+					, [] (double const & val) { return std::isfinite(val); })
+			  ))
+		{
+			oss << "Failure of compose/inverse example test\n";
+		}
+	}
+
+	//! Check left Jacobian (and inverse) against defining relationships
+	void
+	testLeftJacobian
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		for (Transform const & xfm : sampleTransforms())
+		{
+			SpinAngle const & spinAngle = xfm.theAtt.spinAngle();
+			linalg::Matrix3 const jl{ leftJacobian(spinAngle) };
+			linalg::Matrix3 const jlInv{ leftJacobianInverse(spinAngle) };
+			linalg::Matrix3 const prod{ linalg::product(jl, jlInv) };
+			linalg::Matrix3 const ident{ 1., 0., 0.,  0., 1., 0.,  0., 0., 1. };
+			if (! (maxDiff(prod, ident) < 1.e-14))
+			{
+				oss << "Failure of leftJacobianInverse test\n";
+				oss << "xfm: " << xfm << '\n';
+			}
+
+			// left perturbation: R(spin + ds) ~= exp(skew(Jl*dw)) * R(spin)
+			// with dw = -2*ds; check (R(spin+ds) * R^T - I) ~= skew(Jl*dw)
+			linalg::Matrix3 const rot{ FastAttitude(xfm.theAtt).matrix() };
+			for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+			{
+				BiVector biv{ spinAngle.theBiv };
+				biv[kk] += sStep;
+				linalg::Matrix3 const rotPos
+					{ FastAttitude(Attitude(SpinAngle{ biv })).matrix() };
+				biv[kk] -= 2.*sStep;
+				linalg::Matrix3 const rotNeg
+					{ FastAttitude(Attitude(SpinAngle{ biv })).matrix() };
+				linalg::Matrix3 dRot{};
+				for (std::size_t nn{0u} ; nn < 9u ; ++nn)
+				{
+					dRot[nn] = (rotPos[nn] - rotNeg[nn]) / (2.*sStep);
+				}
+				linalg::Matrix3 const gotSkew
+					{ linalg::product(dRot, linalg::transpose(rot)) };
+				linalg::Vector3 const dw
+					{ -2.*jl[kk], -2.*jl[3u + kk], -2.*jl[6u + kk] };
+				linalg::Matrix3 const expSkew{ linalg::skew(dw) };
+				if (! (maxDiff(gotSkew, expSkew) < sTol))
+				{
+					oss << "Failure of leftJacobian perturbation test\n";
+					oss << "xfm: " << xfm << '\n';
+					oss << "maxDiff: " << maxDiff(gotSkew, expSkew) << '\n';
+					break;
+				}
+			}
+		}
+	}
+
+	//! Check composition and inverse Jacobians with central differences
+	void
+	testComposeInverse
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		std::vector<Transform> const xfms{ sampleTransforms() };
+		std::size_t const numXfms{ xfms.size() };
+		std::vector<Transform> xBwAs;
+		std::vector<Transform> xAwXs;
+		for (std::size_t nB{0u} ; nB < numXfms ; ++nB)
+		{
+			for (std::size_t nA{0u} ; nA < numXfms ; ++nA)
+			{
+				xBwAs.emplace_back(xfms[nB]);
+				xAwXs.emplace_back(xfms[nA]);
+			}
+		}
+
+		// composition (batch)
+		std::vector<double> jacs(72u * xBwAs.size());
+		jacobianCompose(xBwAs.data(), xAwXs.data(), xBwAs.size(), jacs.data());
+		for (std::size_t nn{0u} ; nn < xBwAs.size() ; ++nn)
+		{
+			Params const prmsB{ paramsOf(xBwAs[nn]) };
+			Params const prmsA{ paramsOf(xAwXs[nn]) };
+			Jacobian6x12 expJac{};
+			for (std::size_t col{0u} ; col < 12u ; ++col)
+			{
+				std::size_t const ndx{ col % 6u };
+				Params prmsPos{};
+				Params prmsNeg{};
+				if (col < 6u)
+				{
+					prmsPos = paramsOf(transformFrom
+						(perturbed(prmsB, ndx, sStep)) * xAwXs[nn]);
+					prmsNeg = paramsOf(transformFrom
+						(perturbed(prmsB, ndx, -sStep)) * xAwXs[nn]);
+				}
+				else
+				{
+					prmsPos = paramsOf(xBwAs[nn] * transformFrom
+						(perturbed(prmsA, ndx, sStep)));
+					prmsNeg = paramsOf(xBwAs[nn] * transformFrom
+						(perturbed(prmsA, ndx, -sStep)));
+				}
+				for (std::size_t row{0u} ; row < 6u ; ++row)
+				{
+					expJac[12u*row + col]
+						= (prmsPos[row] - prmsNeg[row]) / (2.*sStep);
+				}
+			}
+			Jacobian6x12 gotJac{};
+			std::copy
+				( jacs.cbegin() + 72u*nn, jacs.cbegin() + 72u*(nn + 1u)
+				, gotJac.begin()
+				);
+			if (! (maxDiff(expJac, gotJac) < sTol))
+			{
+				oss << "Failure of jacobianCompose test\n";
+				oss << "xBwA: " << xBwAs[nn] << '\n';
+				oss << "xAwX: " << xAwXs[nn] << '\n';
+				oss << "maxDiff: " << maxDiff(expJac, gotJac) << '\n';
+				break;
+			}
+		}
+
+		// inverse (batch)
+		std::vector<double> invJacs(36u * numXfms);
+		jacobianInverse(xfms.data(), numXfms, invJacs.data());
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			Params const prms{ paramsOf(xfms[nn]) };
+			Jacobian6x6 expJac{};
+			for (std::size_t col{0u} ; col < 6u ; ++col)
+			{
+				Transform const xfmPos
+					{ transformFrom(perturbed(prms, col, sStep)) };
+				Transform const xfmNeg
+					{ transformFrom(perturbed(prms, col, -sStep)) };
+				Params const prmsPos{ paramsOf(inverse(xfmPos)) };
+				Params const prmsNeg{ paramsOf(inverse(xfmNeg)) };
+				for (std::size_t row{0u} ; row < 6u ; ++row)
+				{
+					expJac[6u*row + col]
+						= (prmsPos[row] - prmsNeg[row]) / (2.*sStep);
+				}
+			}
+			Jacobian6x6 gotJac{};
+			std::copy
+				( invJacs.cbegin() + 36u*nn, invJacs.cbegin() + 36u*(nn + 1u)
+				, gotJac.begin()
+				);
+			if (! (maxDiff(expJac, gotJac) < sTol))
+			{
+				oss << "Failure of jacobianInverse test\n";
+				oss << "xfm: " << xfms[nn] << '\n';
+				oss << "maxDiff: " << maxDiff(expJac, gotJac) << '\n';
+				break;
+			}
+		}
+	}
+
+}
+
+//! Check behavior of analytic Jacobian functions
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testLeftJacobian(oss);
+	testComposeInverse(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -0,0 +1,256 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::linalg
+*/
+
+
+#include "linalg.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+
+namespace
+{
+	//! Product of matrix with vector
+	inline
+	rigibra::linalg::Vector4
+	product
+		( rigibra::linalg::Matrix4 const & mat
+		, rigibra::linalg::Vector4 const & vec
+		)
+	{
+		rigibra::linalg::Vector4 result{};
+		for (std::size_t row{0u} ; row < 4u ; ++row)
+		{
+			for (std::size_t col{0u} ; col < 4u ; ++col)
+			{
+				result[row] += mat[4u*row + col] * vec[col];
+			}
+		}
+		return result;
+	}
+
+	//! Check eigen pairs (A*v = lambda*v, unit orthogonal vectors, order)
+	inline
+	bool
+	isEigenSystem
+		( rigibra::linalg::Matrix4 const & mat
+		, rigibra::linalg::EigenSystem4 const & eig
+		, double const & tol
+		)
+	{
+		bool okay{ true };
+		for (std::size_t kk{0u} ; kk < 4u ; ++kk)
+		{
+			rigibra::linalg::Vector4 const av{ product(mat, eig.theVectors[kk]) };
+			for (std::size_t row{0u} ; row < 4u ; ++row)
+			{
+				double const lv{ eig.theValues[kk] * eig.theVectors[kk][row] };
+				okay &= (std::abs(av[row] - lv) < tol);
+			}
+			for (std::size_t jj{0u} ; jj < 4u ; ++jj)
+			{
+				double dot{ 0. };
+				for (std::size_t row{0u} ; row < 4u ; ++row)
+				{
+					dot += eig.theVectors[kk][row] * eig.theVectors[jj][row];
+				}
+				double const expDot{ (kk == jj) ? 1. : 0. };
+				okay &= (std::abs(dot - expDot) < tol);
+			}
+			if (0u < kk)
+			{
+				okay &= (eig.theValues[kk] <= eig.theValues[kk-1u]);
+			}
+		}
+		return okay;
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// symmetric matrix (only upper triangle is used)
+		linalg::Matrix4 const mat
+			{ 4.,  1., -2.,  .5
+			, 1.,  3.,  0., -1.
+			, -2., 0.,  5.,  2.
+			, .5, -1.,  2.,  1.
+			};
+		linalg::EigenSystem4 const eig{ linalg::eigenSymmetric(mat) };
+
+		// largest eigen value and its (unit) eigen vector
+		double const & valMax = eig.theValues[0];
+		linalg::Vector4 const & vecMax = eig.theVectors[0];
+
+		// [DoxyExample01]
+
+		double const tol{ 1.e-12 };
+		if (! isEigenSystem(mat, eig, tol))
+		{
+			oss << "Failure of general eigenSymmetric test\n";
+			oss << "valMax: " << valMax << " vecMax[0]: " << vecMax[0] << '\n';
+		}
+	}
+
+	//! Check special cases (diagonal, repeated values, zero)
+	void
+	testSpecial
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		double const tol{ 1.e-12 };
+
+		// already diagonal (no sweeps needed), unsorted values
+		linalg::Matrix4 const diag
+			{ 1., 0., 0., 0.
+			, 0., 7., 0., 0.
+			, 0., 0., -2., 0.
+			, 0., 0., 0., 3.
+			};
+		linalg::EigenSystem4 const eigDiag{ linalg::eigenSymmetric(diag) };
+		if (! ( isEigenSystem(diag, eigDiag, tol)
+			 && (7. == eigDiag.theValues[0])
+			 && (-2. == eigDiag.theValues[3])
+			 && (0u == eigDiag.theNumSweeps)
+			  ))
+		{
+			oss << "Failure of diagonal eigenSymmetric test\n";
+		}
+
+		// rank one (q*q^T) with repeated (zero) eigen values
+		linalg::Vector4 const qq{ .5, -.5, .5, .5 };
+		linalg::Matrix4 rankOne{};
+		for (std::size_t row{0u} ; row < 4u ; ++row)
+		{
+			for (std::size_t col{0u} ; col < 4u ; ++col)
+			{
+				rankOne[4u*row + col] = qq[row] * qq[col];
+			}
+		}
+		linalg::EigenSystem4 const eigOne{ linalg::eigenSymmetric(rankOne) };
+		double const dot
+			{ qq[0]*eigOne.theVectors[0][0] + qq[1]*eigOne.theVectors[0][1]
+			+ qq[2]*eigOne.theVectors[0][2] + qq[3]*eigOne.theVectors[0][3]
+			};
+		if (! ( isEigenSystem(rankOne, eigOne, tol)
+			 && (std::abs(eigOne.theValues[0] - 1.) < tol)
+			 && (std::abs(std::abs(dot) - 1.) < tol)
+			  ))
+		{
+			oss << "Failure of rank one eigenSymmetric test\n";
+		}
+
+		// zero matrix
+		linalg::EigenSystem4 const eigZero
+			{ linalg::eigenSymmetric(linalg::Matrix4{}) };
+		if (! isEigenSystem(linalg::Matrix4{}, eigZero, tol))
+		{
+			oss << "Failure of zero matrix eigenSymmetric test\n";
+		}
+	}
+
+	//! Check 3x3 matrix utilities
+	void
+	testMatrix3
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		linalg::Vector3 const aa{ .5, -2., 1.5 };
+		linalg::Vector3 const bb{ 3., .25, -1. };
+		linalg::Vector3 const expCross
+			{ aa[1]*bb[2] - aa[2]*bb[1]
+			, aa[2]*bb[0] - aa[0]*bb[2]
+			, aa[0]*bb[1] - aa[1]*bb[0]
+			};
+		linalg::Vector3 const gotCross
+			{ linalg::product(linalg::skew(aa), bb) };
+
+		// skew^T = -skew and (skew(aa)*skew(bb))^T = skew(bb)*skew(aa)
+		linalg::Matrix3 const skewA{ linalg::skew(aa) };
+		linalg::Matrix3 const skewB{ linalg::skew(bb) };
+		linalg::Matrix3 const prodAB
+			{ linalg::transpose(linalg::product(skewA, skewB)) };
+		linalg::Matrix3 const prodBA{ linalg::product(skewB, skewA) };
+		linalg::Matrix3 const skewAT{ linalg::transpose(skewA) };
+
+		double const tol{ 4. * std::numeric_limits<double>::epsilon() };
+		bool okay{ true };
+		for (std::size_t kk{0u} ; kk < 3u ; ++kk)
+		{
+			okay &= (std::abs(gotCross[kk] - expCross[kk]) < tol);
+		}
+		for (std::size_t kk{0u} ; kk < 9u ; ++kk)
+		{
+			okay &= (std::abs(prodAB[kk] - prodBA[kk]) < tol);
+			okay &= (std::abs(skewAT[kk] + skewA[kk]) < tol);
+		}
+		if (! okay)
+		{
+			oss << "Failure of Matrix3 utilities test\n";
+		}
+	}
+
+}
+
+//! Check behavior of linalg functions
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testSpecial(oss);
+	testMatrix3(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -0,0 +1,275 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra matrix conversions
+*/
+
+
+#include "matrix.hpp"
+#include "func.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// A general transformation
+		Location const loc{ 2., -5., 3. };
+		Attitude const att(PhysAngle{ BiVector{ .7, -1.1, .3 } });
+		Transform const xfm{ loc, att };
+
+		// Export as matrices (e.g. for graphics or other libraries)
+		Matrix3x3 const rot{ rotationMatrix(att) };
+		Matrix4x4 const homCM{ homogeneousMatrix(xfm, MatrixOrder::ColMajor) };
+
+		// y = R*x + off is same as xfm(x)
+		Matrix3x4 const aff{ affineMatrix(xfm) };
+		Vector const pnt{ 1., 2., 3. };
+		std::vector<Vector> pntsOut(1u);
+		apply(aff, &pnt, 1u, pntsOut.data());
+
+		// Import back from (row- or column-major) matrices
+		Attitude const gotAtt{ attitudeFromRotation(rot) };
+		Transform const gotXfm
+			{ transformFromHomogeneous(homCM, MatrixOrder::ColMajor) };
+
+		// [DoxyExample01]
+
+		double const tol{ 64. * std::numeric_limits<double>::epsilon() };
+		if (! nearlyEquals(pntsOut[0], xfm(pnt), tol))
+		{
+			oss << "Failure of affine matrix apply test\n";
+			oss << "exp: " << xfm(pnt) << '\n';
+			oss << "got: " << pntsOut[0] << '\n';
+		}
+		if (! nearlyEquals(gotAtt, att, tol))
+		{
+			oss << "Failure of attitudeFromRotation test\n";
+			oss << "exp: " << att << '\n';
+			oss << "got: " << gotAtt << '\n';
+		}
+		if (! nearlyEquals(gotXfm, xfm, tol))
+		{
+			oss << "Failure of transformFromHomogeneous test\n";
+			oss << "exp: " << xfm << '\n';
+			oss << "got: " << gotXfm << '\n';
+		}
+		if (! ((0. == homCM[3]) && (0. == homCM[7]) && (0. == homCM[11])
+			&& (1. == homCM[15])))
+		{
+			oss << "Failure of homogeneous column-major last row test\n";
+		}
+	}
+
+	//! Check layouts and round trips over many angles (incl. half turns)
+	void
+	testRoundTrip
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		Location const loc{ -.5, 7., 1.25 };
+		Vector const pnt{ .3, -.7, 1.9 };
+		double const tol{ 256. * std::numeric_limits<double>::epsilon() };
+		std::size_t errCount{ 0u };
+		std::vector<double> mags;
+		for (double mag{ 0. } ; mag < turnFull ; mag += .375)
+		{
+			mags.emplace_back(mag);
+		}
+		// angles at (and very near) a half turn have trace near -1
+		mags.emplace_back(turnHalf);
+		mags.emplace_back(turnHalf - 1.e-9);
+		for (double const & mag : mags)
+		{
+			for (BiVector const & dir
+				: { e12, e23, e31, direction(e12-e23+e31), direction(e23+e31) })
+			{
+				Transform const xfm{ loc, Attitude(PhysAngle{ mag * dir }) };
+				Vector const expPnt{ xfm(pnt) };
+
+				Matrix3x3 const rotRM{ rotationMatrix(xfm.theAtt) };
+				Matrix3x3 const rotCM
+					{ rotationMatrix(xfm.theAtt, MatrixOrder::ColMajor) };
+				Matrix3x4 const affRM{ affineMatrix(xfm) };
+				Matrix3x4 const affCM
+					{ affineMatrix(xfm, MatrixOrder::ColMajor) };
+				Matrix4x4 const homRM{ homogeneousMatrix(xfm) };
+
+				// column-major is transpose of row-major
+				bool okLayout{ true };
+				for (std::size_t row{0u} ; row < 3u ; ++row)
+				{
+					for (std::size_t col{0u} ; col < 3u ; ++col)
+					{
+						okLayout &= (rotRM[3u*row + col] == rotCM[3u*col + row]);
+						okLayout &= (rotRM[3u*row + col] == affRM[4u*row + col]);
+					}
+					okLayout &= (affRM[4u*row + 3u] == affCM[9u + row]);
+					okLayout &= (affRM[4u*row + 3u] == homRM[4u*row + 3u]);
+				}
+
+				// rotations agree when compared via the (sign ambiguous)
+				// effect on vectors
+				Attitude const gotAttRM{ attitudeFromRotation(rotRM) };
+				Attitude const gotAttCM
+					{ attitudeFromRotation(rotCM, MatrixOrder::ColMajor) };
+				Transform const gotXfmRM{ transformFromAffine(affRM) };
+				Transform const gotXfmCM
+					{ transformFromAffine(affCM, MatrixOrder::ColMajor) };
+				Transform const gotXfmH{ transformFromHomogeneous(homRM) };
+
+				Vector const rotPnt{ xfm.theAtt(pnt) };
+				bool const okRound
+					{  nearlyEquals(gotAttRM(pnt), rotPnt, tol)
+					&& nearlyEquals(gotAttCM(pnt), rotPnt, tol)
+					&& nearlyEquals(gotXfmRM(pnt), expPnt, tol)
+					&& nearlyEquals(gotXfmCM(pnt), expPnt, tol)
+					&& nearlyEquals(gotXfmH(pnt), expPnt, tol)
+					&& nearlyEquals(gotXfmRM.theLoc, loc, tol)
+					};
+
+				// extracted spinor is unit magnitude with non-negative scalar
+				Spinor const spin{ spinorFromRotation(rotRM) };
+				bool const okSpin
+					{  nearlyEquals(magnitude(spin), 1., tol)
+					&& (! (spin.theSca[0] < 0.))
+					};
+
+				if (! (okLayout && okRound && okSpin))
+				{
+					if (0u == errCount++)
+					{
+						oss << "Failure of matrix round trip test\n";
+						oss << "mag: " << mag << " dir: " << dir << '\n';
+						oss << "okLayout: " << okLayout << '\n';
+						oss << "okRound: " << okRound << '\n';
+						oss << "okSpin: " << okSpin << '\n';
+					}
+				}
+			}
+		}
+	}
+
+	//! Check robustness for approximate and invalid matrices
+	void
+	testRobust
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		Attitude const att(PhysAngle{ BiVector{ -.4, 2.2, .9 } });
+		Matrix3x3 rot{ rotationMatrix(att) };
+
+		// small perturbation (e.g. from text file with few digits)
+		for (double & elem : rot)
+		{
+			elem = 1.e-6 * std::round(1.e6 * elem);
+		}
+		Spinor const spin{ spinorFromRotation(rot) };
+		Attitude const gotAtt{ attitudeFromRotation(rot) };
+		Vector const vec{ 1., -2., .5 };
+		if (! nearlyEquals(magnitude(spin), 1.))
+		{
+			oss << "Failure of approximate rotation spinor magnitude test\n";
+			oss << "mag: " << magnitude(spin) << '\n';
+		}
+		if (! nearlyEquals(gotAtt(vec), att(vec), 1.e-5))
+		{
+			oss << "Failure of approximate rotation attitude test\n";
+			oss << "exp: " << att(vec) << '\n';
+			oss << "got: " << gotAtt(vec) << '\n';
+		}
+
+		// reflections are not rotations
+		Matrix3x3 const refl{ -1., 0., 0.,  0., 1., 0.,  0., 0., 1. };
+		if (isValid(attitudeFromRotation(refl)))
+		{
+			oss << "Failure of reflection null test\n";
+		}
+
+		// null input and null output
+		Matrix3x3 rotNull{ rotationMatrix(att) };
+		rotNull[4] = std::numeric_limits<double>::quiet_NaN();
+		if (isValid(attitudeFromRotation(rotNull)))
+		{
+			oss << "Failure of nan rotation null test\n";
+		}
+		Matrix3x4 const affNull{ affineMatrix(rigibra::null<Transform>()) };
+		if (isValid(transformFromAffine(affNull)))
+		{
+			oss << "Failure of null transform round trip test\n";
+		}
+	}
+
+}
+
+//! Check behavior of matrix conversions
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testRoundTrip(oss);
+	testRobust(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -0,0 +1,301 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra mean attitude functions
+*/
+
+
+#include "mean.hpp"
+#include "func.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Attitudes symmetrically distributed about attMean
+	inline
+	std::vector<rigibra::Attitude>
+	symmetricAbout
+		( rigibra::Attitude const & attMean
+		, double const & spread
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		std::vector<Attitude> atts;
+		for (BiVector const & dir
+			: { e23, e31, e12, direction(e23 + e31 - e12) })
+		{
+			for (double const & sgn : { -1., 1. })
+			{
+				// perturbation (in body frame) applied after attMean
+				Attitude const attDel(PhysAngle{ (sgn * spread) * dir });
+				atts.emplace_back(attDel * attMean);
+			}
+		}
+		return atts;
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		rigibra::Attitude const attExp
+			(rigibra::PhysAngle{ BiVector{ .7, -1.1, .4 } });
+		std::vector<rigibra::Attitude> const atts
+			{ symmetricAbout(attExp, .2) };
+		std::size_t const half{ atts.size() / 2u };
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// one step average (chordal mean) of many attitudes
+		Attitude const attMean{ chordalMean(atts.data(), atts.size()) };
+
+		// streaming use (e.g. with partial results from separate sources)
+		MeanAccumulator accumA;
+		MeanAccumulator accumB;
+		for (std::size_t nn{0u} ; nn < half ; ++nn)
+		{
+			accumA.add(atts[nn]);
+		}
+		for (std::size_t nn{half} ; nn < atts.size() ; ++nn)
+		{
+			accumB.add(atts[nn], 1.); // with (optional) weight
+		}
+		accumA.merge(accumB);
+		Attitude const attStream{ accumA.attitude() };
+
+		// geodesic mean (iterative refinement from chordal mean)
+		Attitude const attKarcher{ karcherMean(atts.data(), atts.size()) };
+
+		// [DoxyExample01]
+
+		double const tol{ 1.e-12 };
+		if (! nearlyEquals(attMean, attExp, tol))
+		{
+			oss << "Failure of chordalMean symmetric test\n";
+			oss << "exp: " << attExp << '\n';
+			oss << "got: " << attMean << '\n';
+		}
+		if (! nearlyEquals(attStream, attMean, tol))
+		{
+			oss << "Failure of streaming merge test\n";
+			oss << "exp: " << attMean << '\n';
+			oss << "got: " << attStream << '\n';
+		}
+		if (! nearlyEquals(attKarcher, attExp, tol))
+		{
+			oss << "Failure of karcherMean symmetric test\n";
+			oss << "exp: " << attExp << '\n';
+			oss << "got: " << attKarcher << '\n';
+		}
+	}
+
+	//! Check behavior near a half turn (where bivector averaging fails)
+	void
+	testHalfTurn
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		// rotations just short of a half turn in each direction: the
+		// SpinAngles are nearly opposite, but the attitudes are close
+		double const del{ .05 };
+		std::vector<Attitude> const atts
+			{ Attitude(PhysAngle{ (turnHalf - del) * e12 })
+			, Attitude(PhysAngle{ -(turnHalf - del) * e12 })
+			};
+		// expected mean is (exactly) a half turn
+		Vector const vec{ 1., .5, 2. };
+		Vector const expVec{ -1., -.5, 2. };
+
+		Attitude const gotChordal{ chordalMean(atts.data(), atts.size()) };
+		Attitude const gotKarcher{ karcherMean(atts.data(), atts.size()) };
+		double const tol{ 1.e-12 };
+		if (! nearlyEquals(gotChordal(vec), expVec, tol))
+		{
+			oss << "Failure of chordalMean half turn test\n";
+			oss << "exp: " << expVec << '\n';
+			oss << "got: " << gotChordal(vec) << '\n';
+		}
+		if (! nearlyEquals(gotKarcher(vec), expVec, tol))
+		{
+			oss << "Failure of karcherMean half turn test\n";
+			oss << "exp: " << expVec << '\n';
+			oss << "got: " << gotKarcher(vec) << '\n';
+		}
+	}
+
+	//! Check weights, transforms, nulls and parallel evaluation
+	void
+	testWeighted
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		// many samples (multiple parallel chunks) with varied weights
+		std::size_t const numXfms{ 3u * sMeanChunkSize + 7u };
+		std::vector<Transform> xfms;
+		std::vector<double> weights;
+		xfms.reserve(numXfms);
+		weights.reserve(numXfms);
+		Attitude const attBase(PhysAngle{ BiVector{ -2., .3, .9 } });
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			BiVector const del
+				{ .3*std::sin(.7*dn), .2*std::cos(1.3*dn), .1*std::sin(2.9*dn) };
+			xfms.emplace_back(Transform
+				{ Location{ dn, -.5*dn, 1. }
+				, Attitude(PhysAngle{ del }) * attBase
+				});
+			weights.emplace_back(1. + .5*std::sin(dn));
+		}
+		// zero weight items are ignored (even if null)
+		xfms[3u] = rigibra::null<Transform>();
+		weights[3u] = 0.;
+
+		Transform const serial
+			{ chordalMean(xfms.data(), xfms.size(), weights.data()) };
+		ThreadPool pool(3u);
+		Transform const parallel
+			{ chordalMean(pool, xfms.data(), xfms.size(), weights.data()) };
+		Transform const karSerial
+			{ karcherMean(xfms.data(), xfms.size(), weights.data()) };
+		Transform const karParallel
+			{ karcherMean(xfms.data(), xfms.size(), weights.data(), &pool) };
+
+		// expected location from direct evaluation
+		Vector locSum{ 0., 0., 0. };
+		double wSum{ 0. };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			if (0. < weights[nn])
+			{
+				locSum = locSum + weights[nn] * xfms[nn].theLoc;
+				wSum += weights[nn];
+			}
+		}
+		Vector const expLoc{ (1./wSum) * locSum };
+
+		// Karcher mean property: weighted mean residual angle is zero
+		Spinor const spinMean{ karSerial.theAtt.spinor() };
+		BiVector resSum{ 0., 0., 0. };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			if (0. < weights[nn])
+			{
+				Spinor const rel
+					{ xfms[nn].theAtt.spinor() * reverse(spinMean) };
+				resSum = resSum + weights[nn] * spinLog(rel);
+			}
+		}
+		double const resMag{ magnitude((1./wSum) * resSum) };
+
+		double const tol{ 1.e-9 };
+		if (! ( isValid(serial)
+			 && nearlyEquals(serial, parallel, tol)
+			 && nearlyEquals(serial.theLoc, expLoc, tol)
+			  ))
+		{
+			oss << "Failure of weighted chordalMean test\n";
+			oss << "   serial: " << serial << '\n';
+			oss << " parallel: " << parallel << '\n';
+			oss << "   expLoc: " << expLoc << '\n';
+		}
+		if (! ( nearlyEquals(karSerial, karParallel, tol)
+			 && (resMag < 1.e-12)
+			  ))
+		{
+			oss << "Failure of weighted karcherMean test\n";
+			oss << "  karSerial: " << karSerial << '\n';
+			oss << "karParallel: " << karParallel << '\n';
+			oss << "     resMag: " << resMag << '\n';
+		}
+
+		// chordal and Karcher means are close for small spread
+		double const angDif
+			{ magnitude(spinLog(spinMean * reverse(serial.theAtt.spinor()))) };
+		if (! (angDif < 1.e-2))
+		{
+			oss << "Failure of chordal/karcher proximity test\n";
+			oss << "angDif: " << angDif << '\n';
+		}
+
+		// empty (or all zero weight) input has null mean
+		MeanAccumulator const empty;
+		if (isValid(empty.attitude()) || isValid(empty.transform()))
+		{
+			oss << "Failure of empty accumulator null test\n";
+		}
+		if (isValid(karcherMean(xfms.data(), 0u)))
+		{
+			oss << "Failure of empty karcherMean null test\n";
+		}
+	}
+
+}
+
+//! Check behavior of mean attitude functions
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testHalfTurn(oss);
+	testWeighted(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -0,0 +1,278 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra all-pairs functions
+*/
+
+
+#include "pairs.hpp"
+#include "func.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+// internal loop hint must not leak from library headers
+#if defined(Rigibra_LOOP_HINT)
+#	error "Rigibra_LOOP_HINT defined outside of library headers"
+#endif
+
+
+namespace
+{
+	//! Poses with a variety of locations and attitudes
+	std::vector<rigibra::Transform>
+	samplePoses
+		( std::size_t const & numPoses
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		std::vector<Transform> poses;
+		poses.reserve(numPoses);
+		for (std::size_t nn{0u} ; nn < numPoses ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			Location const loc
+				{ 2.*std::sin(.3*dn), .05*dn, std::cos(1.7*dn) };
+			BiVector const angle
+				{ std::sin(.7*dn), .5*std::cos(1.3*dn), std::sin(2.9*dn + .2) };
+			poses.emplace_back(Transform{ loc, Attitude(PhysAngle{ angle }) });
+		}
+		return poses;
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		std::vector<rigibra::Transform> const poses{ samplePoses(37u) };
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		ThreadPool pool(2u);
+		TransformBlock const block(poses);
+		std::size_t const numPoses{ block.size() };
+
+		// relative transform for every pair (e.g. small sets)
+		std::vector<SpinorTransform> xBwAs(numPoses * numPoses);
+		relativeTransforms(pool, block, block, xBwAs.data());
+
+		// distance and angle magnitudes only
+		std::vector<double> dists(numPoses * numPoses);
+		std::vector<double> angles(numPoses * numPoses);
+		relativeMagnitudes(pool, block, block, dists.data(), angles.data());
+
+		// candidate pairs only (full matrix is never stored)
+		double const maxDist{ 1.5 };
+		double const maxAngle{ 1. };
+		std::vector<PosePair> const pairs
+			{ pairsWithin(pool, block, maxDist, maxAngle) };
+
+		// [DoxyExample01]
+
+		double const tol{ 256. * std::numeric_limits<double>::epsilon() };
+		std::size_t errCount{ 0u };
+		std::size_t expNumPairs{ 0u };
+		for (std::size_t nA{0u} ; nA < numPoses ; ++nA)
+		{
+			for (std::size_t nB{0u} ; nB < numPoses ; ++nB)
+			{
+				std::size_t const ndx{ nA * numPoses + nB };
+				// relative pose of B w.r.t. A (ref func.hpp conventions)
+				Transform const expXfm{ poses[nB] * inverse(poses[nA]) };
+				Transform const gotXfm{ xBwAs[ndx].transform() };
+				Vector const pnt{ .3, -1.2, 2. };
+				bool const okXfm
+					{ nearlyEquals(gotXfm(poses[nA](pnt)), poses[nB](pnt), tol)
+					&& nearlyEquals(gotXfm.theLoc, expXfm.theLoc, tol)
+					};
+
+				double const expDist
+					{ magnitude(poses[nB].theLoc - poses[nA].theLoc) };
+				double const expAngle
+					{ 2. * magnitude(expXfm.theAtt.spinAngle().theBiv) };
+				// shortest angle (in case spinAngle exceeds a quarter turn)
+				double const expAngleMin
+					{ std::min(expAngle, turnFull - expAngle) };
+				bool const okMags
+					{  nearlyEquals(dists[ndx], expDist, tol)
+					&& nearlyEquals(angles[ndx], expAngleMin, 1.e-9)
+					};
+
+				if (! (okXfm && okMags))
+				{
+					if (0u == errCount++)
+					{
+						oss << "Failure of all-pairs test\n";
+						oss << "nA,nB: " << nA << ", " << nB << '\n';
+						oss << "expXfm: " << expXfm << '\n';
+						oss << "gotXfm: " << gotXfm << '\n';
+						oss << "exp dist,angle: "
+							<< expDist << ", " << expAngleMin << '\n';
+						oss << "got dist,angle: "
+							<< dists[ndx] << ", " << angles[ndx] << '\n';
+					}
+				}
+
+				if ((nA < nB) && (expDist <= maxDist)
+					&& (expAngleMin <= maxAngle))
+				{
+					++expNumPairs;
+				}
+			}
+		}
+
+		// filtered pairs are consistent with full matrix values
+		if (! (pairs.size() == expNumPairs))
+		{
+			oss << "Failure of pairsWithin size test\n";
+			oss << "exp: " << expNumPairs << '\n';
+			oss << "got: " << pairs.size() << '\n';
+		}
+		if (0u == expNumPairs)
+		{
+			oss << "Failure of test setup: no pairs within thresholds\n";
+		}
+		for (std::size_t nn{0u} ; nn < pairs.size() ; ++nn)
+		{
+			PosePair const & pair = pairs[nn];
+			std::size_t const ndx{ pair.theNdxA * numPoses + pair.theNdxB };
+			bool const okOrder
+				{ (0u == nn)
+				|| (pairs[nn-1u].theNdxA < pair.theNdxA)
+				|| (  (pairs[nn-1u].theNdxA == pair.theNdxA)
+				   && (pairs[nn-1u].theNdxB < pair.theNdxB)
+				   )
+				};
+			if (! ( okOrder
+				 && (pair.theNdxA < pair.theNdxB)
+				 && nearlyEquals(pair.theDistance, dists[ndx], tol)
+				 && nearlyEquals(pair.theAngle, angles[ndx], tol)
+				 && (pair.theDistance <= maxDist)
+				 && (pair.theAngle <= maxAngle)
+				  ))
+			{
+				oss << "Failure of pairsWithin value test\n";
+				oss << "nA,nB: " << pair.theNdxA << ", " << pair.theNdxB << '\n';
+				break;
+			}
+		}
+	}
+
+	//! Check multiple tiles and chunks, null poses
+	void
+	testBlocking
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+
+		// span several tiles and several chunks (with partial remainders)
+		std::size_t const numPoses{ 2u*sPairTileSize + 17u };
+		std::vector<Transform> poses{ samplePoses(numPoses) };
+		poses[5u] = rigibra::null<Transform>();
+		TransformBlock const block(poses);
+
+		ThreadPool pool(3u);
+		double const maxDist{ .5 };
+		double const maxAngle{ 1.5 };
+		std::vector<PosePair> const gotPairs
+			{ pairsWithin(pool, block, maxDist, maxAngle) };
+
+		// brute force (serial) values
+		std::vector<double> dists(numPoses * numPoses);
+		std::vector<double> angles(numPoses * numPoses);
+		ThreadPool serial(1u);
+		relativeMagnitudes(serial, block, block, dists.data(), angles.data());
+		std::size_t expNumPairs{ 0u };
+		bool hitNull{ false };
+		for (std::size_t nA{0u} ; nA < numPoses ; ++nA)
+		{
+			for (std::size_t nB{nA + 1u} ; nB < numPoses ; ++nB)
+			{
+				std::size_t const ndx{ nA * numPoses + nB };
+				if ((dists[ndx] <= maxDist) && (angles[ndx] <= maxAngle))
+				{
+					++expNumPairs;
+				}
+			}
+		}
+		for (PosePair const & pair : gotPairs)
+		{
+			if ((5u == pair.theNdxA) || (5u == pair.theNdxB))
+			{
+				hitNull = true;
+			}
+		}
+
+		if (! (gotPairs.size() == expNumPairs))
+		{
+			oss << "Failure of blocked pairsWithin size test\n";
+			oss << "exp: " << expNumPairs << '\n';
+			oss << "got: " << gotPairs.size() << '\n';
+		}
+		if (hitNull)
+		{
+			oss << "Failure of null pose pair exclusion test\n";
+		}
+	}
+
+}
+
+//! Check behavior of all-pairs relative pose functions
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testBlocking(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -0,0 +1,244 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra parallel operations
+*/
+
+
+#include "parallel.hpp"
+
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testApply
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		constexpr std::size_t numPnts{ 100001u };
+		std::vector<double> xs(numPnts), ys(numPnts), zs(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			xs[nn] = 1.e-3 * dn;
+			ys[nn] = 2. - 1.e-4 * dn;
+			zs[nn] = .5;
+		}
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		Transform const xfm
+			{ Location{ 1., -2., 3. }, Attitude(PhysAngle{ .5*e23 - .3*e12 }) };
+
+		// Transform large SoA arrays with worker threads in a pool
+		ThreadPool pool(4u);
+		std::vector<double> xOut(numPnts), yOut(numPnts), zOut(numPnts);
+		apply
+			( pool, xfm
+			, xs.data(), ys.data(), zs.data(), numPnts
+			, xOut.data(), yOut.data(), zOut.data()
+			);
+
+		// [DoxyExample01]
+
+		// compare with AoS parallel and single point transformation
+		std::vector<Vector> pnts(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			pnts[nn] = Vector{ xs[nn], ys[nn], zs[nn] };
+		}
+		std::vector<Vector> pntsOut(numPnts);
+		apply(pool, xfm, pnts.data(), numPnts, pntsOut.data(), 1000u);
+
+		double const tol{ 256. * std::numeric_limits<double>::epsilon() };
+		std::size_t errCount{ 0u };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			Vector const expPnt{ xfm(pnts[nn]) };
+			Vector const gotSoA{ xOut[nn], yOut[nn], zOut[nn] };
+			Vector const & gotAoS = pntsOut[nn];
+			if ( (! nearlyEquals(gotSoA, expPnt, tol))
+			  || (! nearlyEquals(gotAoS, expPnt, tol))
+			   )
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of parallel apply test\n";
+					oss << "    nn: " << nn << '\n';
+					oss << "   exp: " << expPnt << '\n';
+					oss << "gotSoA: " << gotSoA << '\n';
+					oss << "gotAoS: " << gotAoS << '\n';
+				}
+			}
+		}
+	}
+
+	//! Check parallel prefix composition of transform sequences
+	void
+	testScan
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using rigibra::Transform;
+		using rigibra::Location;
+		using rigibra::Attitude;
+		using rigibra::PhysAngle;
+
+		// relative increments (e.g. from visual odometry)
+		constexpr std::size_t numXfms{ 20001u };
+		std::vector<Transform> incs(numXfms);
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn % 17u) };
+			incs[nn] = Transform
+				{ Location{ .1, .01 * dn, -.02 }
+				, Attitude(PhysAngle{ .01*e12 - .001*dn*e23 + .002*e31 })
+				};
+		}
+
+		// [DoxyExampleScan]
+
+		using namespace rigibra;
+
+		// cumulative poses: poses[nn] = incs[nn] * poses[nn-1]
+		ThreadPool pool(4u);
+		std::vector<Transform> poses(numXfms);
+		inclusiveScan(pool, incs.data(), numXfms, poses.data(), 1000u);
+
+		// end-to-end transform (same as poses.back())
+		Transform const xEnd{ reduce(pool, incs.data(), numXfms, 1000u) };
+
+		// [DoxyExampleScan]
+
+		// serial evaluation with Transform composition
+		std::vector<Transform> expPoses(numXfms);
+		Transform xAccum{ rigibra::identity<Transform>() };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			xAccum = incs[nn] * xAccum;
+			expPoses[nn] = xAccum;
+		}
+		std::vector<Transform> serPoses(numXfms);
+		inclusiveScan(incs.data(), numXfms, serPoses.data());
+
+		double const tol{ 1.e-9 };
+		std::size_t errCount{ 0u };
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			if ( (! nearlyEquals(poses[nn], expPoses[nn], tol))
+			  || (! nearlyEquals(serPoses[nn], expPoses[nn], tol))
+			   )
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of inclusiveScan test\n";
+					oss << "    nn: " << nn << '\n';
+					oss << "   exp: " << expPoses[nn] << '\n';
+					oss << "gotPar: " << poses[nn] << '\n';
+					oss << "gotSer: " << serPoses[nn] << '\n';
+				}
+			}
+		}
+		if (! nearlyEquals(xEnd, expPoses.back(), tol))
+		{
+			oss << "Failure of reduce test\n";
+			oss << "exp: " << expPoses.back() << '\n';
+			oss << "got: " << xEnd << '\n';
+		}
+
+		// SpinorTransform sequence
+		std::vector<SpinorTransform> sIncs(numXfms);
+		for (std::size_t nn{0u} ; nn < numXfms ; ++nn)
+		{
+			sIncs[nn] = SpinorTransform::from(incs[nn]);
+		}
+		std::vector<SpinorTransform> sPoses(numXfms);
+		inclusiveScan(pool, sIncs.data(), numXfms, sPoses.data(), 777u);
+		SpinorTransform const sEnd{ reduce(pool, sIncs.data(), numXfms, 777u) };
+		if ( (! nearlyEquals(sPoses[12345u].transform(), expPoses[12345u], tol))
+		  || (! nearlyEquals(sEnd.transform(), expPoses.back(), tol))
+		   )
+		{
+			oss << "Failure of SpinorTransform scan test\n";
+		}
+
+		// empty sequence reduces to identity
+		Transform const gotEmpty{ reduce(pool, incs.data(), 0u) };
+		if (! nearlyEquals(gotEmpty, rigibra::identity<Transform>()))
+		{
+			oss << "Failure of empty reduce test\n";
+		}
+
+		// null increment propagates to all subsequent poses
+		incs[5000u] = rigibra::null<Transform>();
+		inclusiveScan(pool, incs.data(), numXfms, poses.data(), 1000u);
+		if ( (! isValid(poses[4999u]))
+		  || isValid(poses[5000u])
+		  || isValid(poses.back())
+		   )
+		{
+			oss << "Failure of null propagation scan test\n";
+		}
+	}
+
+}
+
+//! Check behavior of parallel operations
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testApply(oss);
+	testScan(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
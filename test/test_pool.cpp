@@ -0,0 +1,267 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::ThreadPool
+*/
+
+
+#include "pool.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testPool
+		( std::ostream & oss
+		)
+	{
+		// [DoxyExample01]
+
+		// Pool with 4 worker threads (not pinned to cores)
+		rigibra::ThreadPool pool(4u);
+
+		// Process data in chunks of (up to) 100 elements
+		std::vector<std::size_t> values(1234u);
+		pool.parallelFor
+			( values.size()
+			, 100u
+			, [&values] (std::size_t const & beg, std::size_t const & end)
+				{
+					for (std::size_t nn{beg} ; nn < end ; ++nn)
+					{
+						values[nn] = nn;
+					}
+				}
+			);
+
+		// [DoxyExample01]
+
+		std::size_t const gotSum
+			{ std::accumulate(values.cbegin(), values.cend(), std::size_t{0u}) };
+		std::size_t const expSum{ (values.size() * (values.size() - 1u)) / 2u };
+		if (! (gotSum == expSum))
+		{
+			oss << "Failure of parallelFor sum test\n";
+			oss << "exp: " << expSum << '\n';
+			oss << "got: " << gotSum << '\n';
+		}
+
+		if (! (4u == pool.size()))
+		{
+			oss << "Failure of pool size test\n";
+			oss << "got: " << pool.size() << '\n';
+		}
+	}
+
+	//! Check reuse, uneven loads and edge cases
+	void
+	testReuse
+		( std::ostream & oss
+		)
+	{
+		// pinned threads (ignored if not supported)
+		rigibra::ThreadPool pool(3u, true);
+
+		// reuse the same pool for several jobs of varying sizes
+		for (std::size_t numItems : { 0u, 1u, 7u, 1000u, 100003u })
+		{
+			std::vector<std::atomic<std::size_t> > counts(numItems);
+			pool.parallelFor
+				( numItems
+				, 13u
+				, [&counts] (std::size_t const & beg, std::size_t const & end)
+					{
+						for (std::size_t nn{beg} ; nn < end ; ++nn)
+						{
+							// uneven work per chunk to encourage stealing
+							if (0u == (nn % 1024u))
+							{
+								std::vector<double> work(4096u, 1.);
+								counts[nn] += static_cast<std::size_t>
+									(std::accumulate(work.cbegin(), work.cend(), 0.))
+									/ 4096u;
+							}
+							else
+							{
+								counts[nn] += 1u;
+							}
+						}
+					}
+				);
+			std::size_t badCount{ 0u };
+			for (std::atomic<std::size_t> const & count : counts)
+			{
+				if (! (1u == count.load()))
+				{
+					++badCount;
+				}
+			}
+			if (0u < badCount)
+			{
+				oss << "Failure of parallelFor coverage test\n";
+				oss << "numItems: " << numItems << '\n';
+				oss << "badCount: " << badCount << '\n';
+			}
+		}
+
+		// zero chunk size is treated as one
+		std::atomic<std::size_t> numCalls{ 0u };
+		pool.parallelFor
+			( 5u
+			, 0u
+			, [&numCalls] (std::size_t const &, std::size_t const &)
+				{ ++numCalls; }
+			);
+		if (! (5u == numCalls.load()))
+		{
+			oss << "Failure of zero chunkSize test\n";
+			oss << "got: " << numCalls.load() << '\n';
+		}
+
+		// library pool is available
+		if (! (0u < rigibra::defaultPool().size()))
+		{
+			oss << "Failure of defaultPool size test\n";
+		}
+	}
+
+	//! Check exception from a chunk is propagated (and pool is reusable)
+	void
+	testException
+		( std::ostream & oss
+		)
+	{
+		rigibra::ThreadPool pool(3u);
+		std::vector<std::size_t> const badChunks{ 0u, 7u, 63u };
+		for (std::size_t const & badChunk : badChunks)
+		{
+			bool caught{ false };
+			try
+			{
+				pool.parallelFor
+					( 64u * 16u
+					, 16u
+					, [&badChunk] (std::size_t const & beg, std::size_t const &)
+						{
+							if ((badChunk * 16u) == beg)
+							{
+								throw std::runtime_error("bad chunk");
+							}
+						}
+					);
+			}
+			catch (std::runtime_error const & err)
+			{
+				caught = (std::string("bad chunk") == err.what());
+			}
+			if (! caught)
+			{
+				oss << "Failure of parallelFor exception test\n";
+				oss << "badChunk: " << badChunk << '\n';
+				oss << "caught: " << caught << '\n';
+			}
+		}
+
+		// chunks not yet started are skipped after a failure: if every
+		// chunk throws, each thread (workers and caller) runs at most one
+		std::atomic<std::size_t> numStarted{ 0u };
+		bool caughtAll{ false };
+		try
+		{
+			pool.parallelFor
+				( 64u
+				, 1u
+				, [&numStarted] (std::size_t const &, std::size_t const &)
+					{
+						++numStarted;
+						throw std::runtime_error("every chunk");
+					}
+				);
+		}
+		catch (std::runtime_error const &)
+		{
+			caughtAll = true;
+		}
+		std::size_t const maxStarted{ pool.size() + 1u };
+		if (! (caughtAll && (numStarted.load() <= maxStarted)))
+		{
+			oss << "Failure of parallelFor skip after exception test\n";
+			oss << "exp: <= " << maxStarted << '\n';
+			oss << "got: " << numStarted.load() << '\n';
+		}
+
+		// pool remains usable after failure
+		std::atomic<std::size_t> numCalls{ 0u };
+		pool.parallelFor
+			( 100u
+			, 10u
+			, [&numCalls] (std::size_t const &, std::size_t const &)
+				{ ++numCalls; }
+			);
+		if (! (10u == numCalls.load()))
+		{
+			oss << "Failure of parallelFor reuse after exception test\n";
+			oss << "got: " << numCalls.load() << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of ThreadPool
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testPool(oss);
+	testReuse(oss);
+	testException(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
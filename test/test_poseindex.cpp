@@ -0,0 +1,331 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::PoseIndex
+*/
+
+
+#include "poseindex.hpp"
+#include "func.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Poses with a variety of locations and (up to nearly half turn) attitudes
+	std::vector<rigibra::Transform>
+	samplePoses
+		( std::size_t const & numPoses
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		std::vector<Transform> poses;
+		poses.reserve(numPoses);
+		for (std::size_t nn{0u} ; nn < numPoses ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			Location const loc
+				{ 2.*std::sin(.3*dn), .01*dn, std::cos(1.7*dn) };
+			BiVector const angle
+				{ 1.7*std::sin(.7*dn)
+				, 1.1*std::cos(1.3*dn)
+				, 1.9*std::sin(2.9*dn + .2)
+				};
+			poses.emplace_back(Transform{ loc, Attitude(PhysAngle{ angle }) });
+		}
+		return poses;
+	}
+
+	//! Brute force match info (shortest physical angle)
+	rigibra::PoseMatch
+	matchFor
+		( rigibra::Transform const & query
+		, rigibra::Transform const & pose
+		, std::size_t const & id
+		)
+	{
+		using namespace engabra::g3;
+		rigibra::Transform const rel{ pose * rigibra::inverse(query) };
+		double const angle
+			{ 2. * magnitude(rel.theAtt.spinAngle().theBiv) };
+		return rigibra::PoseMatch
+			{ id
+			, magnitude(pose.theLoc - query.theLoc)
+			, std::min(angle, turnFull - angle)
+			};
+	}
+
+	//! Metric squared as documented for PoseIndex::nearest()
+	double
+	metricSq
+		( rigibra::PoseMatch const & match
+		, double const & angleScale
+		)
+	{
+		double const chord{ 2. * std::sin(.25 * match.theAngle) };
+		double const angTerm{ 2. * angleScale * chord };
+		return match.theDistance * match.theDistance + angTerm * angTerm;
+	}
+
+	//! Check index results against linear scan through poses
+	void
+	checkQueries
+		( std::ostream & oss
+		, rigibra::PoseIndex const & index
+		, std::vector<rigibra::Transform> const & poses
+		, double const & angleScale
+		, std::string const & name
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+		double const tol{ 1.e-12 };
+
+		std::vector<Transform> queries
+			{ poses[7u]
+			, Transform{ Location{ .3, 2., -.1 }, identity<Attitude>() }
+			// near half turn (spinor scalar near zero)
+			, Transform{ Location{ 1., 5., .5 }, Attitude(PhysAngle{ 3.1*e12 }) }
+			, Transform{ Location{ -.5, 9., 0. }, Attitude(PhysAngle{ pi*e23 }) }
+			};
+		for (Transform const & query : queries)
+		{
+			std::vector<PoseMatch> expAll;
+			for (std::size_t nn{0u} ; nn < poses.size() ; ++nn)
+			{
+				if (isValid(poses[nn]))
+				{
+					expAll.emplace_back(matchFor(query, poses[nn], nn));
+				}
+			}
+
+			// radius query
+			double const maxDist{ 2. };
+			double const maxAngle{ 1.5 };
+			std::vector<PoseMatch> expWithin;
+			for (PoseMatch const & match : expAll)
+			{
+				if ( (match.theDistance <= maxDist)
+				  && (match.theAngle <= maxAngle)
+				   )
+				{
+					expWithin.emplace_back(match);
+				}
+			}
+			std::vector<PoseMatch> const gotWithin
+				{ index.within(query, maxDist, maxAngle) };
+			bool okWithin{ gotWithin.size() == expWithin.size() };
+			for (std::size_t nn{0u} ; okWithin && (nn < gotWithin.size()) ; ++nn)
+			{
+				okWithin =
+					(  (gotWithin[nn].theId == expWithin[nn].theId)
+					&& nearlyEquals
+						(gotWithin[nn].theDistance, expWithin[nn].theDistance, tol)
+					&& nearlyEquals
+						(gotWithin[nn].theAngle, expWithin[nn].theAngle, 1.e-7)
+					);
+			}
+			if (! okWithin)
+			{
+				oss << "Failure of within() test: " << name << '\n';
+				oss << "query: " << query << '\n';
+				oss << "exp size: " << expWithin.size() << '\n';
+				oss << "got size: " << gotWithin.size() << '\n';
+			}
+
+			// nearest query
+			std::size_t const numNear{ 11u };
+			std::vector<double> expMetrics;
+			for (PoseMatch const & match : expAll)
+			{
+				expMetrics.emplace_back(metricSq(match, angleScale));
+			}
+			std::sort(expMetrics.begin(), expMetrics.end());
+			std::vector<PoseMatch> const gotNear
+				{ index.nearest(query, numNear) };
+			bool okNear{ gotNear.size() == numNear };
+			for (std::size_t nn{0u} ; okNear && (nn < gotNear.size()) ; ++nn)
+			{
+				PoseMatch const expMatch
+					{ matchFor(query, poses[gotNear[nn].theId], 0u) };
+				okNear =
+					(  nearlyEquals
+						(metricSq(gotNear[nn], angleScale), expMetrics[nn], 1.e-9)
+					&& nearlyEquals
+						(gotNear[nn].theDistance, expMatch.theDistance, tol)
+					);
+			}
+			if (! okNear)
+			{
+				oss << "Failure of nearest() test: " << name << '\n';
+				oss << "query: " << query << '\n';
+				oss << "got size: " << gotNear.size() << '\n';
+			}
+		}
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		std::vector<rigibra::Transform> const keyPoses{ samplePoses(500u) };
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// bulk load (tree construction shared by pool threads)
+		ThreadPool pool(2u);
+		double const angleScale{ 2. }; // [length/radian] for nearest()
+		PoseIndex index(pool, keyPoses.data(), keyPoses.size(), angleScale);
+
+		// add more poses as they arrive
+		Transform const newPose
+			{ Location{ .1, .2, .3 }, Attitude(PhysAngle{ .2*e12 }) };
+		std::size_t const newId{ index.insert(newPose) };
+
+		// poses within location distance and rotation angle of query
+		Transform const query
+			{ Location{ .1, .3, .3 }, Attitude(PhysAngle{ .25*e12 }) };
+		std::vector<PoseMatch> const closeBy
+			{ index.within(query, .5, .1) };
+
+		// few poses closest to query (combined location/angle metric)
+		std::vector<PoseMatch> const nearest{ index.nearest(query, 3u) };
+
+		// [DoxyExample01]
+
+		if (! ((keyPoses.size() == newId) && (index.size() == (newId + 1u))))
+		{
+			oss << "Failure of insert id test\n";
+			oss << "newId: " << newId << '\n';
+		}
+		bool const hasNew
+			{ std::any_of
+				( closeBy.cbegin(), closeBy.cend()
+				, [&newId] (PoseMatch const & match)
+					{ return newId == match.theId; }
+				)
+			};
+		if (! hasNew)
+		{
+			oss << "Failure of within() inserted pose test\n";
+		}
+		if (! ((3u == nearest.size()) && (newId == nearest.front().theId)))
+		{
+			oss << "Failure of nearest() inserted pose test\n";
+			oss << "size: " << nearest.size() << '\n';
+		}
+	}
+
+	//! Compare index results with brute force
+	void
+	testBruteForce
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+
+		std::vector<Transform> poses{ samplePoses(3000u) };
+		poses[13u] = null<Transform>();
+
+		// parallel and serial bulk builds
+		double const angleScale{ .75 };
+		ThreadPool pool(3u);
+		PoseIndex const indexPool
+			(pool, poses.data(), poses.size(), angleScale);
+		checkQueries(oss, indexPool, poses, angleScale, "bulk(pool)");
+		ThreadPool serial(0u);
+		PoseIndex const indexSerial
+			(serial, poses.data(), poses.size(), angleScale);
+		checkQueries(oss, indexSerial, poses, angleScale, "bulk(serial)");
+
+		// incremental insertion (including automatic merges into trees)
+		PoseIndex indexInsert(angleScale);
+		for (Transform const & pose : poses)
+		{
+			indexInsert.insert(pose);
+		}
+		checkQueries(oss, indexInsert, poses, angleScale, "insert");
+		indexInsert.rebuild(&pool);
+		checkQueries(oss, indexInsert, poses, angleScale, "rebuild");
+
+		// bulk load then insertion (eventually merges with bulk tree)
+		std::size_t const numBulk{ 1000u };
+		PoseIndex indexMixed(pool, poses.data(), numBulk, angleScale);
+		for (std::size_t nn{numBulk} ; nn < poses.size() ; ++nn)
+		{
+			indexMixed.insert(poses[nn]);
+		}
+		checkQueries(oss, indexMixed, poses, angleScale, "bulk+insert");
+
+		// null queries and empty index
+		PoseIndex const empty;
+		if (! ( empty.within(poses[0], 1., 1.).empty()
+			 && indexPool.within(null<Transform>(), 1., 1.).empty()
+			 && indexPool.nearest(null<Transform>(), 3u).empty()
+			 && empty.nearest(poses[0], 3u).empty()
+			  ))
+		{
+			oss << "Failure of null/empty query test\n";
+		}
+	}
+
+}
+
+//! Check behavior of PoseIndex
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testBruteForce(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
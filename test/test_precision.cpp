@@ -0,0 +1,200 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra reduced precision types
+*/
+
+
+#include "precision.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testPrecision
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		constexpr std::size_t numPnts{ 1001u };
+		std::vector<float> xs(numPnts), ys(numPnts), zs(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			float const fn{ static_cast<float>(nn) };
+			xs[nn] = .1f * fn;
+			ys[nn] = 5.f - .01f * fn;
+			zs[nn] = -2.f;
+		}
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		Transform const xfm
+			{ Location{ 10., -20., 30. }, Attitude(PhysAngle{ .7*e12 - .2*e23 }) };
+
+		// compact (single precision) storage
+		TransformF const xfmF{ TransformF::from(xfm) };
+		Transform const xfmBack{ xfmF.transform() };
+
+		// transform single precision data (SoA layout)
+		std::vector<float> xOut(numPnts), yOut(numPnts), zOut(numPnts);
+		apply
+			( xfmF
+			, xs.data(), ys.data(), zs.data(), numPnts
+			, xOut.data(), yOut.data(), zOut.data()
+			);
+
+		// [DoxyExample01]
+
+		static_assert(24u == sizeof(TransformF), "Unexpected TransformF size");
+
+		double const tolF{ 8. * std::numeric_limits<float>::epsilon() };
+		if (! nearlyEquals(xfmBack, xfm, tolF))
+		{
+			oss << "Failure of float round trip test\n";
+			oss << "exp: " << xfm << '\n';
+			oss << "got: " << xfmBack << '\n';
+		}
+
+		// compare with double precision transformation
+		std::vector<std::array<float, 3u> > pnts(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			pnts[nn] = std::array<float, 3u>{ xs[nn], ys[nn], zs[nn] };
+		}
+		std::vector<std::array<float, 3u> > pntsOut(numPnts);
+		apply(xfm, pnts.data(), numPnts, pntsOut.data());
+
+		std::size_t errCount{ 0u };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			Vector const pnt{ xs[nn], ys[nn], zs[nn] };
+			Vector const exp{ xfm(pnt) };
+			Vector const gotSoA{ xOut[nn], yOut[nn], zOut[nn] };
+			Vector const gotAoS
+				{ pntsOut[nn][0], pntsOut[nn][1], pntsOut[nn][2] };
+			double const tol{ 64. * tolF * (1. + magnitude(exp)) };
+			if ( (! (magnitude(gotSoA - exp) < tol))
+			  || (! (magnitude(gotAoS - exp) < tol))
+			   )
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of float apply test\n";
+					oss << "   exp: " << exp << '\n';
+					oss << "gotSoA: " << gotSoA << '\n';
+					oss << "gotAoS: " << gotAoS << '\n';
+				}
+			}
+		}
+	}
+
+	//! Check conversions between precisions
+	void
+	testConvert
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+
+		Transform const xfm
+			{ Location{ 1.25, -.5, 3. }, Attitude(SpinAngle{ .25*e31 }) };
+		BasicTransform<double> const xfmD{ BasicTransform<double>::from(xfm) };
+		TransformF const xfmF{ precisionCast<float>(xfmD) };
+		BasicTransform<double> const gotD{ precisionCast<double>(xfmF) };
+
+		// values exactly representable in float
+		if (! nearlyEquals(gotD.transform(), xfm))
+		{
+			oss << "Failure of precisionCast test\n";
+			oss << "exp: " << xfm << '\n';
+			oss << "got: " << gotD.transform() << '\n';
+		}
+
+		TransformF const nullF{ TransformF::from(rigibra::null<Transform>()) };
+		if (isValid(nullF) || (! isValid(xfmF)))
+		{
+			oss << "Failure of float isValid test\n";
+		}
+
+		// default construction is null
+		TransformF const defF{};
+		AttitudeF const defAttF{};
+		if (isValid(defF) || defAttF.isValid())
+		{
+			oss << "Failure of default null test\n";
+		}
+
+		// validity in same sense as double precision types
+		double const inf{ std::numeric_limits<double>::infinity() };
+		Transform const infXfm
+			{ Location{ inf, 0., 0. }, Attitude(SpinAngle{ .25*e31 }) };
+		TransformF const infF{ TransformF::from(infXfm) };
+		if (! (isValid(infF) == isValid(infXfm)))
+		{
+			oss << "Failure of float isValid (infinity) test\n";
+			oss << "exp: " << isValid(infXfm) << '\n';
+			oss << "got: " << isValid(infF) << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of reduced precision types
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testPrecision(oss);
+	testConvert(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
@@ -0,0 +1,275 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra robust estimation
+*/
+
+
+#include "ransac.hpp"
+#include "func.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Correspondences for which every n-th one is an inlier
+	struct Samples
+	{
+		std::vector<engabra::g3::Vector> theFroms;
+		std::vector<engabra::g3::Vector> theIntos;
+		std::vector<std::size_t> theInliers;
+	};
+
+	//! Correspondences (with small noise) of which (1/inEvery) are inliers
+	Samples
+	samplesFor
+		( rigibra::Transform const & xfm
+		, std::size_t const & numPairs
+		, std::size_t const & inEvery
+		)
+	{
+		using namespace engabra::g3;
+		Samples samps;
+		for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			Vector const from
+				{ 10.*std::sin(.7*dn)
+				, 8.*std::cos(1.3*dn + .5)
+				, 5.*std::sin(2.9*dn + .2)
+				};
+			Vector into{};
+			if (0u == (nn % inEvery))
+			{
+				Vector const noise
+					{ .002 * std::sin(11.3*dn)
+					, .002 * std::cos(7.1*dn)
+					, .002 * std::sin(5.7*dn + 1.)
+					};
+				into = xfm(from) + noise;
+				samps.theInliers.emplace_back(nn);
+			}
+			else
+			{
+				into = Vector
+					{ 40.*std::sin(3.7*dn + 1.)
+					, 40.*std::cos(5.3*dn)
+					, 40.*std::sin(.9*dn + 2.)
+					};
+			}
+			samps.theFroms.emplace_back(from);
+			samps.theIntos.emplace_back(into);
+		}
+		return samps;
+	}
+
+	//! Examples for documentation
+	void
+	test0
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+		Transform const expXfm
+			{ Location{ 1., -2., 3. }, Attitude(PhysAngle{ .3, -1.2, 2.1 }) };
+		// 80% outliers
+		Samples const samps{ samplesFor(expXfm, 2000u, 5u) };
+		std::vector<Vector> const & froms = samps.theFroms;
+		std::vector<Vector> const & intos = samps.theIntos;
+
+		// [DoxyExample01]
+
+		// froms[nn] and intos[nn] are (putative) matching points
+		ThreadPool pool(2u);
+		RansacOptions options;
+		options.theInlierDistance = .01;
+		RansacResult const result
+			{ ransacTransform
+				(pool, froms.data(), intos.data(), froms.size(), options)
+			};
+		// result.theXfm : best fit to inliers, s.t. intos ~= xfm(froms)
+		// result.theInliers : indices of consistent pairs
+
+		// [DoxyExample01]
+
+		Vector const pnt{ 1.5, -.5, 2. };
+		double const tol{ 1.e-3 };
+		if (! ( nearlyEquals(result.theXfm.theLoc, expXfm.theLoc, tol)
+			 && nearlyEquals(result.theXfm(pnt), expXfm(pnt), tol)
+			  ))
+		{
+			oss << "Failure of ransac transform test\n";
+			oss << "exp: " << expXfm << '\n';
+			oss << "got: " << result.theXfm << '\n';
+		}
+		if (! (result.theInliers == samps.theInliers))
+		{
+			oss << "Failure of ransac inlier test\n";
+			oss << "exp: " << samps.theInliers.size() << '\n';
+			oss << "got: " << result.theInliers.size() << '\n';
+		}
+		// adaptive termination (well before the maximum)
+		if (! ( (0u < result.theNumHypotheses)
+			 && (result.theNumHypotheses < 4000u)
+			  ))
+		{
+			oss << "Failure of adaptive termination test\n";
+			oss << "numHypotheses: " << result.theNumHypotheses << '\n';
+		}
+	}
+
+	//! Check scoring, determinism and degenerate cases
+	void
+	testDetails
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+		Transform const xfm
+			{ Location{ -4., 5., .5 }, Attitude(PhysAngle{ 2.9, .1, -.4 }) };
+		Samples const samps{ samplesFor(xfm, 3000u, 3u) };
+		std::vector<Vector> const & froms = samps.theFroms;
+		std::vector<Vector> const & intos = samps.theIntos;
+		std::size_t const numPairs{ froms.size() };
+		double const maxDist{ .01 };
+
+		// batch scoring consistent with Transform::operator()
+		std::size_t expCount{ 0u };
+		for (std::size_t nn{0u} ; nn < numPairs ; ++nn)
+		{
+			if (magnitude(intos[nn] - xfm(froms[nn])) <= maxDist)
+			{
+				++expCount;
+			}
+		}
+		std::size_t const gotCount
+			{ countInliers
+				(FastTransform(xfm), froms.data(), intos.data(), numPairs, maxDist)
+			};
+		if (! ((expCount == gotCount) && (samps.theInliers.size() == gotCount)))
+		{
+			oss << "Failure of countInliers test\n";
+			oss << "exp: " << expCount << '\n';
+			oss << "got: " << gotCount << '\n';
+		}
+		// early stop: count cannot reach threshold
+		std::size_t const stopCount
+			{ countInliers
+				( FastTransform(xfm), froms.data(), intos.data(), numPairs
+				, maxDist, numPairs
+				)
+			};
+		if (! (stopCount < gotCount))
+		{
+			oss << "Failure of countInliers early stop test\n";
+			oss << "stopCount: " << stopCount << '\n';
+		}
+
+		// same result for any number of threads
+		RansacOptions options;
+		options.theInlierDistance = maxDist;
+		options.theSeed = 12345u;
+		ThreadPool serial(0u);
+		ThreadPool pool(3u);
+		RansacResult const result1
+			{ ransacTransform
+				(serial, froms.data(), intos.data(), numPairs, options)
+			};
+		RansacResult const result3
+			{ ransacTransform
+				(pool, froms.data(), intos.data(), numPairs, options)
+			};
+		Vector const pnt{ 1.5, -.5, 2. };
+		if (! ( (result1.theNumHypotheses == result3.theNumHypotheses)
+			 && (result1.theInliers == result3.theInliers)
+			 && (result1.theInliers == samps.theInliers)
+			 && nearlyEquals(result1.theXfm(pnt), result3.theXfm(pnt))
+			  ))
+		{
+			oss << "Failure of ransac determinism test\n";
+			oss << "result1: " << result1.theXfm
+				<< ' ' << result1.theNumHypotheses << '\n';
+			oss << "result3: " << result3.theXfm
+				<< ' ' << result3.theNumHypotheses << '\n';
+		}
+
+		// selected inliers are those counted by scoring (same test)
+		std::size_t const resultCount
+			{ countInliers
+				( FastTransform(result1.theXfm)
+				, froms.data(), intos.data(), numPairs, maxDist
+				)
+			};
+		if (! (result1.theInliers.size() == resultCount))
+		{
+			oss << "Failure of inlier consistency test\n";
+			oss << "exp: " << resultCount << '\n';
+			oss << "got: " << result1.theInliers.size() << '\n';
+		}
+
+		// too few pairs
+		RansacResult const few
+			{ ransacTransform(pool, froms.data(), intos.data(), 2u, options) };
+		if (! ( (! rigibra::isValid(few.theXfm))
+			 && few.theInliers.empty()
+			  ))
+		{
+			oss << "Failure of too few pairs test\n";
+		}
+	}
+
+}
+
+//! Check behavior of robust estimation functions
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	test0(oss);
+	testDetails(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
@@ -0,0 +1,183 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::simd
+*/
+
+
+#include "simd.hpp"
+
+#include "func.hpp"
+
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testDispatch
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		std::vector<double> xs{ 1., -2., 3., .5, 7. };
+		std::vector<double> ys{ 2., 4., -6., .25, 1. };
+		std::vector<double> zs{ 3., 5., 9., -.75, -1. };
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		Transform const xfm{ Location{ 1., 2., 3. }, Attitude(PhysAngle{ e12 }) };
+
+		// Transform using best kernel available on this CPU
+		std::size_t const numPnts{ xs.size() };
+		std::vector<double> xOut(numPnts), yOut(numPnts), zOut(numPnts);
+		simd::apply
+			( xfm
+			, xs.data(), ys.data(), zs.data(), numPnts
+			, xOut.data(), yOut.data(), zOut.data()
+			);
+
+		// Kernel used
+		std::string const isaName{ simd::nameFor(simd::bestIsa()) };
+
+		// [DoxyExample01]
+
+		double const tol{ 64. * std::numeric_limits<double>::epsilon() };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			Vector const expPnt{ xfm(Vector{ xs[nn], ys[nn], zs[nn] }) };
+			Vector const gotPnt{ xOut[nn], yOut[nn], zOut[nn] };
+			if (! nearlyEquals(gotPnt, expPnt, tol))
+			{
+				oss << "Failure of dispatch apply test\n";
+				oss << "isa: " << isaName << '\n';
+				oss << "exp: " << expPnt << '\n';
+				oss << "got: " << gotPnt << '\n';
+			}
+		}
+	}
+
+	//! Check each kernel supported on this CPU (including tails)
+	void
+	testKernels
+		( std::ostream & oss
+		)
+	{
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		Location const loc{ -3., 7., .5 };
+		PhysAngle const angle{ BiVector{ .3, -.8, 2.1 } };
+		Transform const xfm{ loc, Attitude(angle) };
+
+		// odd size to exercise remainder (tail) handling in all kernels
+		constexpr std::size_t numPnts{ 37u };
+		std::vector<double> xs(numPnts), ys(numPnts), zs(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			xs[nn] = .5 * dn - 3.;
+			ys[nn] = 2. - .25 * dn;
+			zs[nn] = .125 * dn * dn;
+		}
+		std::vector<double> xExp(numPnts), yExp(numPnts), zExp(numPnts);
+		apply
+			( xfm
+			, xs.data(), ys.data(), zs.data(), numPnts
+			, xExp.data(), yExp.data(), zExp.data()
+			);
+
+		using simd::Isa;
+		double const tol{ 256. * std::numeric_limits<double>::epsilon() };
+		for (Isa const & isa : { Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512 })
+		{
+			if (! simd::isSupported(isa))
+			{
+				continue;
+			}
+			std::vector<double> xGot(numPnts), yGot(numPnts), zGot(numPnts);
+			simd::apply
+				( isa, xfm
+				, xs.data(), ys.data(), zs.data(), numPnts
+				, xGot.data(), yGot.data(), zGot.data()
+				);
+			for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+			{
+				Vector const expPnt{ xExp[nn], yExp[nn], zExp[nn] };
+				Vector const gotPnt{ xGot[nn], yGot[nn], zGot[nn] };
+				if (! nearlyEquals(gotPnt, expPnt, tol))
+				{
+					oss << "Failure of kernel test\n";
+					oss << "isa: " << simd::nameFor(isa) << '\n';
+					oss << " nn: " << nn << '\n';
+					oss << "exp: " << expPnt << '\n';
+					oss << "got: " << gotPnt << '\n';
+					break;
+				}
+			}
+		}
+
+		// Scalar kernel must always be available
+		if (! simd::isSupported(Isa::Scalar))
+		{
+			oss << "Failure of Scalar isSupported test\n";
+		}
+	}
+
+}
+
+//! Check behavior of simd kernels
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testDispatch(oss);
+	testKernels(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
@@ -0,0 +1,213 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::spinExp,spinLog
+*/
+
+
+#include "spin.hpp"
+
+#include <Engabra>
+
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testRoundTrip
+		( std::ostream & oss
+		)
+	{
+		// [DoxyExample01]
+
+		using namespace engabra::g3;
+
+		// Spin angle (half of physical angle)
+		BiVector const expSpinBiv{ .25*pi * direction(e12 - 2.*e23) };
+
+		// Unit spinor (same as engabra::g3::exp() for this argument)
+		Spinor const spin{ rigibra::spinExp(expSpinBiv) };
+
+		// Recover the angle (same as bivector part of logG2())
+		BiVector const gotSpinBiv{ rigibra::spinLog(spin) };
+
+		// [DoxyExample01]
+
+		double const tol{ 4. * std::numeric_limits<double>::epsilon() };
+		if (! nearlyEquals(gotSpinBiv, expSpinBiv, tol))
+		{
+			oss << "Failure of round trip test\n";
+			oss << "exp: " << expSpinBiv << '\n';
+			oss << "got: " << gotSpinBiv << '\n';
+		}
+	}
+
+	//! Compare with Engabra general functions across full angle range
+	void
+	testVsEngabra
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		double const eps{ std::numeric_limits<double>::epsilon() };
+		std::vector<double> mags
+			{ 0., 1.e-12, 1.e-8, .5e-4, 1.e-4, 2.e-4, 1.e-3, .1, 1.
+			, turnQtr - 1.e-9, turnQtr, turnQtr + 1.e-9 // phys half turn
+			, 2.5, turnHalf - 1.e-4, turnHalf - 1.e-7 // near phys full turn
+			};
+		std::vector<BiVector> const dirs
+			{ e12, e23, e31, direction(BiVector{ 1., -2., 3. }) };
+
+		std::size_t errCount{ 0u };
+		for (double const & mag : mags)
+		{
+			for (BiVector const & dir : dirs)
+			{
+				BiVector const biv{ mag * dir };
+
+				// exponential
+				Spinor const expSpin{ exp(biv) };
+				Spinor const gotSpin{ rigibra::spinExp(biv) };
+				if (! nearlyEquals(gotSpin, expSpin, 4.*eps))
+				{
+					if (0u == errCount++)
+					{
+						oss << "Failure of spinExp test\n";
+						oss << "mag: " << mag << '\n';
+						oss << "exp: " << expSpin << '\n';
+						oss << "got: " << gotSpin << '\n';
+					}
+				}
+
+				// logarithm (of unit spinor)
+				BiVector const expBiv{ logG2(expSpin).theBiv };
+				BiVector const gotBiv{ rigibra::spinLog(expSpin) };
+				if (! nearlyEquals(gotBiv, expBiv, 8.*eps))
+				{
+					if (0u == errCount++)
+					{
+						oss << "Failure of spinLog test\n";
+						oss << "mag: " << mag << '\n';
+						oss << "exp: " << expBiv << '\n';
+						oss << "got: " << gotBiv << '\n';
+					}
+				}
+
+				// logarithm of non-unit spinor (only direction matters)
+				Spinor const bigSpin{ 3.5 * expSpin };
+				BiVector const gotBigBiv{ rigibra::spinLog(bigSpin) };
+				if (! nearlyEquals(gotBigBiv, expBiv, 8.*eps))
+				{
+					if (0u == errCount++)
+					{
+						oss << "Failure of spinLog non-unit test\n";
+						oss << "mag: " << mag << '\n';
+						oss << "exp: " << expBiv << '\n';
+						oss << "got: " << gotBigBiv << '\n';
+					}
+				}
+			}
+		}
+	}
+
+	//! Check handling of null and degenerate values
+	void
+	testSpecial
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		// null values propagate
+		Spinor const gotNullSpin{ rigibra::spinExp(null<BiVector>()) };
+		BiVector const gotNullBiv{ rigibra::spinLog(null<Spinor>()) };
+		if (isValid(gotNullSpin) || isValid(gotNullBiv))
+		{
+			oss << "Failure of null propagation test\n";
+			oss << "gotNullSpin: " << gotNullSpin << '\n';
+			oss << "gotNullBiv: " << gotNullBiv << '\n';
+		}
+
+		// null scalar with zero bivector is not mistaken for identity
+		Spinor const nullSca{ null<double>(), 0., 0., 0. };
+		BiVector const gotNullSca{ rigibra::spinLog(nullSca) };
+		if (isValid(gotNullSca))
+		{
+			oss << "Failure of null scalar log test\n";
+			oss << "got: " << gotNullSca << '\n';
+		}
+
+		// identity
+		BiVector const gotZero{ rigibra::spinLog(Spinor{ 1., 0., 0., 0. }) };
+		if (! nearlyEquals(gotZero, zero<BiVector>()))
+		{
+			oss << "Failure of identity log test\n";
+			oss << "got: " << gotZero << '\n';
+		}
+
+		// full physical turn: plane undefined (zero returned)
+		BiVector const gotFull{ rigibra::spinLog(Spinor{ -1., 0., 0., 0. }) };
+		if (! nearlyEquals(gotFull, zero<BiVector>()))
+		{
+			oss << "Failure of full turn log test\n";
+			oss << "got: " << gotFull << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of spinExp and spinLog
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testRoundTrip(oss);
+	testVsEngabra(oss);
+	testSpecial(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
@@ -0,0 +1,289 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::transformStream
+*/
+
+
+#include "stream.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+	//! Binary data for points
+	inline
+	std::string
+	pointData
+		( std::vector<engabra::g3::Vector> const & pnts
+		)
+	{
+		return std::string
+			( reinterpret_cast<char const *>(pnts.data())
+			, pnts.size() * sizeof(engabra::g3::Vector)
+			);
+	}
+
+	//! Points from binary data
+	inline
+	std::vector<engabra::g3::Vector>
+	pointsFrom
+		( std::string const & data
+		)
+	{
+		std::vector<engabra::g3::Vector> pnts
+			(data.size() / sizeof(engabra::g3::Vector));
+		std::copy
+			( data.cbegin()
+			, data.cbegin() + pnts.size() * sizeof(engabra::g3::Vector)
+			, reinterpret_cast<char *>(pnts.data())
+			);
+		return pnts;
+	}
+
+	//! Stream buffer that fails after accepting a limited byte count
+	class LimitBuf : public std::streambuf
+	{
+		std::size_t theRemaining;
+
+	public:
+
+		explicit
+		LimitBuf
+			( std::size_t const & maxBytes
+			)
+			: theRemaining{ maxBytes }
+		{ }
+
+	protected:
+
+		int_type
+		overflow
+			( int_type ch
+			) override
+		{
+			if ( (0u == theRemaining)
+			  || traits_type::eq_int_type(ch, traits_type::eof())
+			   )
+			{
+				return traits_type::eof();
+			}
+			--theRemaining;
+			return ch;
+		}
+	};
+
+	//! Examples for documentation
+	void
+	testStream
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		constexpr std::size_t numPnts{ 10007u };
+		std::vector<Vector> pnts(numPnts);
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			pnts[nn] = Vector{ dn, 1. - .5*dn, .25 };
+		}
+		std::istringstream istrm(pointData(pnts));
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		Transform const xfm
+			{ Location{ 1., 2., 3. }, Attitude(PhysAngle{ .5*e12 - .2*e31 }) };
+
+		// transform (large) binary point stream in (small) chunks
+		std::ostringstream ostrm;
+		std::size_t const numDone
+			{ transformStream(istrm, ostrm, xfm, 1000u) };
+
+		// [DoxyExample01]
+
+		std::vector<Vector> const gots{ pointsFrom(ostrm.str()) };
+		if (! ((numPnts == numDone) && (numPnts == gots.size())))
+		{
+			oss << "Failure of stream size test\n";
+			oss << "exp: " << numPnts << '\n';
+			oss << "got: " << numDone << ' ' << gots.size() << '\n';
+			return;
+		}
+		std::size_t errCount{ 0u };
+		for (std::size_t nn{0u} ; nn < numPnts ; ++nn)
+		{
+			Vector const exp{ xfm(pnts[nn]) };
+			if (! nearlyEquals(gots[nn], exp, 1.e-12))
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of stream point test\n";
+					oss << " nn: " << nn << '\n';
+					oss << "exp: " << exp << '\n';
+					oss << "got: " << gots[nn] << '\n';
+				}
+			}
+		}
+	}
+
+	//! Check per-chunk transforms and partial records
+	void
+	testChunkFunc
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+
+		constexpr std::size_t numPnts{ 250u };
+		constexpr std::size_t chunkSize{ 100u };
+		std::vector<Vector> pnts(numPnts, Vector{ 0., 0., 0. });
+		std::string data{ pointData(pnts) };
+		data.append(5u, '\0'); // partial (ignored) record
+		std::istringstream istrm(data);
+
+		// each chunk offset by a location based on chunk and point index
+		std::ostringstream ostrm;
+		std::size_t const numDone
+			{ transformStream
+				( istrm, ostrm
+				, [] (std::size_t const & chunkNdx, std::size_t const & pntNdx)
+					{
+						double const dc{ static_cast<double>(chunkNdx) };
+						double const dp{ static_cast<double>(pntNdx) };
+						return Transform
+							{ Location{ -dc, -dp, 0. }
+							, identity<Attitude>()
+							};
+					}
+				, chunkSize
+				)
+			};
+
+		std::vector<Vector> const gots{ pointsFrom(ostrm.str()) };
+		if (! ((numPnts == numDone) && (numPnts == gots.size())))
+		{
+			oss << "Failure of chunk func size test\n";
+			return;
+		}
+		Vector const exp0{ 0., 0., 0. };
+		Vector const exp1{ 1., 100., 0. };
+		Vector const exp2{ 2., 200., 0. };
+		if ( (! nearlyEquals(gots[99u], exp0))
+		  || (! nearlyEquals(gots[100u], exp1))
+		  || (! nearlyEquals(gots[249u], exp2))
+		   )
+		{
+			oss << "Failure of chunk func test\n";
+			oss << "exp: " << exp0 << ' ' << exp1 << ' ' << exp2 << '\n';
+			oss << "got: " << gots[99u] << ' ' << gots[100u]
+				<< ' ' << gots[249u] << '\n';
+		}
+
+		// empty stream
+		std::istringstream emptyIn;
+		std::ostringstream emptyOut;
+		if ( (0u != transformStream(emptyIn, emptyOut, identity<Transform>()))
+		  || (! emptyOut.str().empty())
+		   )
+		{
+			oss << "Failure of empty stream test\n";
+		}
+	}
+
+	//! Check that points in a failed write are not counted
+	void
+	testWriteFail
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+
+		constexpr std::size_t numPnts{ 500u };
+		constexpr std::size_t chunkSize{ 100u };
+		std::vector<Vector> pnts(numPnts, Vector{ 1., 2., 3. });
+		std::istringstream istrm(pointData(pnts));
+
+		// output fails part way through the third chunk
+		LimitBuf limitBuf((2u*chunkSize + 10u) * sizeof(Vector));
+		std::ostream ostrm(&limitBuf);
+
+		ThreadPool pool(2u);
+		std::size_t const numDone
+			{ transformStream
+				(pool, istrm, ostrm
+				, [] (std::size_t const &, std::size_t const &)
+					{ return identity<Transform>(); }
+				, chunkSize
+				)
+			};
+
+		constexpr std::size_t expDone{ 2u*chunkSize };
+		if (! ((expDone == numDone) && ostrm.fail()))
+		{
+			oss << "Failure of write fail test\n";
+			oss << "exp: " << expDone << '\n';
+			oss << "got: " << numDone << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of streaming transformation
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testStream(oss);
+	testChunkFunc(oss);
+	testWriteFail(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
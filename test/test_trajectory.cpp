@@ -0,0 +1,233 @@
+//
+// MIT License
+//
+// Copyright (c) 2024 Stellacore Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+
+
+/*! \file
+\brief Unit tests (and example) code for rigibra::Trajectory
+*/
+
+
+#include "trajectory.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+namespace
+{
+	//! Examples for documentation
+	void
+	testTrajectory
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+
+		// [DoxyExample01]
+
+		using namespace rigibra;
+
+		// samples (e.g. from navigation system) at various times
+		Trajectory traj;
+		for (std::size_t nn{0u} ; nn < 11u ; ++nn)
+		{
+			double const dn{ static_cast<double>(nn) };
+			double const time{ 100. + 10.*dn };
+			Transform const xfm
+				{ Location{ 5.*dn, 1., -2.*dn }
+				, Attitude(PhysAngle{ .1*dn*e12 })
+				};
+			traj.insert(time, xfm);
+		}
+
+		// interpolated transform at any time within range
+		Transform const xfmAt{ traj.at(125.) };
+
+		// monotone queries (e.g. lidar returns) use a cursor
+		Trajectory::Cursor cursor{};
+		std::vector<Transform> xfms;
+		for (double time{ 100. } ; time < 200. ; time += .25)
+		{
+			xfms.emplace_back(traj.at(time, &cursor));
+		}
+
+		// [DoxyExample01]
+
+		// rotation in fixed plane interpolates linearly in angle
+		Transform const expAt
+			{ Location{ 12.5, 1., -5. }, Attitude(PhysAngle{ .25*e12 }) };
+		if (! nearlyEquals(xfmAt, expAt))
+		{
+			oss << "Failure of interpolated transform test\n";
+			oss << "exp: " << expAt << '\n';
+			oss << "got: " << xfmAt << '\n';
+		}
+
+		// cursor, random access and batch lookups agree
+		std::vector<double> times;
+		for (double time{ 100. } ; time < 200. ; time += .25)
+		{
+			times.emplace_back(time);
+		}
+		std::vector<Transform> const batchXfms{ traj.at(times) };
+		std::size_t errCount{ 0u };
+		for (std::size_t nn{0u} ; nn < times.size() ; ++nn)
+		{
+			// access in reverse order to exercise backward search
+			std::size_t const rn{ times.size() - 1u - nn };
+			Transform const gotRev{ traj.at(times[rn], &cursor) };
+			Transform const gotRan{ traj.at(times[nn]) };
+			if ( (! nearlyEquals(xfms[nn], gotRan))
+			  || (! nearlyEquals(batchXfms[nn], gotRan))
+			  || (! nearlyEquals(xfms[rn], gotRev))
+			   )
+			{
+				if (0u == errCount++)
+				{
+					oss << "Failure of lookup consistency test\n";
+					oss << "  time: " << times[nn] << '\n';
+					oss << "gotRan: " << gotRan << '\n';
+					oss << "gotCur: " << xfms[nn] << '\n';
+					oss << "gotBat: " << batchXfms[nn] << '\n';
+				}
+			}
+		}
+
+		// sample values are reproduced at sample times
+		if (! nearlyEquals(traj.sample(3u), traj.at(traj.time(3u))))
+		{
+			oss << "Failure of exact sample time test\n";
+		}
+
+		// out of range produces null
+		if ( rigibra::isValid(traj.at(99.9))
+		  || rigibra::isValid(traj.at(200.1))
+		  || (! rigibra::isValid(traj.at(200.)))
+		   )
+		{
+			oss << "Failure of out of range test\n";
+		}
+	}
+
+	//! Check interpolation across spinor hemisphere
+	void
+	testShortest
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+
+		// +/-3 radians about e12 are 0.28 radians apart (through pi)
+		Trajectory traj;
+		traj.insert(0., Transform{ zero<Vector>(), Attitude(PhysAngle{ 3.*e12 }) });
+		traj.insert(1., Transform{ zero<Vector>(), Attitude(PhysAngle{-3.*e12 }) });
+
+		// half way is a half turn (pi) about e12
+		Transform const gotMid{ traj.at(.5) };
+		Vector const expVec{ -1., 0., 0. };
+		Vector const gotVec{ gotMid(e1) };
+		if (! nearlyEquals(gotVec, expVec))
+		{
+			oss << "Failure of shortest path test\n";
+			oss << "exp: " << expVec << '\n';
+			oss << "got: " << gotVec << '\n';
+		}
+	}
+
+	//! Check insertion in various orders
+	void
+	testInsert
+		( std::ostream & oss
+		)
+	{
+		using namespace engabra::g3;
+		using namespace rigibra;
+
+		Transform const xfmA{ Location{ 1., 2., 3. }, Attitude(PhysAngle{ .2*e23 }) };
+		Transform const xfmB{ Location{ 2., 2., 3. }, Attitude(PhysAngle{ .4*e23 }) };
+		Transform const xfmC{ Location{ 4., 2., 3. }, Attitude(PhysAngle{ .8*e23 }) };
+
+		Trajectory traj;
+		if (traj.insert(1., rigibra::null<Transform>()) || (! traj.empty()))
+		{
+			oss << "Failure of null insert test\n";
+		}
+
+		// single sample only valid at its time
+		traj.insert(2., xfmB);
+		if ( (! nearlyEquals(traj.at(2.), xfmB))
+		  || rigibra::isValid(traj.at(2.5))
+		   )
+		{
+			oss << "Failure of single sample test\n";
+		}
+
+		// insertion out of time order (and replacement)
+		traj.insert(3., xfmA);
+		traj.insert(1., xfmA);
+		traj.insert(3., xfmC);
+		Transform const expMid
+			{ Location{ 3., 2., 3. }, Attitude(PhysAngle{ .6*e23 }) };
+		if ( (! (3u == traj.size()))
+		  || (! (1. == traj.timeBeg()))
+		  || (! (3. == traj.timeEnd()))
+		  || (! nearlyEquals(traj.at(2.5), expMid))
+		   )
+		{
+			oss << "Failure of insert order test\n";
+			oss << "exp: " << expMid << '\n';
+			oss << "got: " << traj.at(2.5) << '\n';
+		}
+	}
+
+}
+
+//! Check behavior of Trajectory
+int
+main
+	()
+{
+	int status{ 1 };
+	std::stringstream oss;
+
+	testTrajectory(oss);
+	testShortest(oss);
+	testInsert(oss);
+
+	if (oss.str().empty()) // Only pass if no errors were encountered
+	{
+		status = 0;
+	}
+	else
+	{
+		// else report error messages
+		std::cerr << "### FAILURE in test file: " << __FILE__ << std::endl;
+		std::cerr << oss.str();
+	}
+	return status;
+}
+
@@ -34,6 +34,7 @@
 #include <Engabra>
 
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 
@@ -268,6 +269,92 @@ namespace
 		// [DoxyExampleOrderTR]
 	}
 
+	//! Check SpinorAttitude and SpinorTransform consistency with Attitude
+	void
+	testSpinorAtt
+		( std::ostream & oss
+		)
+	{
+		// [DoxyExampleSpinor]
+
+		using namespace rigibra;
+		using namespace engabra::g3;
+
+		// Attitude stores angle, SpinorAttitude stores spinor
+		Attitude const att(PhysAngle{ BiVector{ .4, -1.2, .9 } });
+		SpinorAttitude const spinAtt(att);
+
+		// both represent the same rotation
+		Vector const vecX{ 3., -1., 2. };
+		Vector const expVecY{ att(vecX) };
+		Vector const gotVecY{ spinAtt(vecX) };
+
+		// angle is extracted only on request
+		PhysAngle const gotPhysAngle{ spinAtt.physAngle() };
+
+		// [DoxyExampleSpinor]
+
+		double const tol{ 8. * std::numeric_limits<double>::epsilon() };
+		if (! nearlyEquals(gotVecY, expVecY, tol))
+		{
+			oss << "Failure of SpinorAttitude vector test\n";
+			oss << "exp: " << expVecY << '\n';
+			oss << "got: " << gotVecY << '\n';
+		}
+		if (! nearlyEquals(gotPhysAngle, att.physAngle(), tol))
+		{
+			oss << "Failure of SpinorAttitude physAngle test\n";
+			oss << "exp: " << att.physAngle() << '\n';
+			oss << "got: " << gotPhysAngle << '\n';
+		}
+		if (! nearlyEquals(spinAtt.attitude(), att, tol))
+		{
+			oss << "Failure of SpinorAttitude attitude() test\n";
+			oss << "exp: " << att << '\n';
+			oss << "got: " << spinAtt.attitude() << '\n';
+		}
+
+		// vector transformation is insensitive to spinor magnitude
+		SpinorAttitude const bigAtt(2. * spinAtt.spinor());
+		Vector const gotBigVecY{ bigAtt(vecX) };
+		SpinorAttitude const unitAtt{ bigAtt.normalized() };
+		if ( (! nearlyEquals(gotBigVecY, expVecY, tol))
+		  || (! nearlyEquals(unitAtt, spinAtt, tol))
+		   )
+		{
+			oss << "Failure of SpinorAttitude magnitude test\n";
+			oss << "   expVecY: " << expVecY << '\n';
+			oss << "gotBigVecY: " << gotBigVecY << '\n';
+			oss << "   unitAtt: " << unitAtt << '\n';
+		}
+
+		// null and identity
+		if ( isValid(rigibra::null<SpinorAttitude>())
+		  || isValid(rigibra::null<SpinorTransform>())
+		   )
+		{
+			oss << "Failure of SpinorAttitude/Transform null test\n";
+		}
+		SpinorTransform const ident{ identity<SpinorTransform>() };
+		if (! nearlyEquals(ident(vecX), vecX))
+		{
+			oss << "Failure of SpinorTransform identity test\n";
+			oss << "got: " << ident(vecX) << '\n';
+		}
+
+		// conversion to/from Transform
+		Transform const xfm{ Location{ 1., 2., -3. }, att };
+		SpinorTransform const spinXfm{ SpinorTransform::from(xfm) };
+		if ( (! nearlyEquals(spinXfm(vecX), xfm(vecX), tol))
+		  || (! nearlyEquals(spinXfm.transform(), xfm, tol))
+		   )
+		{
+			oss << "Failure of SpinorTransform conversion test\n";
+			oss << "    xfm: " << xfm << '\n';
+			oss << "spinXfm: " << spinXfm << '\n';
+		}
+	}
+
 }
 
 //! Check behavior of basic types.
@@ -282,6 +369,7 @@ main
 	testAttCtor(oss);
 	testAttMethods(oss);
 	testConvention(oss);
+	testSpinorAtt(oss);
 
 	if (oss.str().empty()) // Only pass if no errors were encountered
 	{